@@ -0,0 +1,453 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#define _POSIX_C_SOURCE 200112
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "ceed-auto.h"
+
+//------------------------------------------------------------------------------
+// Wall Clock Time
+//------------------------------------------------------------------------------
+static double CeedWallTime_Auto(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + 1e-9*ts.tv_nsec;
+}
+
+//------------------------------------------------------------------------------
+// Tuning Key
+//   Operators with the same QFunction, mesh size, and fields share a decision
+//------------------------------------------------------------------------------
+static int CeedOperatorGetTuningKey_Auto(CeedOperator op, char *key) {
+  int ierr;
+  CeedInt nelem, Q, numinputfields, numoutputfields;
+  CeedQFunction qf;
+  CeedOperatorField *opfields[2];
+  CeedQFunctionField *qffields[2];
+  char *source;
+  ierr = CeedOperatorGetNumElements(op, &nelem); CeedChk(ierr);
+  ierr = CeedOperatorGetNumQuadraturePoints(op, &Q); CeedChk(ierr);
+  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
+  ierr = CeedQFunctionGetNumArgs(qf, &numinputfields, &numoutputfields);
+  CeedChk(ierr);
+  ierr = CeedOperatorGetFields(op, &opfields[0], &opfields[1]); CeedChk(ierr);
+  ierr = CeedQFunctionGetFields(qf, &qffields[0], &qffields[1]); CeedChk(ierr);
+  ierr = CeedQFunctionGetSourcePath(qf, &source); CeedChk(ierr);
+
+  size_t len = snprintf(key, CEED_AUTO_MAX_KEY_LEN, "%s nelem=%d Q=%d",
+                        source ? source : "none", nelem, Q);
+  for (CeedInt i=0; i<numinputfields+numoutputfields; i++) {
+    const bool isinput = i < numinputfields;
+    const CeedInt j = isinput ? i : i - numinputfields;
+    CeedOperatorField opfield = opfields[!isinput][j];
+    CeedQFunctionField qffield = qffields[!isinput][j];
+    char *fieldname;
+    CeedInt size, elemsize = 0, ncomp = 0, P = 0, Qb = 0;
+    CeedEvalMode emode;
+    CeedStorageMode storage;
+    CeedElemRestriction r;
+    CeedBasis basis;
+    bool istensor = false;
+    const char *kind = "collocated";
+    ierr = CeedQFunctionFieldGetName(qffield, &fieldname); CeedChk(ierr);
+    ierr = CeedQFunctionFieldGetSize(qffield, &size); CeedChk(ierr);
+    ierr = CeedQFunctionFieldGetEvalMode(qffield, &emode); CeedChk(ierr);
+    ierr = CeedOperatorFieldGetStorage(opfield, &storage); CeedChk(ierr);
+    ierr = CeedOperatorFieldGetElemRestriction(opfield, &r); CeedChk(ierr);
+    if (r != CEED_ELEMRESTRICTION_NONE) {
+      ierr = CeedElemRestrictionGetElementSize(r, &elemsize); CeedChk(ierr);
+    }
+    ierr = CeedOperatorFieldGetBasis(opfield, &basis); CeedChk(ierr);
+    if (basis != CEED_BASIS_COLLOCATED) {
+      ierr = CeedBasisIsTensor(basis, &istensor); CeedChk(ierr);
+      kind = istensor ? "tensor" : "h1";
+      ierr = CeedBasisGetNumComponents(basis, &ncomp); CeedChk(ierr);
+      ierr = CeedBasisGetNumNodes(basis, &P); CeedChk(ierr);
+      ierr = CeedBasisGetNumQuadraturePoints(basis, &Qb); CeedChk(ierr);
+    }
+    len += snprintf(&key[len], len < CEED_AUTO_MAX_KEY_LEN ?
+                    CEED_AUTO_MAX_KEY_LEN - len : 0,
+                    " %s:%s:%s:%d:%d:%s:%d:%d:%d", isinput ? "in" : "out",
+                    fieldname, CeedEvalModes[emode], size, elemsize,
+                    kind, ncomp, P, Qb);
+    if (storage != CEED_STORAGE_FULL)
+      len += snprintf(&key[len], len < CEED_AUTO_MAX_KEY_LEN ?
+                      CEED_AUTO_MAX_KEY_LEN - len : 0, ":%s",
+                      CeedStorageModes[storage]);
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Read Tuning Decision
+//   Lines of the tuning file hold a resource followed by a key; the last line
+//   with a matching key and an available resource wins
+//------------------------------------------------------------------------------
+static int CeedOperatorReadTuning_Auto(Ceed_Auto *data, const char *key,
+                                       CeedInt *candidate) {
+  FILE *file = fopen(data->tuningfile, "r");
+  if (!file) return 0;
+
+  char line[CEED_MAX_RESOURCE_LEN + CEED_AUTO_MAX_KEY_LEN + 2];
+  while (fgets(line, sizeof line, file)) {
+    line[strcspn(line, "\n")] = '\0';
+    char *linekey = strchr(line, ' ');
+    if (!linekey || strcmp(linekey + 1, key)) continue;
+    *linekey = '\0';
+    for (CeedInt i=0; i<data->numcandidates; i++)
+      if (!strcmp(line, data->resources[i]))
+        *candidate = i;
+  }
+  fclose(file);
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Write Tuning Decision
+//------------------------------------------------------------------------------
+static int CeedOperatorWriteTuning_Auto(Ceed ceed, Ceed_Auto *data,
+                                        const char *key, CeedInt candidate) {
+  FILE *file = fopen(data->tuningfile, "a");
+  if (!file)
+    // LCOV_EXCL_START
+    return CeedError(ceed, 1, "Unable to open tuning file: %s",
+                     data->tuningfile);
+  // LCOV_EXCL_STOP
+  fprintf(file, "%s %s\n", data->resources[candidate], key);
+  fclose(file);
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Copy Basis to Candidate Ceed
+//------------------------------------------------------------------------------
+static int CeedBasisCopy_Auto(Ceed ceed, CeedBasis basis, CeedBasis *copy) {
+  int ierr;
+  bool istensor;
+  CeedInt dim, ncomp;
+  const CeedScalar *interp, *grad, *qref, *qweight;
+  ierr = CeedBasisIsTensor(basis, &istensor); CeedChk(ierr);
+  ierr = CeedBasisGetDimension(basis, &dim); CeedChk(ierr);
+  ierr = CeedBasisGetNumComponents(basis, &ncomp); CeedChk(ierr);
+  ierr = CeedBasisGetQRef(basis, &qref); CeedChk(ierr);
+  ierr = CeedBasisGetQWeights(basis, &qweight); CeedChk(ierr);
+  if (istensor) {
+    CeedInt P1d, Q1d;
+    ierr = CeedBasisGetNumNodes1D(basis, &P1d); CeedChk(ierr);
+    ierr = CeedBasisGetNumQuadraturePoints1D(basis, &Q1d); CeedChk(ierr);
+    ierr = CeedBasisGetInterp1D(basis, &interp); CeedChk(ierr);
+    ierr = CeedBasisGetGrad1D(basis, &grad); CeedChk(ierr);
+    ierr = CeedBasisCreateTensorH1(ceed, dim, ncomp, P1d, Q1d, interp, grad,
+                                   qref, qweight, copy); CeedChk(ierr);
+  } else {
+    CeedElemTopology topo;
+    CeedInt P, Q;
+    ierr = CeedBasisGetTopology(basis, &topo); CeedChk(ierr);
+    ierr = CeedBasisGetNumNodes(basis, &P); CeedChk(ierr);
+    ierr = CeedBasisGetNumQuadraturePoints(basis, &Q); CeedChk(ierr);
+    ierr = CeedBasisGetInterp(basis, &interp); CeedChk(ierr);
+    ierr = CeedBasisGetGrad(basis, &grad); CeedChk(ierr);
+    ierr = CeedBasisCreateH1(ceed, topo, ncomp, P, Q, interp, grad, qref,
+                             qweight, copy); CeedChk(ierr);
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Create Operator on Candidate Ceed
+//   Restrictions, vectors, and the QFunction are shared with the original
+//   operator, while bases are copied so that the candidate uses its own tensor
+//   contractions
+//------------------------------------------------------------------------------
+static int CeedOperatorCreateCandidate_Auto(CeedOperator op, Ceed ceed,
+    CeedOperator *candidate) {
+  int ierr;
+  CeedInt numinputfields, numoutputfields, numbases = 0;
+  CeedQFunction qf;
+  CeedOperatorField *opfields[2];
+  CeedQFunctionField *qffields[2];
+  CeedBasis bases[2*CEED_AUTO_MAX_FIELDS], copies[2*CEED_AUTO_MAX_FIELDS];
+  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
+  ierr = CeedQFunctionGetNumArgs(qf, &numinputfields, &numoutputfields);
+  CeedChk(ierr);
+  ierr = CeedOperatorGetFields(op, &opfields[0], &opfields[1]); CeedChk(ierr);
+  ierr = CeedQFunctionGetFields(qf, &qffields[0], &qffields[1]); CeedChk(ierr);
+
+  ierr = CeedOperatorCreate(ceed, qf, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                            candidate); CeedChk(ierr);
+  for (CeedInt i=0; i<numinputfields+numoutputfields; i++) {
+    const bool isinput = i < numinputfields;
+    const CeedInt j = isinput ? i : i - numinputfields;
+    char *fieldname;
+    CeedElemRestriction r;
+    CeedBasis basis;
+    CeedVector vec;
+    CeedStorageMode storage;
+    ierr = CeedQFunctionFieldGetName(qffields[!isinput][j], &fieldname);
+    if (ierr) goto cleanup;
+    ierr = CeedOperatorFieldGetElemRestriction(opfields[!isinput][j], &r);
+    if (ierr) goto cleanup;
+    ierr = CeedOperatorFieldGetBasis(opfields[!isinput][j], &basis);
+    if (ierr) goto cleanup;
+    ierr = CeedOperatorFieldGetVector(opfields[!isinput][j], &vec);
+    if (ierr) goto cleanup;
+    ierr = CeedOperatorFieldGetStorage(opfields[!isinput][j], &storage);
+    if (ierr) goto cleanup;
+
+    // Copy each basis once
+    if (basis != CEED_BASIS_COLLOCATED) {
+      CeedInt b = 0;
+      while (b < numbases && bases[b] != basis) b++;
+      if (b == numbases) {
+        bases[b] = basis;
+        ierr = CeedBasisCopy_Auto(ceed, basis, &copies[b]);
+        if (ierr) goto cleanup;
+        numbases++;
+      }
+      basis = copies[b];
+    }
+    ierr = CeedOperatorSetField(*candidate, fieldname, r, basis, vec);
+    if (ierr) goto cleanup;
+    if (storage != CEED_STORAGE_FULL) {
+      ierr = CeedOperatorSetFieldStorage(*candidate, fieldname, storage);
+      if (ierr) goto cleanup;
+    }
+  }
+
+  // The candidate operator holds references to the copies, and is destroyed
+  //   with them if it could not be set up
+cleanup:
+  for (CeedInt b=0; b<numbases; b++) {
+    int ierrcleanup = CeedBasisDestroy(&copies[b]);
+    if (!ierr) ierr = ierrcleanup;
+  }
+  if (ierr) {
+    CeedOperatorDestroy(candidate);
+  }
+  CeedChk(ierr);
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Time Candidate
+//   The best of several applications after one application for setup
+//------------------------------------------------------------------------------
+static int CeedOperatorTimeCandidate_Auto(CeedOperator candidate,
+    CeedVector in, CeedVector out, double *time) {
+  int ierr;
+  const CeedInt numreps = 3;
+
+  ierr = CeedOperatorApplyAdd(candidate, in, out, CEED_REQUEST_IMMEDIATE);
+  CeedChk(ierr);
+  for (CeedInt rep=0; rep<numreps; rep++) {
+    double start = CeedWallTime_Auto();
+    ierr = CeedOperatorApplyAdd(candidate, in, out, CEED_REQUEST_IMMEDIATE);
+    CeedChk(ierr);
+    double elapsed = CeedWallTime_Auto() - start;
+    if (rep == 0 || elapsed < *time) *time = elapsed;
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Select Candidate
+//   Time all candidates on the operator, unless the tuning file has a decision
+//------------------------------------------------------------------------------
+static int CeedOperatorTune_Auto(CeedOperator op, CeedVector in,
+                                 CeedVector out) {
+  int ierr;
+  Ceed ceed;
+  Ceed_Auto *data;
+  CeedOperator_Auto *impl;
+  char key[CEED_AUTO_MAX_KEY_LEN];
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  ierr = CeedGetData(ceed, &data); CeedChk(ierr);
+  ierr = CeedOperatorGetData(op, &impl); CeedChk(ierr);
+  ierr = CeedOperatorGetTuningKey_Auto(op, key); CeedChk(ierr);
+
+  impl->candidate = -1;
+  if (data->tuningfile) {
+    ierr = CeedOperatorReadTuning_Auto(data, key, &impl->candidate);
+    CeedChk(ierr);
+  }
+  if (impl->candidate >= 0) {
+    ierr = CeedOperatorCreateCandidate_Auto(op,
+                                            data->candidates[impl->candidate],
+                                            &impl->op); CeedChk(ierr);
+    CeedDebug("Auto backend read %s for %s", data->resources[impl->candidate],
+              key);
+    return 0;
+  }
+
+  // Timing applications add into a scratch active output, and passive
+  //   outputs are restored afterwards, including when a candidate fails
+  CeedInt numinputfields, numoutputfields, numsaved = 0;
+  CeedQFunction qf;
+  CeedOperatorField *opoutputfields;
+  CeedVector outvecs[CEED_AUTO_MAX_FIELDS] = {NULL}, scratch = out;
+  CeedScalar *outvalues[CEED_AUTO_MAX_FIELDS] = {NULL};
+  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
+  ierr = CeedQFunctionGetNumArgs(qf, &numinputfields, &numoutputfields);
+  CeedChk(ierr);
+  ierr = CeedOperatorGetFields(op, NULL, &opoutputfields); CeedChk(ierr);
+  for (CeedInt i=0; i<numoutputfields; i++) {
+    CeedInt length;
+    CeedScalar *array;
+    ierr = CeedOperatorFieldGetVector(opoutputfields[i], &outvecs[i]);
+    if (ierr) goto cleanup;
+    if (outvecs[i] == CEED_VECTOR_ACTIVE || outvecs[i] == CEED_VECTOR_NONE) {
+      outvecs[i] = NULL;
+      numsaved = i+1;
+      continue;
+    }
+    ierr = CeedVectorGetLength(outvecs[i], &length);
+    if (ierr) goto cleanup;
+    ierr = CeedMalloc(length, &outvalues[i]);
+    if (ierr) goto cleanup;
+    ierr = CeedVectorGetArray(outvecs[i], CEED_MEM_HOST, &array);
+    if (ierr) goto cleanup;
+    memcpy(outvalues[i], array, length*sizeof(array[0]));
+    ierr = CeedVectorRestoreArray(outvecs[i], &array);
+    if (ierr) goto cleanup;
+    numsaved = i+1;
+  }
+  if (out && out != CEED_VECTOR_NONE) {
+    CeedInt length;
+    ierr = CeedVectorGetLength(out, &length);
+    if (ierr) goto cleanup;
+    ierr = CeedVectorCreate(ceed, length, &scratch);
+    if (ierr) goto cleanup;
+    ierr = CeedVectorSetValue(scratch, 0.0);
+    if (ierr) goto cleanup;
+  }
+
+  double besttime = 0.;
+  for (CeedInt c=0; c<data->numcandidates; c++) {
+    CeedOperator candidate;
+    double time;
+    ierr = CeedOperatorCreateCandidate_Auto(op, data->candidates[c],
+                                            &candidate);
+    if (ierr) goto cleanup;
+    ierr = CeedOperatorTimeCandidate_Auto(candidate, in, scratch, &time);
+    if (ierr) {
+      CeedOperatorDestroy(&candidate);
+      goto cleanup;
+    }
+    CeedDebug("Auto backend timed %s at %e s for %s", data->resources[c],
+              time, key);
+    if (impl->candidate < 0 || time < besttime) {
+      ierr = CeedOperatorDestroy(&impl->op);
+      impl->op = candidate;
+      impl->candidate = c;
+      besttime = time;
+    } else {
+      ierr = CeedOperatorDestroy(&candidate);
+    }
+    if (ierr) goto cleanup;
+  }
+
+  // Free the scratch output and restore the saved passive outputs, keeping
+  //   the first error
+cleanup:
+  if (scratch != out) {
+    int ierrcleanup = CeedVectorDestroy(&scratch);
+    if (!ierr) ierr = ierrcleanup;
+  }
+  for (CeedInt i=0; i<numoutputfields; i++) {
+    CeedInt length;
+    CeedScalar *array;
+    int ierrcleanup = 0;
+    if (i < numsaved && outvecs[i]) {
+      ierrcleanup = CeedVectorGetLength(outvecs[i], &length);
+      if (!ierrcleanup)
+        ierrcleanup = CeedVectorGetArray(outvecs[i], CEED_MEM_HOST, &array);
+      if (!ierrcleanup) {
+        memcpy(array, outvalues[i], length*sizeof(array[0]));
+        ierrcleanup = CeedVectorRestoreArray(outvecs[i], &array);
+      }
+    }
+    int ierrfree = CeedFree(&outvalues[i]);
+    if (!ierrcleanup) ierrcleanup = ierrfree;
+    if (!ierr) ierr = ierrcleanup;
+  }
+  // A failed tuning is retried on the next application
+  if (ierr) {
+    CeedOperatorDestroy(&impl->op);
+    impl->candidate = -1;
+  }
+  CeedChk(ierr);
+
+  if (data->tuningfile) {
+    ierr = CeedOperatorWriteTuning_Auto(ceed, data, key, impl->candidate);
+    CeedChk(ierr);
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Operator Apply
+//------------------------------------------------------------------------------
+static int CeedOperatorApplyAdd_Auto(CeedOperator op, CeedVector invec,
+                                     CeedVector outvec, CeedRequest *request) {
+  int ierr;
+  CeedOperator_Auto *impl;
+  ierr = CeedOperatorGetData(op, &impl); CeedChk(ierr);
+
+  // Select candidate on first application
+  if (!impl->op) {
+    ierr = CeedOperatorTune_Auto(op, invec, outvec); CeedChk(ierr);
+  }
+
+  // Apply selected candidate
+  ierr = CeedOperatorApplyAdd(impl->op, invec, outvec, CEED_REQUEST_IMMEDIATE);
+  CeedChk(ierr);
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Operator Destroy
+//------------------------------------------------------------------------------
+static int CeedOperatorDestroy_Auto(CeedOperator op) {
+  int ierr;
+  CeedOperator_Auto *impl;
+  ierr = CeedOperatorGetData(op, &impl); CeedChk(ierr);
+
+  ierr = CeedOperatorDestroy(&impl->op); CeedChk(ierr);
+  ierr = CeedFree(&impl); CeedChk(ierr);
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Operator Create
+//------------------------------------------------------------------------------
+int CeedOperatorCreate_Auto(CeedOperator op) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  CeedOperator_Auto *impl;
+
+  ierr = CeedCalloc(1, &impl); CeedChk(ierr);
+  ierr = CeedOperatorSetData(op, impl); CeedChk(ierr);
+
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "ApplyAdd",
+                                CeedOperatorApplyAdd_Auto); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "Destroy",
+                                CeedOperatorDestroy_Auto); CeedChk(ierr);
+  return 0;
+}
+//------------------------------------------------------------------------------
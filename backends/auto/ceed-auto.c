@@ -0,0 +1,118 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#include <stdlib.h>
+#include <string.h>
+#include "ceed-auto.h"
+
+// Candidates in order of preference; the first available candidate also
+//   provides all objects other than operators
+static const char *const CeedAutoCandidates[] = {
+  "/cpu/self/xsmm/blocked",
+  "/cpu/self/xsmm/serial",
+  "/cpu/self/avx512/blocked",
+  "/cpu/self/avx512/blocked:blksize=16",
+  "/cpu/self/avx512/serial",
+  "/cpu/self/avx/blocked",
+  "/cpu/self/avx/blocked:blksize=16",
+  "/cpu/self/avx/serial",
+  "/cpu/self/opt/blocked",
+  "/cpu/self/opt/blocked:blksize=16",
+  "/cpu/self/opt/serial",
+};
+
+//------------------------------------------------------------------------------
+// Backend Destroy
+//------------------------------------------------------------------------------
+static int CeedDestroy_Auto(Ceed ceed) {
+  int ierr;
+  Ceed_Auto *data;
+  ierr = CeedGetData(ceed, &data); CeedChk(ierr);
+  for (CeedInt i=0; i<data->numcandidates; i++) {
+    ierr = CeedDestroy(&data->candidates[i]); CeedChk(ierr);
+  }
+  ierr = CeedFree(&data->tuningfile); CeedChk(ierr);
+  ierr = CeedFree(&data); CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Backend Init
+//------------------------------------------------------------------------------
+static int CeedInit_Auto(const char *resource, Ceed ceed) {
+  int ierr;
+  if (strcmp(resource, "/cpu/self/auto"))
+    // LCOV_EXCL_START
+    return CeedError(ceed, 1, "Auto backend cannot use resource: %s",
+                     resource);
+  // LCOV_EXCL_STOP
+
+  // Initialize the available candidates
+  Ceed_Auto *data;
+  ierr = CeedCalloc(1, &data); CeedChk(ierr);
+  const CeedInt numcandidates = sizeof(CeedAutoCandidates) /
+                                sizeof(CeedAutoCandidates[0]);
+  for (CeedInt i=0; i<numcandidates; i++) {
+    char *root;
+    bool isregistered;
+    ierr = CeedGetResourceRoot(ceed, CeedAutoCandidates[i], &root);
+    CeedChk(ierr);
+    ierr = CeedIsRegistered(root, &isregistered);
+    if (ierr) {
+      // LCOV_EXCL_START
+      CeedFree(&root);
+      return ierr;
+      // LCOV_EXCL_STOP
+    }
+    ierr = CeedFree(&root); CeedChk(ierr);
+    if (!isregistered) continue;
+
+    const CeedInt j = data->numcandidates++;
+    data->resources[j] = CeedAutoCandidates[i];
+    ierr = CeedInit(data->resources[j], &data->candidates[j]); CeedChk(ierr);
+  }
+
+  // Optional file of tuning decisions kept across runs
+  const char *tuningfile = getenv("CEED_AUTOTUNE_FILE");
+  if (tuningfile && strcmp(tuningfile, "")) {
+    size_t len = strlen(tuningfile) + 1;
+    ierr = CeedMalloc(len, &data->tuningfile); CeedChk(ierr);
+    memcpy(data->tuningfile, tuningfile, len);
+  }
+  ierr = CeedSetData(ceed, data); CeedChk(ierr);
+
+  // Create CEED of the preferred candidate that implementation will be
+  //   dispatched through unless overridden
+  Ceed ceedref;
+  CeedInit(data->resources[0], &ceedref);
+  ierr = CeedSetDelegate(ceed, ceedref); CeedChk(ierr);
+
+  ierr = CeedSetBackendFunction(ceed, "Ceed", ceed, "Destroy",
+                                CeedDestroy_Auto); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Ceed", ceed, "OperatorCreate",
+                                CeedOperatorCreate_Auto); CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Backend Register
+//------------------------------------------------------------------------------
+CEED_INTERN int CeedRegister_Auto(void) {
+  return CeedRegister("/cpu/self/auto", CeedInit_Auto, 65);
+}
+//------------------------------------------------------------------------------
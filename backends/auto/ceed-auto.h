@@ -0,0 +1,36 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#include <ceed-backend.h>
+#include <string.h>
+
+#define CEED_AUTO_MAX_CANDIDATES 16
+#define CEED_AUTO_MAX_FIELDS 16
+#define CEED_AUTO_MAX_KEY_LEN 1024
+
+typedef struct {
+  CeedInt numcandidates;
+  Ceed candidates[CEED_AUTO_MAX_CANDIDATES]; /// Ceeds timed for each operator
+  const char *resources[CEED_AUTO_MAX_CANDIDATES]; /// Their resources
+  char *tuningfile;      /// File of tuning decisions, from CEED_AUTOTUNE_FILE
+} Ceed_Auto;
+
+typedef struct {
+  CeedOperator op;       /// Operator on the selected candidate Ceed
+  CeedInt candidate;     /// Index of the selected candidate
+} CeedOperator_Auto;
+
+CEED_INTERN int CeedOperatorCreate_Auto(CeedOperator op);
@@ -21,17 +21,25 @@
 //------------------------------------------------------------------------------
 static int CeedInit_Avx(const char *resource, Ceed ceed) {
   int ierr;
-  if (strcmp(resource, "/cpu/self") && strcmp(resource, "/cpu/self/avx")
-      && strcmp(resource, "/cpu/self/avx/blocked"))
+  char *root;
+  ierr = CeedGetResourceRoot(ceed, resource, &root); CeedChk(ierr);
+  if (strcmp(root, "/cpu/self") && strcmp(root, "/cpu/self/avx")
+      && strcmp(root, "/cpu/self/avx/blocked")) {
     // LCOV_EXCL_START
+    ierr = CeedFree(&root); CeedChk(ierr);
     return CeedError(ceed, 1, "AVX backend cannot use resource: %s", resource);
-  // LCOV_EXCL_STOP
-  ierr = CeedSetDeterministic(ceed, true); CeedChk(ierr);
+    // LCOV_EXCL_STOP
+  }
 
   // Create reference CEED that implementation will be dispatched
-  //   through unless overridden
+  //   through unless overridden, with the same query arguments
+  char optresource[CEED_MAX_RESOURCE_LEN];
+  snprintf(optresource, sizeof optresource, "/cpu/self/opt/blocked%s",
+           &resource[strlen(root)]);
+  ierr = CeedFree(&root); CeedChk(ierr);
+  ierr = CeedSetDeterministic(ceed, true); CeedChk(ierr);
   Ceed ceedref;
-  CeedInit("/cpu/self/opt/blocked", &ceedref);
+  CeedInit(optresource, &ceedref);
   ierr = CeedSetDelegate(ceed, ceedref); CeedChk(ierr);
 
   ierr = CeedSetBackendFunction(ceed, "Ceed", ceed, "TensorContractCreate",
@@ -16,11 +16,31 @@
 
 #include "ceed-avx.h"
 
+// Registers of 4 lanes: 256 bit in double and 128 bit in single precision
+#ifdef CEED_SCALAR_FLOAT
+#  define rtype  __m128
+#  define loadu  _mm_loadu_ps
+#  define storeu _mm_storeu_ps
+#  define set    _mm_set_ps
+#  define set1   _mm_set1_ps
 // c += a * b
-#ifdef __FMA__
-#  define fmadd(c,a,b) (c) = _mm256_fmadd_pd((a), (b), (c))
+#  ifdef __FMA__
+#    define fmadd(c,a,b) (c) = _mm_fmadd_ps((a), (b), (c))
+#  else
+#    define fmadd(c,a,b) (c) += _mm_mul_ps((a), (b))
+#  endif
 #else
-#  define fmadd(c,a,b) (c) += _mm256_mul_pd((a), (b))
+#  define rtype  __m256d
+#  define loadu  _mm256_loadu_pd
+#  define storeu _mm256_storeu_pd
+#  define set    _mm256_set_pd
+#  define set1   _mm256_set1_pd
+// c += a * b
+#  ifdef __FMA__
+#    define fmadd(c,a,b) (c) = _mm256_fmadd_pd((a), (b), (c))
+#  else
+#    define fmadd(c,a,b) (c) += _mm256_mul_pd((a), (b))
+#  endif
 #endif
 
 //------------------------------------------------------------------------------
@@ -39,42 +59,42 @@ static inline int CeedTensorContract_Avx_Blocked(CeedTensorContract contract,
     // Blocks of 4 rows
     for (CeedInt j=0; j<(J/JJ)*JJ; j+=JJ) {
       for (CeedInt c=0; c<(C/CC)*CC; c+=CC) {
-        __m256d vv[JJ][CC/4]; // Output tile to be held in registers
+        rtype vv[JJ][CC/4]; // Output tile to be held in registers
         for (CeedInt jj=0; jj<JJ; jj++)
           for (CeedInt cc=0; cc<CC/4; cc++)
-            vv[jj][cc] = _mm256_loadu_pd(&v[(a*J+j+jj)*C+c+cc*4]);
+            vv[jj][cc] = loadu(&v[(a*J+j+jj)*C+c+cc*4]);
 
         for (CeedInt b=0; b<B; b++) {
           for (CeedInt jj=0; jj<JJ; jj++) { // unroll
-            __m256d tqv = _mm256_set1_pd(t[(j+jj)*tstride0 + b*tstride1]);
+            rtype tqv = set1(t[(j+jj)*tstride0 + b*tstride1]);
             for (CeedInt cc=0; cc<CC/4; cc++) // unroll
-              fmadd(vv[jj][cc], tqv, _mm256_loadu_pd(&u[(a*B+b)*C+c+cc*4]));
+              fmadd(vv[jj][cc], tqv, loadu(&u[(a*B+b)*C+c+cc*4]));
           }
         }
         for (CeedInt jj=0; jj<JJ; jj++)
           for (CeedInt cc=0; cc<CC/4; cc++)
-            _mm256_storeu_pd(&v[(a*J+j+jj)*C+c+cc*4], vv[jj][cc]);
+            storeu(&v[(a*J+j+jj)*C+c+cc*4], vv[jj][cc]);
       }
     }
     // Remainder of rows
     CeedInt j=(J/JJ)*JJ;
     if (j < J) {
       for (CeedInt c=0; c<(C/CC)*CC; c+=CC) {
-        __m256d vv[JJ][CC/4]; // Output tile to be held in registers
+        rtype vv[JJ][CC/4]; // Output tile to be held in registers
         for (CeedInt jj=0; jj<J-j; jj++)
           for (CeedInt cc=0; cc<CC/4; cc++)
-            vv[jj][cc] = _mm256_loadu_pd(&v[(a*J+j+jj)*C+c+cc*4]);
+            vv[jj][cc] = loadu(&v[(a*J+j+jj)*C+c+cc*4]);
 
         for (CeedInt b=0; b<B; b++) {
           for (CeedInt jj=0; jj<J-j; jj++) { // doesn't unroll
-            __m256d tqv = _mm256_set1_pd(t[(j+jj)*tstride0 + b*tstride1]);
+            rtype tqv = set1(t[(j+jj)*tstride0 + b*tstride1]);
             for (CeedInt cc=0; cc<CC/4; cc++) // unroll
-              fmadd(vv[jj][cc], tqv, _mm256_loadu_pd(&u[(a*B+b)*C+c+cc*4]));
+              fmadd(vv[jj][cc], tqv, loadu(&u[(a*B+b)*C+c+cc*4]));
           }
         }
         for (CeedInt jj=0; jj<J-j; jj++)
           for (CeedInt cc=0; cc<CC/4; cc++)
-            _mm256_storeu_pd(&v[(a*J+j+jj)*C+c+cc*4], vv[jj][cc]);
+            storeu(&v[(a*J+j+jj)*C+c+cc*4], vv[jj][cc]);
       }
     }
   }
@@ -99,27 +119,27 @@ static inline int CeedTensorContract_Avx_Remainder(CeedTensorContract contract,
     for (CeedInt c = (C/CC)*CC; c<C; c+=4) {
       // Blocks of 4 rows
       for (CeedInt j=0; j<Jbreak; j+=JJ) {
-        __m256d vv[JJ]; // Output tile to be held in registers
+        rtype vv[JJ]; // Output tile to be held in registers
         for (CeedInt jj=0; jj<JJ; jj++)
-          vv[jj] = _mm256_loadu_pd(&v[(a*J+j+jj)*C+c]);
+          vv[jj] = loadu(&v[(a*J+j+jj)*C+c]);
 
         for (CeedInt b=0; b<B; b++) {
-          __m256d tqu;
+          rtype tqu;
           if (C-c == 1)
-            tqu = _mm256_set_pd(0.0, 0.0, 0.0, u[(a*B+b)*C+c+0]);
+            tqu = set(0.0, 0.0, 0.0, u[(a*B+b)*C+c+0]);
           else if (C-c == 2)
-            tqu = _mm256_set_pd(0.0, 0.0, u[(a*B+b)*C+c+1],
-                                u[(a*B+b)*C+c+0]);
+            tqu = set(0.0, 0.0, u[(a*B+b)*C+c+1],
+                      u[(a*B+b)*C+c+0]);
           else if (C-c == 3)
-            tqu = _mm256_set_pd(0.0, u[(a*B+b)*C+c+2], u[(a*B+b)*C+c+1],
-                                u[(a*B+b)*C+c+0]);
+            tqu = set(0.0, u[(a*B+b)*C+c+2], u[(a*B+b)*C+c+1],
+                      u[(a*B+b)*C+c+0]);
           else
-            tqu = _mm256_loadu_pd(&u[(a*B+b)*C+c]);
+            tqu = loadu(&u[(a*B+b)*C+c]);
           for (CeedInt jj=0; jj<JJ; jj++) // unroll
-            fmadd(vv[jj], tqu, _mm256_set1_pd(t[(j+jj)*tstride0 + b*tstride1]));
+            fmadd(vv[jj], tqu, set1(t[(j+jj)*tstride0 + b*tstride1]));
         }
         for (CeedInt jj=0; jj<JJ; jj++)
-          _mm256_storeu_pd(&v[(a*J+j+jj)*C+c], vv[jj]);
+          storeu(&v[(a*J+j+jj)*C+c], vv[jj]);
       }
     }
     // Remainder of rows, all columns
@@ -148,47 +168,47 @@ static inline int CeedTensorContract_Avx_Single(CeedTensorContract contract,
   // Blocks of 4 rows
   for (CeedInt a=0; a<(A/AA)*AA; a+=AA) {
     for (CeedInt j=0; j<(J/JJ)*JJ; j+=JJ) {
-      __m256d vv[AA][JJ/4]; // Output tile to be held in registers
+      rtype vv[AA][JJ/4]; // Output tile to be held in registers
       for (CeedInt aa=0; aa<AA; aa++)
         for (CeedInt jj=0; jj<JJ/4; jj++)
-          vv[aa][jj] = _mm256_loadu_pd(&v[(a+aa)*J+j+jj*4]);
+          vv[aa][jj] = loadu(&v[(a+aa)*J+j+jj*4]);
 
       for (CeedInt b=0; b<B; b++) {
         for (CeedInt jj=0; jj<JJ/4; jj++) { // unroll
-          __m256d tqv = _mm256_set_pd(t[(j+jj*4+3)*tstride0 + b*tstride1],
-                                      t[(j+jj*4+2)*tstride0 + b*tstride1],
-                                      t[(j+jj*4+1)*tstride0 + b*tstride1],
-                                      t[(j+jj*4+0)*tstride0 + b*tstride1]);
+          rtype tqv = set(t[(j+jj*4+3)*tstride0 + b*tstride1],
+                          t[(j+jj*4+2)*tstride0 + b*tstride1],
+                          t[(j+jj*4+1)*tstride0 + b*tstride1],
+                          t[(j+jj*4+0)*tstride0 + b*tstride1]);
           for (CeedInt aa=0; aa<AA; aa++) // unroll
-            fmadd(vv[aa][jj], tqv, _mm256_set1_pd(u[(a+aa)*B+b]));
+            fmadd(vv[aa][jj], tqv, set1(u[(a+aa)*B+b]));
         }
       }
       for (CeedInt aa=0; aa<AA; aa++)
         for (CeedInt jj=0; jj<JJ/4; jj++)
-          _mm256_storeu_pd(&v[(a+aa)*J+j+jj*4], vv[aa][jj]);
+          storeu(&v[(a+aa)*J+j+jj*4], vv[aa][jj]);
     }
   }
   // Remainder of rows
   CeedInt a=(A/AA)*AA;
   for (CeedInt j=0; j<(J/JJ)*JJ; j+=JJ) {
-    __m256d vv[AA][JJ/4]; // Output tile to be held in registers
+    rtype vv[AA][JJ/4]; // Output tile to be held in registers
     for (CeedInt aa=0; aa<A-a; aa++)
       for (CeedInt jj=0; jj<JJ/4; jj++)
-        vv[aa][jj] = _mm256_loadu_pd(&v[(a+aa)*J+j+jj*4]);
+        vv[aa][jj] = loadu(&v[(a+aa)*J+j+jj*4]);
 
     for (CeedInt b=0; b<B; b++) {
       for (CeedInt jj=0; jj<JJ/4; jj++) { // unroll
-        __m256d tqv = _mm256_set_pd(t[(j+jj*4+3)*tstride0 + b*tstride1],
-                                    t[(j+jj*4+2)*tstride0 + b*tstride1],
-                                    t[(j+jj*4+1)*tstride0 + b*tstride1],
-                                    t[(j+jj*4+0)*tstride0 + b*tstride1]);
+        rtype tqv = set(t[(j+jj*4+3)*tstride0 + b*tstride1],
+                        t[(j+jj*4+2)*tstride0 + b*tstride1],
+                        t[(j+jj*4+1)*tstride0 + b*tstride1],
+                        t[(j+jj*4+0)*tstride0 + b*tstride1]);
         for (CeedInt aa=0; aa<A-a; aa++) // unroll
-          fmadd(vv[aa][jj], tqv, _mm256_set1_pd(u[(a+aa)*B+b]));
+          fmadd(vv[aa][jj], tqv, set1(u[(a+aa)*B+b]));
       }
     }
     for (CeedInt aa=0; aa<A-a; aa++)
       for (CeedInt jj=0; jj<JJ/4; jj++)
-        _mm256_storeu_pd(&v[(a+aa)*J+j+jj*4], vv[aa][jj]);
+        storeu(&v[(a+aa)*J+j+jj*4], vv[aa][jj]);
   }
   // Column remainder
   CeedInt Abreak = A%AA ? (A/AA)*AA : (A/AA-1)*AA;
@@ -196,31 +216,31 @@ static inline int CeedTensorContract_Avx_Single(CeedTensorContract contract,
   for (CeedInt j = (J/JJ)*JJ; j<J; j+=4) {
     // Blocks of 4 rows
     for (CeedInt a=0; a<Abreak; a+=AA) {
-      __m256d vv[AA]; // Output tile to be held in registers
+      rtype vv[AA]; // Output tile to be held in registers
       for (CeedInt aa=0; aa<AA; aa++)
-        vv[aa] = _mm256_loadu_pd(&v[(a+aa)*J+j]);
+        vv[aa] = loadu(&v[(a+aa)*J+j]);
 
       for (CeedInt b=0; b<B; b++) {
-        __m256d tqv;
+        rtype tqv;
         if (J-j == 1)
-          tqv = _mm256_set_pd(0.0, 0.0, 0.0, t[(j+0)*tstride0 + b*tstride1]);
+          tqv = set(0.0, 0.0, 0.0, t[(j+0)*tstride0 + b*tstride1]);
         else if (J-j == 2)
-          tqv = _mm256_set_pd(0.0, 0.0, t[(j+1)*tstride0 + b*tstride1],
-                              t[(j+0)*tstride0 + b*tstride1]);
+          tqv = set(0.0, 0.0, t[(j+1)*tstride0 + b*tstride1],
+                    t[(j+0)*tstride0 + b*tstride1]);
         else if (J-3 == j)
-          tqv = _mm256_set_pd(0.0, t[(j+2)*tstride0 + b*tstride1],
-                              t[(j+1)*tstride0 + b*tstride1],
-                              t[(j+0)*tstride0 + b*tstride1]);
+          tqv = set(0.0, t[(j+2)*tstride0 + b*tstride1],
+                    t[(j+1)*tstride0 + b*tstride1],
+                    t[(j+0)*tstride0 + b*tstride1]);
         else
-          tqv = _mm256_set_pd(t[(j+3)*tstride0 + b*tstride1],
-                              t[(j+2)*tstride0 + b*tstride1],
-                              t[(j+1)*tstride0 + b*tstride1],
-                              t[(j+0)*tstride0 + b*tstride1]);
+          tqv = set(t[(j+3)*tstride0 + b*tstride1],
+                    t[(j+2)*tstride0 + b*tstride1],
+                    t[(j+1)*tstride0 + b*tstride1],
+                    t[(j+0)*tstride0 + b*tstride1]);
         for (CeedInt aa=0; aa<AA; aa++) // unroll
-          fmadd(vv[aa], tqv, _mm256_set1_pd(u[(a+aa)*B+b]));
+          fmadd(vv[aa], tqv, set1(u[(a+aa)*B+b]));
       }
       for (CeedInt aa=0; aa<AA; aa++)
-        _mm256_storeu_pd(&v[(a+aa)*J+j], vv[aa]);
+        storeu(&v[(a+aa)*J+j], vv[aa]);
     }
   }
   // Remainder of rows, all columns
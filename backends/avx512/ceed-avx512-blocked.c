@@ -0,0 +1,58 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#include "ceed-avx512.h"
+
+//------------------------------------------------------------------------------
+// Backend Init
+//------------------------------------------------------------------------------
+static int CeedInit_Avx512(const char *resource, Ceed ceed) {
+  int ierr;
+  char *root;
+  ierr = CeedGetResourceRoot(ceed, resource, &root); CeedChk(ierr);
+  if (strcmp(root, "/cpu/self") && strcmp(root, "/cpu/self/avx512")
+      && strcmp(root, "/cpu/self/avx512/blocked")) {
+    // LCOV_EXCL_START
+    ierr = CeedFree(&root); CeedChk(ierr);
+    return CeedError(ceed, 1, "AVX-512 backend cannot use resource: %s",
+                     resource);
+    // LCOV_EXCL_STOP
+  }
+
+  // Create reference CEED that implementation will be dispatched
+  //   through unless overridden, with the same query arguments; its default
+  //   blocks of 8 elements fill one 512 bit register per quadrature point
+  char optresource[CEED_MAX_RESOURCE_LEN];
+  snprintf(optresource, sizeof optresource, "/cpu/self/opt/blocked%s",
+           &resource[strlen(root)]);
+  ierr = CeedFree(&root); CeedChk(ierr);
+  ierr = CeedSetDeterministic(ceed, true); CeedChk(ierr);
+  Ceed ceedref;
+  CeedInit(optresource, &ceedref);
+  ierr = CeedSetDelegate(ceed, ceedref); CeedChk(ierr);
+
+  ierr = CeedSetBackendFunction(ceed, "Ceed", ceed, "TensorContractCreate",
+                                CeedTensorContractCreate_Avx512); CeedChk(ierr);
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Backend Register
+//------------------------------------------------------------------------------
+CEED_INTERN int CeedRegister_Avx512_Blocked(void) {
+  return CeedRegister("/cpu/self/avx512/blocked", CeedInit_Avx512, 28);
+}
+//------------------------------------------------------------------------------
@@ -0,0 +1,293 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#include "ceed-avx512.h"
+
+// Registers of 8 lanes: 512 bit in double and 256 bit in single precision,
+//   with masked loads, stores, and gathers for partial registers
+#ifdef CEED_SCALAR_FLOAT
+#  define rtype             __m256
+#  define loadu             _mm256_loadu_ps
+#  define storeu            _mm256_storeu_ps
+#  define set1              _mm256_set1_ps
+#  define maskz_loadu       _mm256_maskz_loadu_ps
+#  define mask_storeu       _mm256_mask_storeu_ps
+#  define maskz_gather(m,i,p) \
+  _mm256_mmask_i32gather_ps(_mm256_setzero_ps(), (m), (i), (p), sizeof(float))
+// c += a * b
+#  ifdef __FMA__
+#    define fmadd(c,a,b) (c) = _mm256_fmadd_ps((a), (b), (c))
+#  else
+#    define fmadd(c,a,b) (c) += _mm256_mul_ps((a), (b))
+#  endif
+#else
+#  define rtype             __m512d
+#  define loadu             _mm512_loadu_pd
+#  define storeu            _mm512_storeu_pd
+#  define set1              _mm512_set1_pd
+#  define maskz_loadu       _mm512_maskz_loadu_pd
+#  define mask_storeu       _mm512_mask_storeu_pd
+#  define maskz_gather(m,i,p) \
+  _mm512_mask_i32gather_pd(_mm512_setzero_pd(), (m), (i), (p), sizeof(double))
+// c += a * b
+#  define fmadd(c,a,b) (c) = _mm512_fmadd_pd((a), (b), (c))
+#endif
+
+// Mask of the first n < 8 lanes, or all lanes
+#define lanemask(n) ((n) >= 8 ? (__mmask8)0xFF : (__mmask8)((1 << (n)) - 1))
+
+//------------------------------------------------------------------------------
+// Blocked Tensor Contract
+//------------------------------------------------------------------------------
+static inline int CeedTensorContract_Avx512_Blocked(CeedTensorContract contract,
+    CeedInt A, CeedInt B, CeedInt C, CeedInt J, const CeedScalar *restrict t,
+    CeedTransposeMode tmode, const CeedInt Add, const CeedScalar *restrict u,
+    CeedScalar *restrict v, const CeedInt JJ, const CeedInt CC) {
+  CeedInt tstride0 = B, tstride1 = 1;
+  if (tmode == CEED_TRANSPOSE) {
+    tstride0 = 1; tstride1 = J;
+  }
+
+  for (CeedInt a=0; a<A; a++) {
+    // Blocks of JJ rows
+    for (CeedInt j=0; j<(J/JJ)*JJ; j+=JJ) {
+      for (CeedInt c=0; c<(C/CC)*CC; c+=CC) {
+        rtype vv[JJ][CC/8]; // Output tile to be held in registers
+        for (CeedInt jj=0; jj<JJ; jj++)
+          for (CeedInt cc=0; cc<CC/8; cc++)
+            vv[jj][cc] = loadu(&v[(a*J+j+jj)*C+c+cc*8]);
+
+        for (CeedInt b=0; b<B; b++) {
+          for (CeedInt jj=0; jj<JJ; jj++) { // unroll
+            rtype tqv = set1(t[(j+jj)*tstride0 + b*tstride1]);
+            for (CeedInt cc=0; cc<CC/8; cc++) // unroll
+              fmadd(vv[jj][cc], tqv, loadu(&u[(a*B+b)*C+c+cc*8]));
+          }
+        }
+        for (CeedInt jj=0; jj<JJ; jj++)
+          for (CeedInt cc=0; cc<CC/8; cc++)
+            storeu(&v[(a*J+j+jj)*C+c+cc*8], vv[jj][cc]);
+      }
+    }
+    // Remainder of rows
+    CeedInt j=(J/JJ)*JJ;
+    if (j < J) {
+      for (CeedInt c=0; c<(C/CC)*CC; c+=CC) {
+        rtype vv[JJ][CC/8]; // Output tile to be held in registers
+        for (CeedInt jj=0; jj<J-j; jj++)
+          for (CeedInt cc=0; cc<CC/8; cc++)
+            vv[jj][cc] = loadu(&v[(a*J+j+jj)*C+c+cc*8]);
+
+        for (CeedInt b=0; b<B; b++) {
+          for (CeedInt jj=0; jj<J-j; jj++) { // doesn't unroll
+            rtype tqv = set1(t[(j+jj)*tstride0 + b*tstride1]);
+            for (CeedInt cc=0; cc<CC/8; cc++) // unroll
+              fmadd(vv[jj][cc], tqv, loadu(&u[(a*B+b)*C+c+cc*8]));
+          }
+        }
+        for (CeedInt jj=0; jj<J-j; jj++)
+          for (CeedInt cc=0; cc<CC/8; cc++)
+            storeu(&v[(a*J+j+jj)*C+c+cc*8], vv[jj][cc]);
+      }
+    }
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Serial Tensor Contract Remainder
+//------------------------------------------------------------------------------
+static inline int CeedTensorContract_Avx512_Remainder(
+  CeedTensorContract contract, CeedInt A, CeedInt B, CeedInt C, CeedInt J,
+  const CeedScalar *restrict t, CeedTransposeMode tmode, const CeedInt Add,
+  const CeedScalar *restrict u, CeedScalar *restrict v, const CeedInt JJ,
+  const CeedInt CC) {
+  CeedInt tstride0 = B, tstride1 = 1;
+  if (tmode == CEED_TRANSPOSE) {
+    tstride0 = 1; tstride1 = J;
+  }
+
+  for (CeedInt a=0; a<A; a++) {
+    // Columns of 8, the last one masked
+    for (CeedInt c=(C/CC)*CC; c<C; c+=8) {
+      const __mmask8 mask = lanemask(C-c);
+      // Blocks of JJ rows
+      for (CeedInt j=0; j<(J/JJ)*JJ; j+=JJ) {
+        rtype vv[JJ]; // Output tile to be held in registers
+        for (CeedInt jj=0; jj<JJ; jj++)
+          vv[jj] = maskz_loadu(mask, &v[(a*J+j+jj)*C+c]);
+
+        for (CeedInt b=0; b<B; b++) {
+          rtype tqu = maskz_loadu(mask, &u[(a*B+b)*C+c]);
+          for (CeedInt jj=0; jj<JJ; jj++) // unroll
+            fmadd(vv[jj], tqu, set1(t[(j+jj)*tstride0 + b*tstride1]));
+        }
+        for (CeedInt jj=0; jj<JJ; jj++)
+          mask_storeu(&v[(a*J+j+jj)*C+c], mask, vv[jj]);
+      }
+      // Remainder of rows
+      CeedInt j=(J/JJ)*JJ;
+      if (j < J) {
+        rtype vv[JJ]; // Output tile to be held in registers
+        for (CeedInt jj=0; jj<J-j; jj++)
+          vv[jj] = maskz_loadu(mask, &v[(a*J+j+jj)*C+c]);
+
+        for (CeedInt b=0; b<B; b++) {
+          rtype tqu = maskz_loadu(mask, &u[(a*B+b)*C+c]);
+          for (CeedInt jj=0; jj<J-j; jj++) // doesn't unroll
+            fmadd(vv[jj], tqu, set1(t[(j+jj)*tstride0 + b*tstride1]));
+        }
+        for (CeedInt jj=0; jj<J-j; jj++)
+          mask_storeu(&v[(a*J+j+jj)*C+c], mask, vv[jj]);
+      }
+    }
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Serial Tensor Contract C=1
+//------------------------------------------------------------------------------
+static inline int CeedTensorContract_Avx512_Single(CeedTensorContract contract,
+    CeedInt A, CeedInt B, CeedInt C, CeedInt J, const CeedScalar *restrict t,
+    CeedTransposeMode tmode, const CeedInt Add, const CeedScalar *restrict u,
+    CeedScalar *restrict v, const CeedInt AA) {
+  CeedInt tstride0 = B, tstride1 = 1;
+  if (tmode == CEED_TRANSPOSE) {
+    tstride0 = 1; tstride1 = J;
+  }
+  const __m256i tindex = _mm256_set_epi32(7*tstride0, 6*tstride0, 5*tstride0,
+                                          4*tstride0, 3*tstride0, 2*tstride0,
+                                          tstride0, 0);
+
+  // Columns of 8, the last one masked
+  for (CeedInt j=0; j<J; j+=8) {
+    const __mmask8 mask = lanemask(J-j);
+    // Gather the columns of t once for all rows
+    rtype tqv[B];
+    for (CeedInt b=0; b<B; b++)
+      tqv[b] = maskz_gather(mask, tindex, &t[j*tstride0 + b*tstride1]);
+
+    // Blocks of AA rows
+    for (CeedInt a=0; a<(A/AA)*AA; a+=AA) {
+      rtype vv[AA]; // Output tile to be held in registers
+      for (CeedInt aa=0; aa<AA; aa++)
+        vv[aa] = maskz_loadu(mask, &v[(a+aa)*J+j]);
+
+      for (CeedInt b=0; b<B; b++)
+        for (CeedInt aa=0; aa<AA; aa++) // unroll
+          fmadd(vv[aa], tqv[b], set1(u[(a+aa)*B+b]));
+      for (CeedInt aa=0; aa<AA; aa++)
+        mask_storeu(&v[(a+aa)*J+j], mask, vv[aa]);
+    }
+    // Remainder of rows
+    CeedInt a=(A/AA)*AA;
+    if (a < A) {
+      rtype vv[AA]; // Output tile to be held in registers
+      for (CeedInt aa=0; aa<A-a; aa++)
+        vv[aa] = maskz_loadu(mask, &v[(a+aa)*J+j]);
+
+      for (CeedInt b=0; b<B; b++)
+        for (CeedInt aa=0; aa<A-a; aa++) // doesn't unroll
+          fmadd(vv[aa], tqv[b], set1(u[(a+aa)*B+b]));
+      for (CeedInt aa=0; aa<A-a; aa++)
+        mask_storeu(&v[(a+aa)*J+j], mask, vv[aa]);
+    }
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Tensor Contract - Common Sizes
+//------------------------------------------------------------------------------
+static int CeedTensorContract_Avx512_Blocked_4_16(CeedTensorContract contract,
+    CeedInt A, CeedInt B, CeedInt C, CeedInt J, const CeedScalar *restrict t,
+    CeedTransposeMode tmode, const CeedInt Add, const CeedScalar *restrict u,
+    CeedScalar *restrict v) {
+  return CeedTensorContract_Avx512_Blocked(contract, A, B, C, J, t, tmode, Add,
+         u, v, 4, 16);
+}
+static int CeedTensorContract_Avx512_Remainder_8_16(
+  CeedTensorContract contract, CeedInt A, CeedInt B, CeedInt C, CeedInt J,
+  const CeedScalar *restrict t, CeedTransposeMode tmode, const CeedInt Add,
+  const CeedScalar *restrict u, CeedScalar *restrict v) {
+  return CeedTensorContract_Avx512_Remainder(contract, A, B, C, J, t, tmode,
+         Add, u, v, 8, 16);
+}
+static int CeedTensorContract_Avx512_Single_8(CeedTensorContract contract,
+    CeedInt A, CeedInt B, CeedInt C, CeedInt J, const CeedScalar *restrict t,
+    CeedTransposeMode tmode, const CeedInt Add, const CeedScalar *restrict u,
+    CeedScalar *restrict v) {
+  return CeedTensorContract_Avx512_Single(contract, A, B, C, J, t, tmode, Add,
+                                          u, v, 8);
+}
+
+//------------------------------------------------------------------------------
+// Tensor Contract Apply
+//------------------------------------------------------------------------------
+static int CeedTensorContractApply_Avx512(CeedTensorContract contract,
+    CeedInt A, CeedInt B, CeedInt C, CeedInt J, const CeedScalar *restrict t,
+    CeedTransposeMode tmode, const CeedInt Add, const CeedScalar *restrict u,
+    CeedScalar *restrict v) {
+  const CeedInt blksize = 16;
+
+  if (!Add)
+    for (CeedInt q=0; q<A*J*C; q++)
+      v[q] = (CeedScalar) 0.0;
+
+  if (C == 1) {
+    // Serial C=1 Case
+    CeedTensorContract_Avx512_Single_8(contract, A, B, C, J, t, tmode, true, u,
+                                       v);
+  } else {
+    // Blocks of 16 columns
+    if (C >= blksize)
+      CeedTensorContract_Avx512_Blocked_4_16(contract, A, B, C, J, t, tmode,
+                                             true, u, v);
+    // Remainder of columns
+    if (C % blksize)
+      CeedTensorContract_Avx512_Remainder_8_16(contract, A, B, C, J, t, tmode,
+          true, u, v);
+  }
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Tensor Contract Destroy
+//------------------------------------------------------------------------------
+static int CeedTensorContractDestroy_Avx512(CeedTensorContract contract) {
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Tensor Contract Create
+//------------------------------------------------------------------------------
+int CeedTensorContractCreate_Avx512(CeedBasis basis,
+                                    CeedTensorContract contract) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedTensorContractGetCeed(contract, &ceed); CeedChk(ierr);
+
+  ierr = CeedSetBackendFunction(ceed, "TensorContract", contract, "Apply",
+                                CeedTensorContractApply_Avx512); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "TensorContract", contract, "Destroy",
+                                CeedTensorContractDestroy_Avx512);
+  CeedChk(ierr);
+
+  return 0;
+}
+//------------------------------------------------------------------------------
@@ -15,6 +15,7 @@
 // testbed platforms, in support of the nation's exascale computing imperative.
 
 #include "ceed-blocked.h"
+#include "../ref/ceed-ref.h"
 
 //------------------------------------------------------------------------------
 // Setup Input/Output Fields
@@ -159,6 +160,7 @@ static int CeedOperatorSetup_Blocked(CeedOperator op) {
   CeedChk(ierr);
 
   ierr = CeedCalloc(16, &impl->inputstate); CeedChk(ierr);
+  ierr = CeedCalloc(16, &impl->cdata); CeedChk(ierr);
   ierr = CeedCalloc(16, &impl->evecsin); CeedChk(ierr);
   ierr = CeedCalloc(16, &impl->evecsout); CeedChk(ierr);
   ierr = CeedCalloc(16, &impl->qvecsin); CeedChk(ierr);
@@ -180,6 +182,26 @@ static int CeedOperatorSetup_Blocked(CeedOperator op) {
                                          numoutputfields, Q);
   CeedChk(ierr);
 
+  // Compressed storage of passive inputs
+  for (CeedInt i=0; i<numinputfields; i++) {
+    CeedStorageMode storage;
+    ierr = CeedOperatorFieldGetStorage(opinputfields[i], &storage);
+    CeedChk(ierr);
+    if (storage != CEED_STORAGE_FULL) {
+      CeedInt nblks, blksize, size, csize;
+      size_t valsize;
+      ierr = CeedElemRestrictionGetNumBlocks(impl->blkrestr[i], &nblks);
+      CeedChk(ierr);
+      ierr = CeedElemRestrictionGetBlockSize(impl->blkrestr[i], &blksize);
+      CeedChk(ierr);
+      ierr = CeedQFunctionFieldGetSize(qfinputfields[i], &size); CeedChk(ierr);
+      ierr = CeedStorageGetSize_Ref(storage, size, &csize, &valsize);
+      CeedChk(ierr);
+      ierr = CeedMallocArray(nblks*blksize*Q*csize, valsize, &impl->cdata[i]);
+      CeedChk(ierr);
+    }
+  }
+
   // Identity QFunctions
   if (impl->identityqf) {
     CeedEvalMode inmode, outmode;
@@ -213,12 +235,14 @@ static inline int CeedOperatorSetupInputs_Blocked(CeedInt numinputfields,
   CeedInt ierr;
   CeedEvalMode emode;
   CeedVector vec;
+  CeedStorageMode storage;
   uint64_t state;
 
   for (CeedInt i=0; i<numinputfields; i++) {
     // Get input vector
     ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
-    if (vec == CEED_VECTOR_ACTIVE) {
+    const bool isactive = vec == CEED_VECTOR_ACTIVE;
+    if (isactive) {
       if (skipactive)
         continue;
       else
@@ -231,12 +255,44 @@ static inline int CeedOperatorSetupInputs_Blocked(CeedInt numinputfields,
     } else {
       // Restrict
       ierr = CeedVectorGetState(vec, &state); CeedChk(ierr);
+      ierr = CeedOperatorFieldGetStorage(opinputfields[i], &storage);
+      CeedChk(ierr);
       if (state != impl->inputstate[i] || vec == invec) {
+        if (!impl->evecs[i]) {
+          ierr = CeedElemRestrictionCreateVector(impl->blkrestr[i], NULL,
+                                                 &impl->evecs[i]);
+          CeedChk(ierr);
+        }
+        // Active Evec is borrowed from the Ceed workspace pool
+        if (isactive) {
+          ierr = CeedVectorGetWorkArray_Ref(impl->evecs[i]); CeedChk(ierr);
+        }
         ierr = CeedElemRestrictionApply(impl->blkrestr[i], CEED_NOTRANSPOSE,
                                         vec, impl->evecs[i], request);
         CeedChk(ierr);
         impl->inputstate[i] = state;
+        // Compress, keeping only the compressed copy of the Evec
+        if (storage != CEED_STORAGE_FULL) {
+          CeedInt nblks, blksize, Q, size;
+          const CeedScalar *e;
+          ierr = CeedElemRestrictionGetNumBlocks(impl->blkrestr[i], &nblks);
+          CeedChk(ierr);
+          ierr = CeedElemRestrictionGetBlockSize(impl->blkrestr[i], &blksize);
+          CeedChk(ierr);
+          ierr = CeedElemRestrictionGetElementSize(impl->blkrestr[i], &Q);
+          CeedChk(ierr);
+          ierr = CeedQFunctionFieldGetSize(qfinputfields[i], &size);
+          CeedChk(ierr);
+          ierr = CeedVectorGetArrayRead(impl->evecs[i], CEED_MEM_HOST, &e);
+          CeedChk(ierr);
+          ierr = CeedStorageCompress_Ref(storage, size, Q*blksize, nblks, e,
+                                         impl->cdata[i]); CeedChk(ierr);
+          ierr = CeedVectorRestoreArrayRead(impl->evecs[i], &e); CeedChk(ierr);
+          ierr = CeedVectorDestroy(&impl->evecs[i]); CeedChk(ierr);
+        }
       }
+      if (storage != CEED_STORAGE_FULL)
+        continue;
       // Get evec
       ierr = CeedVectorGetArrayRead(impl->evecs[i], CEED_MEM_HOST,
                                     (const CeedScalar **) &impl->edata[i]);
@@ -279,9 +335,22 @@ static inline int CeedOperatorInputBasis_Blocked(CeedInt e, CeedInt Q,
     // Basis action
     switch(emode) {
     case CEED_EVAL_NONE:
-      ierr = CeedVectorSetArray(impl->qvecsin[i], CEED_MEM_HOST,
-                                CEED_USE_POINTER,
-                                &impl->edata[i][e*Q*size]); CeedChk(ierr);
+      if (impl->cdata[i]) {
+        // Expand compressed storage
+        CeedStorageMode storage;
+        CeedScalar *q;
+        ierr = CeedOperatorFieldGetStorage(opinputfields[i], &storage);
+        CeedChk(ierr);
+        ierr = CeedVectorGetArray(impl->qvecsin[i], CEED_MEM_HOST, &q);
+        CeedChk(ierr);
+        ierr = CeedStorageExpand_Ref(storage, size, Q*blksize, e/blksize,
+                                     impl->cdata[i], q); CeedChk(ierr);
+        ierr = CeedVectorRestoreArray(impl->qvecsin[i], &q); CeedChk(ierr);
+      } else {
+        ierr = CeedVectorSetArray(impl->qvecsin[i], CEED_MEM_HOST,
+                                  CEED_USE_POINTER,
+                                  &impl->edata[i][e*Q*size]); CeedChk(ierr);
+      }
       break;
     case CEED_EVAL_INTERP:
       ierr = CeedOperatorFieldGetBasis(opinputfields[i], &basis); CeedChk(ierr);
@@ -400,19 +469,21 @@ static inline int CeedOperatorRestoreInputs_Blocked(CeedInt numinputfields,
 
   for (CeedInt i=0; i<numinputfields; i++) {
     // Skip active inputs
-    if (skipactive) {
-      CeedVector vec;
-      ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
-      if (vec == CEED_VECTOR_ACTIVE)
-        continue;
-    }
+    CeedVector vec;
+    ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
+    if (skipactive && vec == CEED_VECTOR_ACTIVE)
+      continue;
     ierr = CeedQFunctionFieldGetEvalMode(qfinputfields[i], &emode);
     CeedChk(ierr);
-    if (emode == CEED_EVAL_WEIGHT) { // Skip
+    if (emode == CEED_EVAL_WEIGHT || impl->cdata[i]) { // Skip
     } else {
       ierr = CeedVectorRestoreArrayRead(impl->evecs[i],
                                         (const CeedScalar **) &impl->edata[i]);
       CeedChk(ierr);
+      // Return active Evec to the Ceed workspace pool
+      if (vec == CEED_VECTOR_ACTIVE) {
+        ierr = CeedVectorRestoreWorkArray_Ref(impl->evecs[i]); CeedChk(ierr);
+      }
     }
   }
   return 0;
@@ -449,17 +520,23 @@ static int CeedOperatorApplyAdd_Blocked(CeedOperator op, CeedVector invec,
   ierr = CeedOperatorSetup_Blocked(op); CeedChk(ierr);
 
   // Input Evecs and Restriction
+  ierr = CeedOperatorPhaseBegin(op, CEED_PHASE_RESTRICTION); CeedChk(ierr);
   ierr = CeedOperatorSetupInputs_Blocked(numinputfields, qfinputfields,
                                          opinputfields, invec, false, impl,
                                          request); CeedChk(ierr);
+  ierr = CeedOperatorPhaseEnd(op, CEED_PHASE_RESTRICTION); CeedChk(ierr);
 
-  // Output Evecs
+  // Output Evecs, borrowed from the Ceed workspace pool
   for (CeedInt i=0; i<numoutputfields; i++) {
+    ierr = CeedVectorGetWorkArray_Ref(impl->evecs[i+impl->numein]);
+    CeedChk(ierr);
     ierr = CeedVectorGetArray(impl->evecs[i+impl->numein], CEED_MEM_HOST,
                               &impl->edata[i + numinputfields]); CeedChk(ierr);
   }
 
-  // Loop through elements
+  // Loop through elements, timing phases only when profiling
+  bool profile;
+  ierr = CeedOperatorIsProfiling(op, &profile); CeedChk(ierr);
   for (CeedInt e=0; e<nblks*blksize; e+=blksize) {
     // Output pointers
     for (CeedInt i=0; i<numoutputfields; i++) {
@@ -476,24 +553,43 @@ static int CeedOperatorApplyAdd_Blocked(CeedOperator op, CeedVector invec,
     }
 
     // Input basis apply
+    if (profile) {
+      ierr = CeedOperatorPhaseBegin(op, CEED_PHASE_BASIS); CeedChk(ierr);
+    }
     ierr = CeedOperatorInputBasis_Blocked(e, Q, qfinputfields, opinputfields,
                                           numinputfields, blksize, false, impl);
     CeedChk(ierr);
+    if (profile) {
+      ierr = CeedOperatorPhaseEnd(op, CEED_PHASE_BASIS); CeedChk(ierr);
+    }
 
     // Q function
     if (!impl->identityqf) {
+      if (profile) {
+        ierr = CeedOperatorPhaseBegin(op, CEED_PHASE_QFUNCTION); CeedChk(ierr);
+      }
       ierr = CeedQFunctionApply(qf, Q*blksize, impl->qvecsin, impl->qvecsout);
       CeedChk(ierr);
+      if (profile) {
+        ierr = CeedOperatorPhaseEnd(op, CEED_PHASE_QFUNCTION); CeedChk(ierr);
+      }
     }
 
     // Output basis apply
+    if (profile) {
+      ierr = CeedOperatorPhaseBegin(op, CEED_PHASE_BASIS); CeedChk(ierr);
+    }
     ierr = CeedOperatorOutputBasis_Blocked(e, Q, qfoutputfields, opoutputfields,
                                            blksize, numinputfields,
                                            numoutputfields, op, impl);
     CeedChk(ierr);
+    if (profile) {
+      ierr = CeedOperatorPhaseEnd(op, CEED_PHASE_BASIS); CeedChk(ierr);
+    }
   }
 
   // Output restriction
+  ierr = CeedOperatorPhaseBegin(op, CEED_PHASE_RESTRICTION); CeedChk(ierr);
   for (CeedInt i=0; i<numoutputfields; i++) {
     // Restore evec
     ierr = CeedVectorRestoreArray(impl->evecs[i+impl->numein],
@@ -507,8 +603,10 @@ static int CeedOperatorApplyAdd_Blocked(CeedOperator op, CeedVector invec,
     ierr = CeedElemRestrictionApply(impl->blkrestr[i+impl->numein],
                                     CEED_TRANSPOSE, impl->evecs[i+impl->numein],
                                     vec, request); CeedChk(ierr);
-
+    ierr = CeedVectorRestoreWorkArray_Ref(impl->evecs[i+impl->numein]);
+    CeedChk(ierr);
   }
+  ierr = CeedOperatorPhaseEnd(op, CEED_PHASE_RESTRICTION); CeedChk(ierr);
 
   // Restore input arrays
   ierr = CeedOperatorRestoreInputs_Blocked(numinputfields, qfinputfields,
@@ -518,10 +616,12 @@ static int CeedOperatorApplyAdd_Blocked(CeedOperator op, CeedVector invec,
 }
 
 //------------------------------------------------------------------------------
-// Assemble Linear QFunction
+// Assemble QFunction in blocked layout
+//   The assembled values are stored in the E-vector layout of a blocked
+//   strided restriction with numactivein*numactiveout components
 //------------------------------------------------------------------------------
-static int CeedOperatorLinearAssembleQFunction_Blocked(CeedOperator op,
-    CeedVector *assembled, CeedElemRestriction *rstr, CeedRequest *request) {
+static int CeedOperatorAssembleQFunctionBlocked_Blocked(CeedOperator op,
+    CeedVector *lvec, CeedInt *numactive, CeedRequest *request) {
   int ierr;
   CeedOperator_Blocked *impl;
   ierr = CeedOperatorGetData(op, &impl); CeedChk(ierr);
@@ -540,7 +640,7 @@ static int CeedOperatorLinearAssembleQFunction_Blocked(CeedOperator op,
   CeedQFunctionField *qfinputfields, *qfoutputfields;
   ierr = CeedQFunctionGetFields(qf, &qfinputfields, &qfoutputfields);
   CeedChk(ierr);
-  CeedVector vec, lvec;
+  CeedVector vec;
   CeedInt numactivein = 0, numactiveout = 0;
   CeedVector *activein = NULL;
   CeedScalar *a, *tmp;
@@ -604,18 +704,9 @@ static int CeedOperatorLinearAssembleQFunction_Blocked(CeedOperator op,
 
   // Setup lvec
   ierr = CeedVectorCreate(ceed, nblks*blksize*Q*numactivein*numactiveout,
-                          &lvec); CeedChk(ierr);
-  ierr = CeedVectorGetArray(lvec, CEED_MEM_HOST, &a); CeedChk(ierr);
-
-  // Create output restriction
-  CeedInt strides[3] = {1, Q, numactivein *numactiveout*Q};
-  ierr = CeedElemRestrictionCreateStrided(ceed, numelements, Q,
-                                          numactivein*numactiveout,
-                                          numactivein*numactiveout*numelements*Q,
-                                          strides, rstr); CeedChk(ierr);
-  // Create assembled vector
-  ierr = CeedVectorCreate(ceed, numelements*Q*numactivein*numactiveout,
-                          assembled); CeedChk(ierr);
+                          lvec); CeedChk(ierr);
+  ierr = CeedVectorGetArray(*lvec, CEED_MEM_HOST, &a); CeedChk(ierr);
+  *numactive = numactivein*numactiveout;
 
   // Loop through elements
   for (CeedInt e=0; e<nblks*blksize; e+=blksize) {
@@ -668,27 +759,103 @@ static int CeedOperatorLinearAssembleQFunction_Blocked(CeedOperator op,
   ierr = CeedOperatorRestoreInputs_Blocked(numinputfields, qfinputfields,
          opinputfields, true, impl); CeedChk(ierr);
 
+  ierr = CeedVectorRestoreArray(*lvec, &a); CeedChk(ierr);
+
+  // Cleanup
+  for (CeedInt i=0; i<numactivein; i++) {
+    ierr = CeedVectorDestroy(&activein[i]); CeedChk(ierr);
+  }
+  ierr = CeedFree(&activein); CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Assemble Linear QFunction
+//------------------------------------------------------------------------------
+static int CeedOperatorLinearAssembleQFunction_Blocked(CeedOperator op,
+    CeedVector *assembled, CeedElemRestriction *rstr, CeedRequest *request) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  const CeedInt blksize = 8;
+  CeedInt Q, numelements, numactive;
+  ierr = CeedOperatorGetNumElements(op, &numelements); CeedChk(ierr);
+  ierr = CeedOperatorGetNumQuadraturePoints(op, &Q); CeedChk(ierr);
+
+  // Assemble QFunction
+  CeedVector lvec;
+  ierr = CeedOperatorAssembleQFunctionBlocked_Blocked(op, &lvec, &numactive,
+         request); CeedChk(ierr);
+
+  // Create output restriction
+  CeedInt strides[3] = {1, Q, numactive*Q};
+  ierr = CeedElemRestrictionCreateStrided(ceed, numelements, Q, numactive,
+                                          numactive*numelements*Q, strides,
+                                          rstr); CeedChk(ierr);
+  // Create assembled vector
+  ierr = CeedVectorCreate(ceed, numelements*Q*numactive, assembled);
+  CeedChk(ierr);
+
   // Output blocked restriction
-  ierr = CeedVectorRestoreArray(lvec, &a); CeedChk(ierr);
   ierr = CeedVectorSetValue(*assembled, 0.0); CeedChk(ierr);
   CeedElemRestriction blkrstr;
   ierr = CeedElemRestrictionCreateBlockedStrided(ceed, numelements, Q, blksize,
-         numactivein*numactiveout, numactivein*numactiveout*numelements*Q,
-         strides, &blkrstr); CeedChk(ierr);
+         numactive, numactive*numelements*Q, strides, &blkrstr); CeedChk(ierr);
   ierr = CeedElemRestrictionApply(blkrstr, CEED_TRANSPOSE, lvec, *assembled,
                                   request); CeedChk(ierr);
 
   // Cleanup
-  for (CeedInt i=0; i<numactivein; i++) {
-    ierr = CeedVectorDestroy(&activein[i]); CeedChk(ierr);
-  }
-  ierr = CeedFree(&activein); CeedChk(ierr);
   ierr = CeedVectorDestroy(&lvec); CeedChk(ierr);
   ierr = CeedElemRestrictionDestroy(&blkrstr); CeedChk(ierr);
 
   return 0;
 }
 
+//------------------------------------------------------------------------------
+// Assemble diagonal common code
+//   The diagonal is accumulated per element block directly from the blocked
+//   assembled QFunction
+//------------------------------------------------------------------------------
+static int CeedOperatorAssembleAddDiagonalCore_Blocked(CeedOperator op,
+    CeedVector assembled, CeedRequest *request, const bool pointBlock) {
+  int ierr;
+  const CeedInt blksize = 8;
+  CeedInt numactive;
+
+  // Assemble QFunction
+  CeedVector lvec;
+  ierr = CeedOperatorAssembleQFunctionBlocked_Blocked(op, &lvec, &numactive,
+         request); CeedChk(ierr);
+
+  // Assemble diagonal
+  ierr = CeedOperatorAssembleAddDiagonalBlocked_Ref(op, lvec, blksize,
+         assembled, request, pointBlock); CeedChk(ierr);
+
+  // Cleanup
+  ierr = CeedVectorDestroy(&lvec); CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Assemble Linear Diagonal
+//------------------------------------------------------------------------------
+static int CeedOperatorLinearAssembleAddDiagonal_Blocked(CeedOperator op,
+    CeedVector assembled, CeedRequest *request) {
+  return CeedOperatorAssembleAddDiagonalCore_Blocked(op, assembled, request,
+         false);
+}
+
+//------------------------------------------------------------------------------
+// Assemble Linear Point Block Diagonal
+//------------------------------------------------------------------------------
+static int CeedOperatorLinearAssembleAddPointBlockDiagonal_Blocked(
+  CeedOperator op, CeedVector assembled, CeedRequest *request) {
+  return CeedOperatorAssembleAddDiagonalCore_Blocked(op, assembled, request,
+         true);
+}
+
 //------------------------------------------------------------------------------
 // Operator Destroy
 //------------------------------------------------------------------------------
@@ -709,7 +876,9 @@ static int CeedOperatorDestroy_Blocked(CeedOperator op) {
   for (CeedInt i=0; i<impl->numein; i++) {
     ierr = CeedVectorDestroy(&impl->evecsin[i]); CeedChk(ierr);
     ierr = CeedVectorDestroy(&impl->qvecsin[i]); CeedChk(ierr);
+    ierr = CeedFree(&impl->cdata[i]); CeedChk(ierr);
   }
+  ierr = CeedFree(&impl->cdata); CeedChk(ierr);
   ierr = CeedFree(&impl->evecsin); CeedChk(ierr);
   ierr = CeedFree(&impl->qvecsin); CeedChk(ierr);
 
@@ -739,6 +908,22 @@ int CeedOperatorCreate_Blocked(CeedOperator op) {
   ierr = CeedSetBackendFunction(ceed, "Operator", op, "LinearAssembleQFunction",
                                 CeedOperatorLinearAssembleQFunction_Blocked);
   CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "LinearAssembleAddDiagonal",
+                                CeedOperatorLinearAssembleAddDiagonal_Blocked);
+  CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op,
+                                "LinearAssembleAddPointBlockDiagonal",
+                                CeedOperatorLinearAssembleAddPointBlockDiagonal_Blocked);
+  CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "LinearAssembleSymbolic",
+                                CeedOperatorLinearAssembleSymbolic_Ref);
+  CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "LinearAssemble",
+                                CeedOperatorLinearAssemble_Ref); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op,
+                                "LinearAssembleElementMatrices",
+                                CeedOperatorLinearAssembleElementMatrices_Ref);
+  CeedChk(ierr);
   ierr = CeedSetBackendFunction(ceed, "Operator", op, "ApplyAdd",
                                 CeedOperatorApplyAdd_Blocked); CeedChk(ierr);
   ierr = CeedSetBackendFunction(ceed, "Operator", op, "Destroy",
@@ -28,6 +28,7 @@ typedef struct {
   *evecs;   /// E-vectors needed to apply operator (input followed by outputs)
   CeedScalar **edata;
   uint64_t *inputstate;  /// State counter of inputs
+  void **cdata;          /// Compressed E-vector data of passive inputs
   CeedVector *evecsin;   /// Input E-vectors needed to apply operator
   CeedVector *evecsout;  /// Output E-vectors needed to apply operator
   CeedVector *qvecsin;   /// Input Q-vectors needed to apply operator
@@ -5,11 +5,15 @@
 // listed, and also to define weak symbol aliases for backends that are not
 // configured.
 
+MACRO(CeedRegister_Auto)
 MACRO(CeedRegister_Avx_Blocked)
 MACRO(CeedRegister_Avx_Serial)
+MACRO(CeedRegister_Avx512_Blocked)
+MACRO(CeedRegister_Avx512_Serial)
 MACRO(CeedRegister_Cuda)
 MACRO(CeedRegister_Cuda_Gen)
 MACRO(CeedRegister_Cuda_Shared)
+MACRO(CeedRegister_Gen)
 MACRO(CeedRegister_Hip)
 MACRO(CeedRegister_Hip_Gen)
 MACRO(CeedRegister_Hip_Shared)
@@ -19,6 +23,7 @@ MACRO(CeedRegister_Memcheck_Blocked)
 MACRO(CeedRegister_Memcheck_Serial)
 MACRO(CeedRegister_Occa)
 MACRO(CeedRegister_Opt_Blocked)
+MACRO(CeedRegister_Opt_Omp)
 MACRO(CeedRegister_Opt_Serial)
 MACRO(CeedRegister_Ref)
 MACRO(CeedRegister_Ref_Blocked)
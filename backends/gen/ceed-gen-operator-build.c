@@ -0,0 +1,731 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+
+#define _XOPEN_SOURCE 700
+#include <dlfcn.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "ceed-gen.h"
+
+// Include directories of ceed.h for generated kernels, set by the Makefile
+#ifndef CEED_GEN_INCLUDE_DIR
+#  define CEED_GEN_INCLUDE_DIR "/usr/local/include"
+#endif
+#ifndef CEED_GEN_INSTALL_INCLUDE_DIR
+#  define CEED_GEN_INSTALL_INCLUDE_DIR "/usr/local/include"
+#endif
+
+typedef struct {
+  char *data;
+  size_t len, cap;
+} CeedGenSource;
+
+typedef struct {
+  CeedEvalMode emode;
+  CeedInt ncomp;         /// Components of the restriction
+  CeedInt elemsize;      /// Nodes per element of the restriction
+  CeedInt qsize;         /// Values per quadrature point of the QFunction
+  CeedInt P1d;           /// Nodes in 1D of the tensor basis
+  CeedInt basis;         /// Index of the tensor basis
+  bool strided;
+  CeedInt strides[3];
+  CeedInt compstride;
+} CeedGenField;
+
+typedef struct {
+  CeedInt dim, Q1d, Q, numbases;
+  CeedInt worksize;      /// Scalars of element work space used by the kernel
+  CeedBasis bases[2*CEED_GEN_MAX_FIELDS];
+  CeedInt numinputfields, numoutputfields;
+  CeedGenField inputs[CEED_GEN_MAX_FIELDS], outputs[CEED_GEN_MAX_FIELDS];
+  char qfpath[PATH_MAX];
+  const char *qfname;
+} CeedGenOperatorInfo;
+
+//------------------------------------------------------------------------------
+// Append to Generated Source
+//------------------------------------------------------------------------------
+static int CeedGenSourceAppend(CeedGenSource *src, const char *format, ...) {
+  int ierr;
+  va_list args;
+  va_start(args, format);
+  int len = vsnprintf(NULL, 0, format, args);
+  va_end(args);
+  if (src->len + len + 1 > src->cap) {
+    src->cap = 2*src->cap > src->len + len + 1 ? 2*src->cap :
+               src->len + len + 1;
+    ierr = CeedRealloc(src->cap, &src->data); CeedChk(ierr);
+  }
+  va_start(args, format);
+  vsnprintf(src->data + src->len, len + 1, format, args);
+  va_end(args);
+  src->len += len;
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Describe Operator Field
+//   Sets supported to false for fields the generator does not handle
+//------------------------------------------------------------------------------
+static int CeedGenFieldSetup(CeedOperatorField opfield,
+                             CeedQFunctionField qffield, bool isinput,
+                             CeedGenOperatorInfo *info, CeedGenField *field,
+                             bool *supported) {
+  int ierr;
+  CeedElemRestriction r;
+  CeedBasis basis;
+  CeedStorageMode storage;
+  ierr = CeedQFunctionFieldGetEvalMode(qffield, &field->emode); CeedChk(ierr);
+  ierr = CeedQFunctionFieldGetSize(qffield, &field->qsize); CeedChk(ierr);
+  ierr = CeedOperatorFieldGetBasis(opfield, &basis); CeedChk(ierr);
+  ierr = CeedOperatorFieldGetStorage(opfield, &storage); CeedChk(ierr);
+  *supported = storage == CEED_STORAGE_FULL;
+  switch (field->emode) {
+  case CEED_EVAL_NONE:
+    break;
+  case CEED_EVAL_INTERP:
+  case CEED_EVAL_GRAD:
+  case CEED_EVAL_WEIGHT: {
+    bool istensor;
+    CeedInt dim, Q1d;
+    ierr = CeedBasisIsTensor(basis, &istensor); CeedChk(ierr);
+    if (!istensor) {
+      *supported = false;
+      return 0;
+    }
+    ierr = CeedBasisGetDimension(basis, &dim); CeedChk(ierr);
+    ierr = CeedBasisGetNumQuadraturePoints1D(basis, &Q1d); CeedChk(ierr);
+    ierr = CeedBasisGetNumNodes1D(basis, &field->P1d); CeedChk(ierr);
+    if (!info->numbases) {
+      info->dim = dim;
+      info->Q1d = Q1d;
+    }
+    if (dim != info->dim || Q1d != info->Q1d) *supported = false;
+    field->basis = 0;
+    while (field->basis < info->numbases &&
+           info->bases[field->basis] != basis) field->basis++;
+    if (field->basis == info->numbases)
+      info->bases[info->numbases++] = basis;
+  } break;
+  default:
+    *supported = false;
+  }
+  if (field->emode == CEED_EVAL_WEIGHT) {
+    if (!isinput) *supported = false;
+    return 0;
+  }
+
+  // Restriction
+  CeedInt blksize;
+  ierr = CeedOperatorFieldGetElemRestriction(opfield, &r); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetBlockSize(r, &blksize); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumComponents(r, &field->ncomp); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetElementSize(r, &field->elemsize); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetCompStride(r, &field->compstride); CeedChk(ierr);
+  ierr = CeedElemRestrictionIsStrided(r, &field->strided); CeedChk(ierr);
+  if (blksize != 1) *supported = false;
+  if (field->strided) {
+    bool backendstrides;
+    ierr = CeedElemRestrictionHasBackendStrides(r, &backendstrides);
+    CeedChk(ierr);
+    if (backendstrides) {
+      field->strides[0] = 1;
+      field->strides[1] = field->elemsize;
+      field->strides[2] = field->elemsize*field->ncomp;
+    } else {
+      ierr = CeedElemRestrictionGetStrides(r, &field->strides); CeedChk(ierr);
+    }
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Describe Operator
+//   Sets supported to false for operators the generator does not handle
+//------------------------------------------------------------------------------
+static int CeedGenOperatorSetup(CeedOperator op, CeedGenOperatorInfo *info,
+                                bool *supported) {
+  int ierr;
+  CeedQFunction qf;
+  CeedOperatorField *opfields[2];
+  CeedQFunctionField *qffields[2];
+  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
+  ierr = CeedQFunctionGetNumArgs(qf, &info->numinputfields,
+                                 &info->numoutputfields); CeedChk(ierr);
+  ierr = CeedOperatorGetFields(op, &opfields[0], &opfields[1]); CeedChk(ierr);
+  ierr = CeedQFunctionGetFields(qf, &qffields[0], &qffields[1]); CeedChk(ierr);
+  *supported = true;
+
+  // QFunction source, as "file:name"
+  char *source, *qfname;
+  ierr = CeedQFunctionGetSourcePath(qf, &source); CeedChk(ierr);
+  qfname = source ? strrchr(source, ':') : NULL;
+  if (!qfname || qfname == source || qfname - source >= PATH_MAX) {
+    *supported = false;
+    return 0;
+  }
+  char qffile[PATH_MAX];
+  memcpy(qffile, source, qfname - source);
+  qffile[qfname - source] = '\0';
+  if (!realpath(qffile, info->qfpath)) {
+    *supported = false;
+    return 0;
+  }
+  info->qfname = qfname + 1;
+
+  // Fields
+  for (CeedInt i=0; i<info->numinputfields+info->numoutputfields; i++) {
+    const bool isinput = i < info->numinputfields;
+    const CeedInt j = isinput ? i : i - info->numinputfields;
+    bool fieldsupported;
+    ierr = CeedGenFieldSetup(opfields[!isinput][j], qffields[!isinput][j],
+                             isinput, info,
+                             isinput ? &info->inputs[j] : &info->outputs[j],
+                             &fieldsupported); CeedChk(ierr);
+    if (!fieldsupported) {
+      *supported = false;
+      return 0;
+    }
+  }
+
+  // Quadrature points and field sizes
+  if (info->numbases) {
+    info->Q = CeedIntPow(info->Q1d, info->dim);
+  } else {
+    ierr = CeedOperatorGetNumQuadraturePoints(op, &info->Q); CeedChk(ierr);
+  }
+  for (CeedInt i=0; i<info->numinputfields+info->numoutputfields; i++) {
+    const bool isinput = i < info->numinputfields;
+    CeedGenField *field = isinput ? &info->inputs[i] :
+                          &info->outputs[i - info->numinputfields];
+    if (field->emode == CEED_EVAL_NONE &&
+        field->ncomp*field->elemsize != field->qsize*info->Q)
+      *supported = false;
+    if ((field->emode == CEED_EVAL_INTERP || field->emode == CEED_EVAL_GRAD) &&
+        field->elemsize != CeedIntPow(field->P1d, info->dim))
+      *supported = false;
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Emit Array of Scalars
+//------------------------------------------------------------------------------
+static int CeedGenEmitArray(CeedGenSource *src, const char *name,
+                            CeedInt b, CeedInt n, const CeedScalar *values) {
+  int ierr;
+  ierr = CeedGenSourceAppend(src, "static const CeedScalar %s%d[%d] = {",
+                             name, b, n); CeedChk(ierr);
+  for (CeedInt i=0; i<n; i++) {
+    ierr = CeedGenSourceAppend(src, "%s%a", !i ? "\n  " : i % 4 ? ", " : ",\n  ",
+                               (double)values[i]); CeedChk(ierr);
+  }
+  ierr = CeedGenSourceAppend(src, "\n};\n"); CeedChk(ierr);
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Emit Tensor Contractions
+//   Interpolation and gradient to quadrature points, or their transposes, for
+//   a single element with the E-vector layout [comp][node] and the Q-vector
+//   layout [dim][comp][qpt]
+//------------------------------------------------------------------------------
+static int CeedGenEmitBasis(CeedGenSource *src, CeedGenOperatorInfo *info,
+                            CeedGenField *field, bool transpose,
+                            const char *u, const char *v) {
+  int ierr;
+  const CeedInt dim = info->dim, ncomp = field->ncomp;
+  const CeedInt numderiv = field->emode == CEED_EVAL_GRAD ? dim : 1;
+  const CeedInt P = transpose ? info->Q1d : field->P1d;
+  const CeedInt Q = transpose ? field->P1d : info->Q1d;
+  for (CeedInt p=0; p<numderiv; p++) {
+    CeedInt pre = ncomp*CeedIntPow(P, dim-1), post = 1;
+    for (CeedInt d=0; d<dim; d++) {
+      const bool grad = field->emode == CEED_EVAL_GRAD && p == d;
+      const bool add = transpose && p > 0 && d == dim-1;
+      char in[64], out[64];
+      if (d == 0)
+        snprintf(in, sizeof in, "%s + %d", transpose ? v : u,
+                 transpose ? p*ncomp*info->Q : 0);
+      else
+        snprintf(in, sizeof in, "tmp%d", d%2);
+      if (d == dim-1)
+        snprintf(out, sizeof out, "%s + %d", transpose ? u : v,
+                 transpose ? 0 : p*ncomp*info->Q);
+      else
+        snprintf(out, sizeof out, "tmp%d", (d+1)%2);
+      ierr = CeedGenSourceAppend(src, "    CeedGenContract(%d, %d, %d, %d, "
+                                 "CeedGen%s%d, %d, %d, %s, %s);\n", pre, P,
+                                 post, Q, grad ? "G" : "B", field->basis,
+                                 transpose, add, in, out); CeedChk(ierr);
+      pre /= P;
+      post *= Q;
+    }
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Emit L-vector Index of Node n and Component k in Element e
+//------------------------------------------------------------------------------
+static void CeedGenIndex(char *index, size_t len, CeedGenField *field,
+                         const char *offsets, CeedInt i) {
+  if (field->strided)
+    snprintf(index, len, "n*%d + k*%d + e*%d", field->strides[0],
+             field->strides[1], field->strides[2]);
+  else
+    snprintf(index, len, "%s[%d][e*%d + n] + k*%d", offsets, i,
+             field->elemsize, field->compstride);
+}
+
+//------------------------------------------------------------------------------
+// Generate Operator Source
+//------------------------------------------------------------------------------
+static int CeedGenOperatorSource(CeedGenOperatorInfo *info,
+                                 CeedGenSource *src) {
+  int ierr;
+  const CeedInt numinputfields = info->numinputfields;
+  const CeedInt numoutputfields = info->numoutputfields;
+  const CeedInt Q = info->Q;
+
+  // QFunction, with ceed.h as the QFunction source may include it
+  ierr = CeedGenSourceAppend(src,
+                             "%s"
+                             "#define CEED_QFUNCTION(name) static int name\n"
+                             "#define CeedPragmaSIMD\n"
+                             "#include <ceed.h>\n"
+                             "#include <math.h>\n"
+                             "#include <stdlib.h>\n"
+                             "#include <string.h>\n"
+                             "#include \"%s\"\n\n",
+                             sizeof(CeedScalar) == sizeof(float) ?
+                             "#define CEED_SCALAR_FLOAT\n" : "", info->qfpath);
+  CeedChk(ierr);
+
+  // Basis matrices and quadrature weights
+  CeedInt maxP1d = info->Q1d;
+  for (CeedInt b=0; b<info->numbases; b++) {
+    CeedInt P1d, Q1d = info->Q1d;
+    const CeedScalar *interp1d, *grad1d, *qweight1d;
+    ierr = CeedBasisGetNumNodes1D(info->bases[b], &P1d); CeedChk(ierr);
+    ierr = CeedBasisGetInterp1D(info->bases[b], &interp1d); CeedChk(ierr);
+    ierr = CeedBasisGetGrad1D(info->bases[b], &grad1d); CeedChk(ierr);
+    ierr = CeedBasisGetQWeights(info->bases[b], &qweight1d); CeedChk(ierr);
+    ierr = CeedGenEmitArray(src, "CeedGenB", b, Q1d*P1d, interp1d);
+    CeedChk(ierr);
+    ierr = CeedGenEmitArray(src, "CeedGenG", b, Q1d*P1d, grad1d);
+    CeedChk(ierr);
+    CeedScalar qweight[Q];
+    for (CeedInt q=0; q<Q; q++) {
+      qweight[q] = 1.0;
+      for (CeedInt d=0, stride=1; d<info->dim; d++, stride*=Q1d)
+        qweight[q] *= qweight1d[(q/stride) % Q1d];
+    }
+    ierr = CeedGenEmitArray(src, "CeedGenW", b, Q, qweight); CeedChk(ierr);
+    maxP1d = CeedIntMax(maxP1d, P1d);
+  }
+
+  // Tensor contraction, as in the reference backend
+  ierr = CeedGenSourceAppend(src, "\n"
+                             "static inline void CeedGenContract(CeedInt A, CeedInt B, CeedInt C,\n"
+                             "    CeedInt J, const CeedScalar *restrict t, bool transpose, bool add,\n"
+                             "    const CeedScalar *restrict u, CeedScalar *restrict v) {\n"
+                             "  const CeedInt tstride0 = transpose ? 1 : B;\n"
+                             "  const CeedInt tstride1 = transpose ? J : 1;\n"
+                             "  if (!add)\n"
+                             "    for (CeedInt q=0; q<A*J*C; q++)\n"
+                             "      v[q] = 0;\n"
+                             "  for (CeedInt a=0; a<A; a++)\n"
+                             "    for (CeedInt b=0; b<B; b++)\n"
+                             "      for (CeedInt j=0; j<J; j++) {\n"
+                             "        const CeedScalar tq = t[j*tstride0 + b*tstride1];\n"
+                             "        for (CeedInt c=0; c<C; c++)\n"
+                             "          v[(a*J+j)*C+c] += tq * u[(a*B+b)*C+c];\n"
+                             "      }\n"
+                             "}\n\n"); CeedChk(ierr);
+
+  // Element work arrays, in a buffer allocated once with the kernel
+  CeedInt maxncomp = 1, worksize = 0;
+  for (CeedInt i=0; i<numinputfields+numoutputfields; i++) {
+    const bool isinput = i < numinputfields;
+    CeedGenField *field = isinput ? &info->inputs[i] :
+                          &info->outputs[i - numinputfields];
+    if (field->emode == CEED_EVAL_WEIGHT) continue;
+    maxncomp = CeedIntMax(maxncomp, field->ncomp);
+    worksize += field->ncomp*field->elemsize;
+    if (field->emode != CEED_EVAL_NONE) worksize += field->qsize*Q;
+  }
+  const CeedInt tmpsize = maxncomp*CeedIntPow(maxP1d, info->dim);
+  worksize += 2*tmpsize;
+  info->worksize = worksize;
+  ierr = CeedGenSourceAppend(src,
+                             "int CeedGenOperatorApply(CeedInt nelem, void *ctx,\n"
+                             "    const CeedScalar *const *lin, CeedScalar *const *lout,\n"
+                             "    const CeedInt *const *indin, const CeedInt *const *indout,\n"
+                             "    CeedScalar *work) {\n"
+                             "  CeedScalar *const tmp0 = work;\n"
+                             "  CeedScalar *const tmp1 = work + %d;\n",
+                             tmpsize); CeedChk(ierr);
+  for (CeedInt i=0, offset=2*tmpsize; i<numinputfields+numoutputfields; i++) {
+    const bool isinput = i < numinputfields;
+    const CeedInt j = isinput ? i : i - numinputfields;
+    CeedGenField *field = isinput ? &info->inputs[j] : &info->outputs[j];
+    const char *name = isinput ? "in" : "out";
+    if (field->emode == CEED_EVAL_WEIGHT) continue;
+    ierr = CeedGenSourceAppend(src, "  CeedScalar *const e%s%d = work + %d;\n",
+                               name, j, offset); CeedChk(ierr);
+    offset += field->ncomp*field->elemsize;
+    if (field->emode == CEED_EVAL_NONE) continue;
+    ierr = CeedGenSourceAppend(src, "  CeedScalar *const q%s%d = work + %d;\n",
+                               name, j, offset); CeedChk(ierr);
+    offset += field->qsize*Q;
+  }
+
+  // QFunction arguments
+  ierr = CeedGenSourceAppend(src, "  const CeedScalar *in[%d] = {",
+                             CeedIntMax(numinputfields, 1)); CeedChk(ierr);
+  for (CeedInt i=0; i<numinputfields; i++) {
+    CeedGenField *field = &info->inputs[i];
+    if (field->emode == CEED_EVAL_WEIGHT)
+      ierr = CeedGenSourceAppend(src, "%sCeedGenW%d", i ? ", " : "",
+                                 field->basis);
+    else
+      ierr = CeedGenSourceAppend(src, "%s%sin%d", i ? ", " : "",
+                                 field->emode == CEED_EVAL_NONE ? "e" : "q", i);
+    CeedChk(ierr);
+  }
+  ierr = CeedGenSourceAppend(src, "};\n  CeedScalar *out[%d] = {",
+                             CeedIntMax(numoutputfields, 1)); CeedChk(ierr);
+  for (CeedInt i=0; i<numoutputfields; i++) {
+    ierr = CeedGenSourceAppend(src, "%s%sout%d", i ? ", " : "",
+                               info->outputs[i].emode == CEED_EVAL_NONE ?
+                               "e" : "q", i); CeedChk(ierr);
+  }
+  ierr = CeedGenSourceAppend(src, "};\n\n"
+                             "  for (CeedInt e=0; e<nelem; e++) {\n");
+  CeedChk(ierr);
+
+  // Restriction and basis action for inputs
+  for (CeedInt i=0; i<numinputfields; i++) {
+    CeedGenField *field = &info->inputs[i];
+    char index[128], u[32], v[32];
+    if (field->emode == CEED_EVAL_WEIGHT) continue;
+    CeedGenIndex(index, sizeof index, field, "indin", i);
+    ierr = CeedGenSourceAppend(src,
+                               "    // Input %d\n"
+                               "    for (CeedInt k=0; k<%d; k++)\n"
+                               "      for (CeedInt n=0; n<%d; n++)\n"
+                               "        ein%d[k*%d + n] = lin[%d][%s];\n",
+                               i, field->ncomp, field->elemsize, i,
+                               field->elemsize, i, index); CeedChk(ierr);
+    if (field->emode == CEED_EVAL_NONE) continue;
+    snprintf(u, sizeof u, "ein%d", i);
+    snprintf(v, sizeof v, "qin%d", i);
+    ierr = CeedGenEmitBasis(src, info, field, false, u, v); CeedChk(ierr);
+  }
+
+  // QFunction
+  ierr = CeedGenSourceAppend(src,
+                             "    // QFunction\n"
+                             "    int ierr = %s(ctx, %d, in, out);\n"
+                             "    if (ierr) return ierr;\n", info->qfname, Q);
+  CeedChk(ierr);
+
+  // Basis action and restriction transpose for outputs
+  for (CeedInt i=0; i<numoutputfields; i++) {
+    CeedGenField *field = &info->outputs[i];
+    char index[128], u[32], v[32];
+    ierr = CeedGenSourceAppend(src, "    // Output %d\n", i); CeedChk(ierr);
+    if (field->emode != CEED_EVAL_NONE) {
+      snprintf(u, sizeof u, "eout%d", i);
+      snprintf(v, sizeof v, "qout%d", i);
+      ierr = CeedGenEmitBasis(src, info, field, true, u, v); CeedChk(ierr);
+    }
+    CeedGenIndex(index, sizeof index, field, "indout", i);
+    ierr = CeedGenSourceAppend(src,
+                               "    for (CeedInt k=0; k<%d; k++)\n"
+                               "      for (CeedInt n=0; n<%d; n++)\n"
+                               "        lout[%d][%s] += eout%d[k*%d + n];\n",
+                               field->ncomp, field->elemsize, i, index, i,
+                               field->elemsize); CeedChk(ierr);
+  }
+  ierr = CeedGenSourceAppend(src, "  }\n  return 0;\n}\n"); CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Hash of Kernel Cache Key, 64 bit FNV-1a
+//------------------------------------------------------------------------------
+static uint64_t CeedGenHash(const char *key) {
+  uint64_t hash = 0xcbf29ce484222325;
+  for (const unsigned char *c = (const unsigned char *)key; *c; c++) {
+    hash ^= *c;
+    hash *= 0x100000001b3;
+  }
+  return hash;
+}
+
+//------------------------------------------------------------------------------
+// Read File Contents
+//   Contents are NULL if the file cannot be read
+//------------------------------------------------------------------------------
+static int CeedGenReadFile(const char *filename, char **contents) {
+  int ierr;
+  *contents = NULL;
+  FILE *file = fopen(filename, "rb");
+  if (!file) return 0;
+  fseek(file, 0, SEEK_END);
+  long len = ftell(file);
+  rewind(file);
+  if (len >= 0) {
+    ierr = CeedMalloc(len + 1, contents); CeedChk(ierr);
+    if (fread(*contents, 1, len, file) != (size_t)len) {
+      ierr = CeedFree(contents); CeedChk(ierr);
+    } else {
+      (*contents)[len] = '\0';
+    }
+  }
+  fclose(file);
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Load Kernel from Shared Object
+//------------------------------------------------------------------------------
+static void CeedGenLoad(const char *objfile, void **handle,
+                        CeedGenKernel *kernel) {
+  *handle = dlopen(objfile, RTLD_NOW | RTLD_LOCAL);
+  if (*handle)
+    *(void **)kernel = dlsym(*handle, "CeedGenOperatorApply");
+  if (*handle && !*kernel) {
+    dlclose(*handle);
+    *handle = NULL;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Run Compiler
+//   Runs the compiler with its flags and the include directories of ceed.h on
+//   srcfile, writing outfile. The compiler output is kept in logfile and
+//   reported with CEED_DEBUG if the compiler fails.
+//------------------------------------------------------------------------------
+static int CeedGenRunCompiler(Ceed ceed, const char *args,
+                              const char *srcfile, const char *outfile,
+                              const char *logfile, bool *success) {
+  int ierr;
+  Ceed_Gen *data;
+  ierr = CeedGetData(ceed, &data); CeedChk(ierr);
+
+  size_t len = strlen(data->cc) + strlen(data->cflags) +
+               strlen(CEED_GEN_INCLUDE_DIR) +
+               strlen(CEED_GEN_INSTALL_INCLUDE_DIR) + strlen(args) +
+               strlen(srcfile) + strlen(outfile) + strlen(logfile) + 64;
+  char *command;
+  ierr = CeedMalloc(len, &command); CeedChk(ierr);
+  snprintf(command, len, "%s %s -I'%s' -I'%s' %s -o '%s' '%s' >'%s' 2>&1",
+           data->cc, data->cflags, CEED_GEN_INCLUDE_DIR,
+           CEED_GEN_INSTALL_INCLUDE_DIR, args, outfile, srcfile, logfile);
+  *success = system(command) == 0;
+  if (!*success) {
+    char *log;
+    ierr = CeedGenReadFile(logfile, &log); CeedChk(ierr);
+    CeedDebug("Gen backend compiler failed: %s\n%s", command, log ? log : "");
+    ierr = CeedFree(&log); CeedChk(ierr);
+  }
+  ierr = CeedFree(&command); CeedChk(ierr);
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Kernel Cache Key
+//   The key is the compiler and its flags, the macros they predefine, which
+//   name the target CPU and instruction set extensions selected by flags such
+//   as -march=native, and the preprocessed source, which holds the sizes,
+//   evaluation modes, and basis matrices of the operator and the QFunction
+//   with every header it includes. The key is NULL if preprocessing fails.
+//------------------------------------------------------------------------------
+static int CeedGenCacheKey(Ceed ceed, const char *dir, const char *srcfile,
+                           const char *logfile, char **key) {
+  int ierr;
+  Ceed_Gen *data;
+  ierr = CeedGetData(ceed, &data); CeedChk(ierr);
+  *key = NULL;
+
+  char macrofile[PATH_MAX], ppfile[PATH_MAX], *macros = NULL, *pp = NULL;
+  bool success;
+  snprintf(macrofile, sizeof macrofile, "%s/operator.macros", dir);
+  snprintf(ppfile, sizeof ppfile, "%s/operator.i", dir);
+  ierr = CeedGenRunCompiler(ceed, "-E -dM", srcfile, macrofile, logfile,
+                            &success); CeedChk(ierr);
+  if (success) {
+    ierr = CeedGenReadFile(macrofile, &macros); CeedChk(ierr);
+  }
+  ierr = CeedGenRunCompiler(ceed, "-E -P", srcfile, ppfile, logfile,
+                            &success); CeedChk(ierr);
+  if (success) {
+    ierr = CeedGenReadFile(ppfile, &pp); CeedChk(ierr);
+  }
+  if (macros && pp) {
+    CeedGenSource src = {NULL, 0, 0};
+    ierr = CeedGenSourceAppend(&src, "%s %s\n%s\n%s", data->cc, data->cflags,
+                               macros, pp); CeedChk(ierr);
+    *key = src.data;
+  }
+  ierr = CeedFree(&macros); CeedChk(ierr);
+  ierr = CeedFree(&pp); CeedChk(ierr);
+  unlink(macrofile);
+  unlink(ppfile);
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Compile and Load Generated Source
+//   With CEED_GEN_CACHE_DIR set, shared objects are kept in that directory,
+//   named by the hash of the key, next to a copy of the key that guards
+//   against hash collisions. A NULL kernel is returned if compilation fails.
+//------------------------------------------------------------------------------
+static int CeedGenCompile(Ceed ceed, const char *source, void **handle,
+                          CeedGenKernel *kernel) {
+  int ierr;
+  Ceed_Gen *data;
+  ierr = CeedGetData(ceed, &data); CeedChk(ierr);
+  *handle = NULL;
+  *kernel = NULL;
+
+  // Scratch directory for the source and shared object, inside the cache
+  //   directory so that the shared object can be renamed into it
+  const char *tmpdir = getenv("TMPDIR");
+  char dir[PATH_MAX-16], srcfile[PATH_MAX], objfile[PATH_MAX],
+       keyfile[PATH_MAX], logfile[PATH_MAX];
+  bool cached = data->cachedir;
+  if (cached) {
+    mkdir(data->cachedir, 0777);
+    snprintf(dir, sizeof dir, "%s/tmp-XXXXXX", data->cachedir);
+    if (!mkdtemp(dir)) {
+      CeedDebug("Gen backend cannot write to cache %s", data->cachedir);
+      cached = false;
+    }
+  }
+  if (!cached) {
+    snprintf(dir, sizeof dir, "%s/ceed-gen-XXXXXX",
+             tmpdir && strcmp(tmpdir, "") ? tmpdir : "/tmp");
+    if (!mkdtemp(dir))
+      // LCOV_EXCL_START
+      return CeedError(ceed, 1, "Unable to create directory %s", dir);
+    // LCOV_EXCL_STOP
+  }
+  snprintf(srcfile, sizeof srcfile, "%s/operator.c", dir);
+  snprintf(objfile, sizeof objfile, "%s/operator.so", dir);
+  snprintf(keyfile, sizeof keyfile, "%s/operator.key", dir);
+  snprintf(logfile, sizeof logfile, "%s/operator.log", dir);
+  FILE *file = fopen(srcfile, "w");
+  if (!file)
+    // LCOV_EXCL_START
+    return CeedError(ceed, 1, "Unable to write %s", srcfile);
+  // LCOV_EXCL_STOP
+  fputs(source, file);
+  fclose(file);
+
+  // Kernel compiled by an earlier operator or run with the same key
+  char cachedobj[PATH_MAX], cachedkey[PATH_MAX], *key = NULL;
+  if (cached) {
+    ierr = CeedGenCacheKey(ceed, dir, srcfile, logfile, &key); CeedChk(ierr);
+    cached = key;
+  }
+  if (cached) {
+    const uint64_t hash = CeedGenHash(key);
+    char *cachedcontents;
+    snprintf(cachedobj, sizeof cachedobj, "%s/%016" PRIx64 ".so",
+             data->cachedir, hash);
+    snprintf(cachedkey, sizeof cachedkey, "%s/%016" PRIx64 ".key",
+             data->cachedir, hash);
+    ierr = CeedGenReadFile(cachedkey, &cachedcontents); CeedChk(ierr);
+    if (cachedcontents && !strcmp(cachedcontents, key))
+      CeedGenLoad(cachedobj, handle, kernel);
+    ierr = CeedFree(&cachedcontents); CeedChk(ierr);
+    if (*kernel)
+      CeedDebug("Gen backend loaded cached kernel %s", cachedobj);
+  }
+
+  // Compile
+  if (!*kernel) {
+    bool success;
+    ierr = CeedGenRunCompiler(ceed, "-fPIC -shared", srcfile, objfile,
+                              logfile, &success); CeedChk(ierr);
+    // Move shared object and key into the cache, shared object first, so
+    //   that a matching key is never found without its shared object
+    if (success && cached && !rename(objfile, cachedobj)) {
+      file = fopen(keyfile, "w");
+      if (file) {
+        fputs(key, file);
+        fclose(file);
+        rename(keyfile, cachedkey);
+      }
+      CeedGenLoad(cachedobj, handle, kernel);
+    } else if (success) {
+      CeedGenLoad(objfile, handle, kernel);
+    }
+    if (!*kernel)
+      CeedDebug("Gen backend failed to build kernel in %s", dir);
+  }
+  ierr = CeedFree(&key); CeedChk(ierr);
+
+  unlink(logfile);
+  unlink(keyfile);
+  unlink(objfile);
+  unlink(srcfile);
+  rmdir(dir);
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Build Operator Kernel
+//   Leaves the kernel NULL if the operator is not supported
+//------------------------------------------------------------------------------
+int CeedGenOperatorBuild(CeedOperator op) {
+  int ierr;
+  Ceed ceed;
+  CeedOperator_Gen *impl;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  ierr = CeedOperatorGetData(op, &impl); CeedChk(ierr);
+
+  bool supported;
+  CeedGenOperatorInfo info = {0};
+  ierr = CeedGenOperatorSetup(op, &info, &supported); CeedChk(ierr);
+  if (!supported) {
+    CeedDebug("Gen backend does not support operator");
+    return 0;
+  }
+
+  CeedGenSource src = {NULL, 0, 0};
+  ierr = CeedGenOperatorSource(&info, &src); CeedChk(ierr);
+  ierr = CeedGenCompile(ceed, src.data, &impl->handle, &impl->apply);
+  CeedChk(ierr);
+  ierr = CeedFree(&src.data); CeedChk(ierr);
+  if (impl->apply) {
+    ierr = CeedMalloc(info.worksize, &impl->work); CeedChk(ierr);
+  }
+  return 0;
+}
+//------------------------------------------------------------------------------
@@ -0,0 +1,234 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+
+#include <dlfcn.h>
+#include "ceed-gen.h"
+
+//------------------------------------------------------------------------------
+// Create Operator on Delegate Ceed
+//   Used for operators the generator does not support
+//------------------------------------------------------------------------------
+static int CeedOperatorCreateFallback_Gen(CeedOperator op,
+    CeedOperator *fallback) {
+  int ierr;
+  Ceed ceed, delegate;
+  CeedInt numinputfields, numoutputfields;
+  CeedQFunction qf;
+  CeedOperatorField *opfields[2];
+  CeedQFunctionField *qffields[2];
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  ierr = CeedGetDelegate(ceed, &delegate); CeedChk(ierr);
+  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
+  ierr = CeedQFunctionGetNumArgs(qf, &numinputfields, &numoutputfields);
+  CeedChk(ierr);
+  ierr = CeedOperatorGetFields(op, &opfields[0], &opfields[1]); CeedChk(ierr);
+  ierr = CeedQFunctionGetFields(qf, &qffields[0], &qffields[1]); CeedChk(ierr);
+
+  ierr = CeedOperatorCreate(delegate, qf, CEED_QFUNCTION_NONE,
+                            CEED_QFUNCTION_NONE, fallback); CeedChk(ierr);
+  for (CeedInt i=0; i<numinputfields+numoutputfields; i++) {
+    const bool isinput = i < numinputfields;
+    const CeedInt j = isinput ? i : i - numinputfields;
+    char *fieldname;
+    CeedElemRestriction r;
+    CeedBasis basis;
+    CeedVector vec;
+    CeedStorageMode storage;
+    ierr = CeedQFunctionFieldGetName(qffields[!isinput][j], &fieldname);
+    CeedChk(ierr);
+    ierr = CeedOperatorFieldGetElemRestriction(opfields[!isinput][j], &r);
+    CeedChk(ierr);
+    ierr = CeedOperatorFieldGetBasis(opfields[!isinput][j], &basis);
+    CeedChk(ierr);
+    ierr = CeedOperatorFieldGetVector(opfields[!isinput][j], &vec);
+    CeedChk(ierr);
+    ierr = CeedOperatorFieldGetStorage(opfields[!isinput][j], &storage);
+    CeedChk(ierr);
+    ierr = CeedOperatorSetField(*fallback, fieldname, r, basis, vec);
+    CeedChk(ierr);
+    if (storage != CEED_STORAGE_FULL) {
+      ierr = CeedOperatorSetFieldStorage(*fallback, fieldname, storage);
+      CeedChk(ierr);
+    }
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Operator Apply
+//------------------------------------------------------------------------------
+static int CeedOperatorApplyAdd_Gen(CeedOperator op, CeedVector invec,
+                                    CeedVector outvec, CeedRequest *request) {
+  int ierr;
+  Ceed ceed;
+  CeedOperator_Gen *impl;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  ierr = CeedOperatorGetData(op, &impl); CeedChk(ierr);
+
+  // Generate kernel on first application
+  if (!impl->built) {
+    ierr = CeedGenOperatorBuild(op); CeedChk(ierr);
+    if (!impl->apply) {
+      CeedDebug("Gen backend applies operator with /cpu/self/opt/serial");
+      ierr = CeedOperatorCreateFallback_Gen(op, &impl->fallback); CeedChk(ierr);
+    }
+    impl->built = true;
+  }
+  if (impl->fallback) {
+    ierr = CeedOperatorApplyAdd(impl->fallback, invec, outvec,
+                                CEED_REQUEST_IMMEDIATE); CeedChk(ierr);
+    return 0;
+  }
+
+  CeedInt nelem, numinputfields, numoutputfields;
+  CeedQFunction qf;
+  CeedOperatorField *opinputfields, *opoutputfields;
+  CeedQFunctionField *qfinputfields, *qfoutputfields;
+  ierr = CeedOperatorGetNumElements(op, &nelem); CeedChk(ierr);
+  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
+  ierr = CeedQFunctionGetNumArgs(qf, &numinputfields, &numoutputfields);
+  CeedChk(ierr);
+  ierr = CeedOperatorGetFields(op, &opinputfields, &opoutputfields);
+  CeedChk(ierr);
+  ierr = CeedQFunctionGetFields(qf, &qfinputfields, &qfoutputfields);
+  CeedChk(ierr);
+  CeedEvalMode emode;
+  CeedElemRestriction r;
+  CeedVector vec, outvecs[CEED_GEN_MAX_FIELDS] = {NULL};
+  const CeedScalar *lin[CEED_GEN_MAX_FIELDS] = {NULL};
+  CeedScalar *lout[CEED_GEN_MAX_FIELDS] = {NULL};
+  const CeedInt *indin[CEED_GEN_MAX_FIELDS] = {NULL};
+  const CeedInt *indout[CEED_GEN_MAX_FIELDS] = {NULL};
+  bool strided;
+
+  // Input arrays and offsets
+  for (CeedInt i=0; i<numinputfields; i++) {
+    ierr = CeedQFunctionFieldGetEvalMode(qfinputfields[i], &emode);
+    CeedChk(ierr);
+    if (emode == CEED_EVAL_WEIGHT) continue;
+    ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
+    if (vec == CEED_VECTOR_ACTIVE) vec = invec;
+    ierr = CeedVectorGetArrayRead(vec, CEED_MEM_HOST, &lin[i]); CeedChk(ierr);
+    ierr = CeedOperatorFieldGetElemRestriction(opinputfields[i], &r);
+    CeedChk(ierr);
+    ierr = CeedElemRestrictionIsStrided(r, &strided); CeedChk(ierr);
+    if (!strided) {
+      ierr = CeedElemRestrictionGetOffsets(r, CEED_MEM_HOST, &indin[i]);
+      CeedChk(ierr);
+    }
+  }
+
+  // Output arrays and offsets, with one array for outputs sharing a vector
+  for (CeedInt i=0; i<numoutputfields; i++) {
+    ierr = CeedOperatorFieldGetVector(opoutputfields[i], &vec); CeedChk(ierr);
+    if (vec == CEED_VECTOR_ACTIVE) vec = outvec;
+    outvecs[i] = vec;
+    CeedInt j = 0;
+    while (j < i && outvecs[j] != vec) j++;
+    if (j == i) {
+      ierr = CeedVectorGetArray(vec, CEED_MEM_HOST, &lout[i]); CeedChk(ierr);
+    } else {
+      lout[i] = lout[j];
+    }
+    ierr = CeedOperatorFieldGetElemRestriction(opoutputfields[i], &r);
+    CeedChk(ierr);
+    ierr = CeedElemRestrictionIsStrided(r, &strided); CeedChk(ierr);
+    if (!strided) {
+      ierr = CeedElemRestrictionGetOffsets(r, CEED_MEM_HOST, &indout[i]);
+      CeedChk(ierr);
+    }
+  }
+
+  // Context data
+  CeedQFunctionContext ctx;
+  void *ctxdata = NULL;
+  ierr = CeedQFunctionGetInnerContext(qf, &ctx); CeedChk(ierr);
+  if (ctx) {
+    ierr = CeedQFunctionContextGetData(ctx, CEED_MEM_HOST, &ctxdata);
+    CeedChk(ierr);
+  }
+
+  // Apply generated kernel
+  const int ierrapply = impl->apply(nelem, ctxdata, lin, lout, indin, indout,
+                                    impl->work);
+
+  // Restore context, arrays, and offsets, before reporting an error
+  if (ctx) {
+    ierr = CeedQFunctionContextRestoreData(ctx, &ctxdata); CeedChk(ierr);
+  }
+  for (CeedInt i=0; i<numinputfields; i++) {
+    if (!lin[i]) continue;
+    ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
+    if (vec == CEED_VECTOR_ACTIVE) vec = invec;
+    ierr = CeedVectorRestoreArrayRead(vec, &lin[i]); CeedChk(ierr);
+    if (indin[i]) {
+      ierr = CeedOperatorFieldGetElemRestriction(opinputfields[i], &r);
+      CeedChk(ierr);
+      ierr = CeedElemRestrictionRestoreOffsets(r, &indin[i]); CeedChk(ierr);
+    }
+  }
+  for (CeedInt i=0; i<numoutputfields; i++) {
+    CeedInt j = 0;
+    while (j < i && outvecs[j] != outvecs[i]) j++;
+    if (j == i) {
+      ierr = CeedVectorRestoreArray(outvecs[i], &lout[i]); CeedChk(ierr);
+    }
+    if (indout[i]) {
+      ierr = CeedOperatorFieldGetElemRestriction(opoutputfields[i], &r);
+      CeedChk(ierr);
+      ierr = CeedElemRestrictionRestoreOffsets(r, &indout[i]); CeedChk(ierr);
+    }
+  }
+  CeedChk(ierrapply);
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Operator Destroy
+//------------------------------------------------------------------------------
+static int CeedOperatorDestroy_Gen(CeedOperator op) {
+  int ierr;
+  CeedOperator_Gen *impl;
+  ierr = CeedOperatorGetData(op, &impl); CeedChk(ierr);
+
+  ierr = CeedOperatorDestroy(&impl->fallback); CeedChk(ierr);
+  ierr = CeedFree(&impl->work); CeedChk(ierr);
+  if (impl->handle)
+    dlclose(impl->handle);
+  ierr = CeedFree(&impl); CeedChk(ierr);
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Operator Create
+//------------------------------------------------------------------------------
+int CeedOperatorCreate_Gen(CeedOperator op) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  CeedOperator_Gen *impl;
+
+  ierr = CeedCalloc(1, &impl); CeedChk(ierr);
+  ierr = CeedOperatorSetData(op, impl); CeedChk(ierr);
+
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "ApplyAdd",
+                                CeedOperatorApplyAdd_Gen); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "Destroy",
+                                CeedOperatorDestroy_Gen); CeedChk(ierr);
+  return 0;
+}
+//------------------------------------------------------------------------------
@@ -0,0 +1,98 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+
+#include <stdlib.h>
+#include <string.h>
+#include "ceed-gen.h"
+
+//------------------------------------------------------------------------------
+// Copy Environment Variable or Default
+//------------------------------------------------------------------------------
+static int CeedGenGetEnv(const char *name, const char *defaultvalue,
+                         char **value) {
+  int ierr;
+  const char *env = getenv(name);
+  if (!env || !strcmp(env, "")) env = defaultvalue;
+  size_t len = strlen(env) + 1;
+  ierr = CeedMalloc(len, value); CeedChk(ierr);
+  memcpy(*value, env, len);
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Backend Destroy
+//------------------------------------------------------------------------------
+static int CeedDestroy_Gen(Ceed ceed) {
+  int ierr;
+  Ceed_Gen *data;
+  ierr = CeedGetData(ceed, &data); CeedChk(ierr);
+  ierr = CeedFree(&data->cc); CeedChk(ierr);
+  ierr = CeedFree(&data->cflags); CeedChk(ierr);
+  ierr = CeedFree(&data->cachedir); CeedChk(ierr);
+  ierr = CeedFree(&data); CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Backend Init
+//------------------------------------------------------------------------------
+static int CeedInit_Gen(const char *resource, Ceed ceed) {
+  int ierr;
+  if (strcmp(resource, "/cpu/self/gen"))
+    // LCOV_EXCL_START
+    return CeedError(ceed, 1, "Gen backend cannot use resource: %s",
+                     resource);
+  // LCOV_EXCL_STOP
+
+  // Compiler used for operator kernels
+  Ceed_Gen *data;
+  ierr = CeedCalloc(1, &data); CeedChk(ierr);
+  ierr = CeedGenGetEnv("CEED_GEN_CC", "cc", &data->cc); CeedChk(ierr);
+  ierr = CeedGenGetEnv("CEED_GEN_CFLAGS", "-O3 -march=native", &data->cflags);
+  CeedChk(ierr);
+
+  // Optional directory of compiled kernels kept across runs
+  const char *cachedir = getenv("CEED_GEN_CACHE_DIR");
+  if (cachedir && strcmp(cachedir, "")) {
+    size_t len = strlen(cachedir) + 1;
+    ierr = CeedMalloc(len, &data->cachedir); CeedChk(ierr);
+    memcpy(data->cachedir, cachedir, len);
+  }
+  ierr = CeedSetData(ceed, data); CeedChk(ierr);
+
+  // Create CEED that all objects other than operators, and operators the
+  //   generator does not support, are dispatched through
+  Ceed ceedref;
+  CeedInit("/cpu/self/opt/serial", &ceedref);
+  ierr = CeedSetDelegate(ceed, ceedref); CeedChk(ierr);
+
+  ierr = CeedSetBackendFunction(ceed, "Ceed", ceed, "Destroy",
+                                CeedDestroy_Gen); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Ceed", ceed, "OperatorCreate",
+                                CeedOperatorCreate_Gen); CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Backend Register
+//------------------------------------------------------------------------------
+CEED_INTERN int CeedRegister_Gen(void) {
+  return CeedRegister("/cpu/self/gen", CeedInit_Gen, 58);
+}
+//------------------------------------------------------------------------------
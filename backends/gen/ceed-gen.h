@@ -0,0 +1,46 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+
+#include <ceed-backend.h>
+#include <string.h>
+
+#define CEED_GEN_MAX_FIELDS 16
+
+typedef int (*CeedGenKernel)(CeedInt nelem, void *ctx,
+                             const CeedScalar *const *lin,
+                             CeedScalar *const *lout,
+                             const CeedInt *const *indin,
+                             const CeedInt *const *indout,
+                             CeedScalar *work);
+
+typedef struct {
+  char *cc;              /// Compiler, from CEED_GEN_CC
+  char *cflags;          /// Compiler flags, from CEED_GEN_CFLAGS
+  char *cachedir;        /// Kernel cache directory, from CEED_GEN_CACHE_DIR
+} Ceed_Gen;
+
+typedef struct {
+  bool built;            /// Kernel generation was attempted
+  void *handle;          /// Handle of the loaded shared object
+  CeedGenKernel apply;   /// Generated kernel, if the operator is supported
+  CeedScalar *work;      /// Element work space of the kernel
+  CeedOperator fallback; /// Operator on the delegate Ceed, otherwise
+} CeedOperator_Gen;
+
+CEED_INTERN int CeedGenOperatorBuild(CeedOperator op);
+
+CEED_INTERN int CeedOperatorCreate_Gen(CeedOperator op);
@@ -0,0 +1,659 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#include <string.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "ceed-omp.h"
+#include "../ref/ceed-ref.h"
+
+//------------------------------------------------------------------------------
+// Setup Input/Output Fields
+//------------------------------------------------------------------------------
+static int CeedOperatorSetupFields_Omp(CeedQFunction qf, CeedOperator op,
+                                       bool inOrOut, const CeedInt blksize,
+                                       const CeedInt nthreads,
+                                       CeedElemRestriction *blkrestr,
+                                       CeedVector *fullevecs, CeedVector *evecs,
+                                       CeedVector *qvecs, CeedInt starte,
+                                       CeedInt numfields, CeedInt Q) {
+  CeedInt dim, ierr, ncomp, size, P;
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  CeedBasis basis;
+  CeedElemRestriction r;
+  CeedOperatorField *opfields;
+  CeedQFunctionField *qffields;
+  if (inOrOut) {
+    ierr = CeedOperatorGetFields(op, NULL, &opfields);
+    CeedChk(ierr);
+    ierr = CeedQFunctionGetFields(qf, NULL, &qffields);
+    CeedChk(ierr);
+  } else {
+    ierr = CeedOperatorGetFields(op, &opfields, NULL);
+    CeedChk(ierr);
+    ierr = CeedQFunctionGetFields(qf, &qffields, NULL);
+    CeedChk(ierr);
+  }
+
+  // Loop over fields
+  for (CeedInt i=0; i<numfields; i++) {
+    CeedEvalMode emode;
+    ierr = CeedQFunctionFieldGetEvalMode(qffields[i], &emode); CeedChk(ierr);
+
+    if (emode != CEED_EVAL_WEIGHT) {
+      ierr = CeedOperatorFieldGetElemRestriction(opfields[i], &r);
+      CeedChk(ierr);
+      Ceed ceed;
+      ierr = CeedElemRestrictionGetCeed(r, &ceed); CeedChk(ierr);
+      CeedInt nelem, elemsize, lsize, compstride;
+      ierr = CeedElemRestrictionGetNumElements(r, &nelem); CeedChk(ierr);
+      ierr = CeedElemRestrictionGetElementSize(r, &elemsize); CeedChk(ierr);
+      ierr = CeedElemRestrictionGetLVectorSize(r, &lsize); CeedChk(ierr);
+      ierr = CeedElemRestrictionGetNumComponents(r, &ncomp); CeedChk(ierr);
+
+      bool strided;
+      ierr = CeedElemRestrictionIsStrided(r, &strided); CeedChk(ierr);
+      if (strided) {
+        CeedInt strides[3];
+        ierr = CeedElemRestrictionGetStrides(r, &strides); CeedChk(ierr);
+        ierr = CeedElemRestrictionCreateBlockedStrided(ceed, nelem, elemsize,
+               blksize, ncomp, lsize, strides, &blkrestr[i+starte]);
+        CeedChk(ierr);
+      } else {
+        const CeedInt *offsets = NULL;
+        ierr = CeedElemRestrictionGetOffsets(r, CEED_MEM_HOST, &offsets);
+        CeedChk(ierr);
+        ierr = CeedElemRestrictionGetCompStride(r, &compstride); CeedChk(ierr);
+        ierr = CeedElemRestrictionCreateBlocked(ceed, nelem, elemsize,
+                                                blksize, ncomp, compstride,
+                                                lsize, CEED_MEM_HOST,
+                                                CEED_COPY_VALUES, offsets,
+                                                &blkrestr[i+starte]);
+        CeedChk(ierr);
+        ierr = CeedElemRestrictionRestoreOffsets(r, &offsets); CeedChk(ierr);
+      }
+      ierr = CeedElemRestrictionCreateVector(blkrestr[i+starte], NULL,
+                                             &fullevecs[i+starte]);
+      CeedChk(ierr);
+    }
+
+    // Per-thread workspace
+    //   CEED_EVAL_NONE fields are read from and written to the full E-vector
+    //   directly, so their Q-vectors only wrap slices of it
+    for (CeedInt t=0; t<nthreads; t++) {
+      switch(emode) {
+      case CEED_EVAL_NONE:
+        ierr = CeedQFunctionFieldGetSize(qffields[i], &size); CeedChk(ierr);
+        ierr = CeedVectorCreate(ceed, Q*size*blksize, &qvecs[t*numfields+i]);
+        CeedChk(ierr);
+        break;
+      case CEED_EVAL_INTERP:
+        ierr = CeedQFunctionFieldGetSize(qffields[i], &size); CeedChk(ierr);
+        ierr = CeedElemRestrictionGetElementSize(r, &P);
+        CeedChk(ierr);
+        ierr = CeedVectorCreate(ceed, P*size*blksize, &evecs[t*numfields+i]);
+        CeedChk(ierr);
+        ierr = CeedVectorCreate(ceed, Q*size*blksize, &qvecs[t*numfields+i]);
+        CeedChk(ierr);
+        break;
+      case CEED_EVAL_GRAD:
+        ierr = CeedOperatorFieldGetBasis(opfields[i], &basis); CeedChk(ierr);
+        ierr = CeedQFunctionFieldGetSize(qffields[i], &size); CeedChk(ierr);
+        ierr = CeedBasisGetDimension(basis, &dim); CeedChk(ierr);
+        ierr = CeedElemRestrictionGetElementSize(r, &P);
+        CeedChk(ierr);
+        ierr = CeedVectorCreate(ceed, P*size/dim*blksize,
+                                &evecs[t*numfields+i]); CeedChk(ierr);
+        ierr = CeedVectorCreate(ceed, Q*size*blksize, &qvecs[t*numfields+i]);
+        CeedChk(ierr);
+        break;
+      case CEED_EVAL_WEIGHT: // Only on input fields
+        ierr = CeedOperatorFieldGetBasis(opfields[i], &basis); CeedChk(ierr);
+        ierr = CeedVectorCreate(ceed, Q*blksize, &qvecs[t*numfields+i]);
+        CeedChk(ierr);
+        ierr = CeedBasisApply(basis, blksize, CEED_NOTRANSPOSE,
+                              CEED_EVAL_WEIGHT, CEED_VECTOR_NONE,
+                              qvecs[t*numfields+i]); CeedChk(ierr);
+        break;
+      case CEED_EVAL_DIV:
+        break; // Not implemented
+      case CEED_EVAL_CURL:
+        break; // Not implemented
+      }
+    }
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Setup Operator
+//------------------------------------------------------------------------------
+static int CeedOperatorSetup_Omp(CeedOperator op) {
+  int ierr;
+  bool setupdone;
+  ierr = CeedOperatorIsSetupDone(op, &setupdone); CeedChk(ierr);
+  if (setupdone) return 0;
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  Ceed_Omp *ceedimpl;
+  ierr = CeedGetData(ceed, &ceedimpl); CeedChk(ierr);
+  const CeedInt blksize = ceedimpl->blksize;
+  const CeedInt nthreads = ceedimpl->nthreads;
+  CeedOperator_Omp *impl;
+  ierr = CeedOperatorGetData(op, &impl); CeedChk(ierr);
+  CeedQFunction qf;
+  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
+  CeedInt Q, numinputfields, numoutputfields;
+  ierr = CeedOperatorGetNumQuadraturePoints(op, &Q); CeedChk(ierr);
+  ierr= CeedQFunctionGetNumArgs(qf, &numinputfields, &numoutputfields);
+  CeedChk(ierr);
+
+  // Allocate
+  ierr = CeedCalloc(numinputfields + numoutputfields, &impl->blkrestr);
+  CeedChk(ierr);
+  ierr = CeedCalloc(numinputfields + numoutputfields, &impl->evecs);
+  CeedChk(ierr);
+  ierr = CeedCalloc(numinputfields + numoutputfields, &impl->edata);
+  CeedChk(ierr);
+
+  ierr = CeedCalloc(numinputfields, &impl->inputstate); CeedChk(ierr);
+  ierr = CeedCalloc(nthreads*numinputfields, &impl->evecsin); CeedChk(ierr);
+  ierr = CeedCalloc(nthreads*numoutputfields, &impl->evecsout); CeedChk(ierr);
+  ierr = CeedCalloc(nthreads*numinputfields, &impl->qvecsin); CeedChk(ierr);
+  ierr = CeedCalloc(nthreads*numoutputfields, &impl->qvecsout); CeedChk(ierr);
+
+  impl->numein = numinputfields; impl->numeout = numoutputfields;
+  impl->nthreads = nthreads;
+
+  // Per-thread QFunction copies, each with a view of the user context
+  CeedQFunctionContext ctx;
+  ierr = CeedQFunctionGetInnerContext(qf, &ctx); CeedChk(ierr);
+  ierr = CeedCalloc(nthreads, &impl->qfs); CeedChk(ierr);
+  ierr = CeedCalloc(nthreads, &impl->ctxs); CeedChk(ierr);
+  for (CeedInt t=0; t<nthreads; t++) {
+    if (ctx) {
+      ierr = CeedQFunctionContextCreate(ceed, &impl->ctxs[t]); CeedChk(ierr);
+    }
+    ierr = CeedQFunctionCreateCopy(qf, impl->ctxs[t], &impl->qfs[t]);
+    CeedChk(ierr);
+  }
+
+  // Set up infield and outfield pointer arrays
+  // Infields
+  ierr = CeedOperatorSetupFields_Omp(qf, op, 0, blksize, nthreads,
+                                     impl->blkrestr, impl->evecs,
+                                     impl->evecsin, impl->qvecsin, 0,
+                                     numinputfields, Q);
+  CeedChk(ierr);
+  // Outfields
+  ierr = CeedOperatorSetupFields_Omp(qf, op, 1, blksize, nthreads,
+                                     impl->blkrestr, impl->evecs,
+                                     impl->evecsout, impl->qvecsout,
+                                     numinputfields, numoutputfields, Q);
+  CeedChk(ierr);
+
+  ierr = CeedOperatorSetSetupDone(op); CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Setup Input Fields
+//------------------------------------------------------------------------------
+static inline int CeedOperatorSetupInputs_Omp(CeedInt numinputfields,
+    CeedQFunctionField *qfinputfields, CeedOperatorField *opinputfields,
+    CeedVector invec, CeedOperator_Omp *impl, CeedRequest *request) {
+  CeedInt ierr;
+  CeedEvalMode emode;
+  CeedVector vec;
+  uint64_t state;
+
+  for (CeedInt i=0; i<numinputfields; i++) {
+    ierr = CeedQFunctionFieldGetEvalMode(qfinputfields[i], &emode);
+    CeedChk(ierr);
+    if (emode == CEED_EVAL_WEIGHT) { // Skip
+    } else {
+      // Get input vector
+      ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
+      if (vec != CEED_VECTOR_ACTIVE) {
+        // Restrict, skipping if passive input is unchanged
+        ierr = CeedVectorGetState(vec, &state); CeedChk(ierr);
+        if (state != impl->inputstate[i]) {
+          ierr = CeedElemRestrictionApply(impl->blkrestr[i], CEED_NOTRANSPOSE,
+                                          vec, impl->evecs[i], request);
+          CeedChk(ierr);
+          impl->inputstate[i] = state;
+        }
+      } else {
+        // Restrict active input for all blocks at once, so the threaded
+        //   element loop only reads from the E-vector, borrowed from the Ceed
+        //   workspace pool
+        ierr = CeedVectorGetWorkArray_Ref(impl->evecs[i]); CeedChk(ierr);
+        ierr = CeedElemRestrictionApply(impl->blkrestr[i], CEED_NOTRANSPOSE,
+                                        invec, impl->evecs[i], request);
+        CeedChk(ierr);
+      }
+      // Get evec
+      ierr = CeedVectorGetArrayRead(impl->evecs[i], CEED_MEM_HOST,
+                                    (const CeedScalar **) &impl->edata[i]);
+      CeedChk(ierr);
+    }
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Apply Operator to a Single Element Block
+//   Each thread t uses only its own E- and Q-vectors, and each block b writes
+//   only to its own slice of the output E-vectors, so this function is safe to
+//   call concurrently for distinct (b, t) pairs.
+//------------------------------------------------------------------------------
+static int CeedOperatorApplyBlock_Omp(CeedInt b, CeedInt t, CeedInt Q,
+                                      CeedInt blksize,
+                                      CeedQFunctionField *qfinputfields,
+                                      CeedOperatorField *opinputfields,
+                                      CeedQFunctionField *qfoutputfields,
+                                      CeedOperatorField *opoutputfields,
+                                      CeedOperator_Omp *impl) {
+  CeedInt ierr;
+  CeedInt dim, elemsize, size;
+  const CeedInt numin = impl->numein, numout = impl->numeout;
+  const CeedInt e = b*blksize;
+  CeedElemRestriction Erestrict;
+  CeedEvalMode emode;
+  CeedBasis basis;
+  CeedVector *evecsin = &impl->evecsin[t*numin];
+  CeedVector *qvecsin = &impl->qvecsin[t*numin];
+  CeedVector *evecsout = &impl->evecsout[t*numout];
+  CeedVector *qvecsout = &impl->qvecsout[t*numout];
+
+  // Input basis action
+  for (CeedInt i=0; i<numin; i++) {
+    ierr = CeedQFunctionFieldGetEvalMode(qfinputfields[i], &emode);
+    CeedChk(ierr);
+    ierr = CeedQFunctionFieldGetSize(qfinputfields[i], &size); CeedChk(ierr);
+    if (emode != CEED_EVAL_WEIGHT) {
+      ierr = CeedOperatorFieldGetElemRestriction(opinputfields[i], &Erestrict);
+      CeedChk(ierr);
+      ierr = CeedElemRestrictionGetElementSize(Erestrict, &elemsize);
+      CeedChk(ierr);
+    }
+    switch(emode) {
+    case CEED_EVAL_NONE:
+      ierr = CeedVectorSetArray(qvecsin[i], CEED_MEM_HOST, CEED_USE_POINTER,
+                                &impl->edata[i][e*Q*size]); CeedChk(ierr);
+      break;
+    case CEED_EVAL_INTERP:
+    case CEED_EVAL_GRAD:
+      ierr = CeedOperatorFieldGetBasis(opinputfields[i], &basis);
+      CeedChk(ierr);
+      ierr = CeedBasisGetDimension(basis, &dim); CeedChk(ierr);
+      ierr = CeedVectorSetArray(evecsin[i], CEED_MEM_HOST, CEED_USE_POINTER,
+                                &impl->edata[i][e*elemsize*size/
+                                                (emode == CEED_EVAL_GRAD ? dim : 1)]);
+      CeedChk(ierr);
+      ierr = CeedBasisApply(basis, blksize, CEED_NOTRANSPOSE, emode,
+                            evecsin[i], qvecsin[i]); CeedChk(ierr);
+      break;
+    case CEED_EVAL_WEIGHT:
+      break; // Computed at setup
+    // LCOV_EXCL_START
+    case CEED_EVAL_DIV:
+    case CEED_EVAL_CURL: {
+      ierr = CeedOperatorFieldGetBasis(opinputfields[i], &basis);
+      CeedChk(ierr);
+      Ceed ceed;
+      ierr = CeedBasisGetCeed(basis, &ceed); CeedChk(ierr);
+      return CeedError(ceed, 1, "Ceed evaluation mode not implemented");
+      // LCOV_EXCL_STOP
+    }
+    }
+  }
+
+  // Output Q-vectors of CEED_EVAL_NONE fields write to the E-vector
+  for (CeedInt i=0; i<numout; i++) {
+    ierr = CeedQFunctionFieldGetEvalMode(qfoutputfields[i], &emode);
+    CeedChk(ierr);
+    if (emode == CEED_EVAL_NONE) {
+      ierr = CeedQFunctionFieldGetSize(qfoutputfields[i], &size);
+      CeedChk(ierr);
+      ierr = CeedVectorSetArray(qvecsout[i], CEED_MEM_HOST, CEED_USE_POINTER,
+                                &impl->edata[i + numin][e*Q*size]);
+      CeedChk(ierr);
+    }
+  }
+
+  // Q function, applied through the copy owned by this thread
+  ierr = CeedQFunctionApply(impl->qfs[t], Q*blksize, qvecsin, qvecsout);
+  CeedChk(ierr);
+
+  // Output basis action
+  for (CeedInt i=0; i<numout; i++) {
+    ierr = CeedQFunctionFieldGetEvalMode(qfoutputfields[i], &emode);
+    CeedChk(ierr);
+    if (emode == CEED_EVAL_NONE)
+      continue;
+    ierr = CeedOperatorFieldGetElemRestriction(opoutputfields[i], &Erestrict);
+    CeedChk(ierr);
+    switch(emode) {
+    case CEED_EVAL_INTERP:
+    case CEED_EVAL_GRAD:
+      ierr = CeedElemRestrictionGetElementSize(Erestrict, &elemsize);
+      CeedChk(ierr);
+      ierr = CeedQFunctionFieldGetSize(qfoutputfields[i], &size); CeedChk(ierr);
+      ierr = CeedOperatorFieldGetBasis(opoutputfields[i], &basis);
+      CeedChk(ierr);
+      ierr = CeedBasisGetDimension(basis, &dim); CeedChk(ierr);
+      ierr = CeedVectorSetArray(evecsout[i], CEED_MEM_HOST, CEED_USE_POINTER,
+                                &impl->edata[i + numin][e*elemsize*size/
+                                    (emode == CEED_EVAL_GRAD ? dim : 1)]);
+      CeedChk(ierr);
+      ierr = CeedBasisApply(basis, blksize, CEED_TRANSPOSE, emode,
+                            qvecsout[i], evecsout[i]); CeedChk(ierr);
+      break;
+    // LCOV_EXCL_START
+    default: {
+      Ceed ceed;
+      ierr = CeedElemRestrictionGetCeed(Erestrict, &ceed); CeedChk(ierr);
+      return CeedError(ceed, 1, "Ceed evaluation mode not implemented "
+                       "for output");
+      // LCOV_EXCL_STOP
+    }
+    }
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Transpose Restriction by Color
+//   Blocks of one color share no L-vector entries, so they are scattered
+//   concurrently. Each thread wraps the shared arrays in its own CeedVectors
+//   since CeedVector access locks are not thread safe.
+//------------------------------------------------------------------------------
+static int CeedOperatorRestrictTranspose_Omp(CeedElemRestriction rstr,
+    CeedVector evec, CeedVector lvec, CeedInt nthreads, CeedRequest *request) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedElemRestrictionGetCeed(rstr, &ceed); CeedChk(ierr);
+  CeedInt nblk, blksize, elemsize, ncomp, ncolors, llength;
+  const CeedInt *colorptr, *colorblks;
+  ierr = CeedElemRestrictionGetNumBlocks(rstr, &nblk); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetColoring(rstr, &ncolors, &colorptr, &colorblks);
+  CeedChk(ierr);
+
+  // Serial restriction if there is no concurrency to exploit
+  if (nthreads == 1 || ncolors == nblk) {
+    ierr = CeedElemRestrictionApply(rstr, CEED_TRANSPOSE, evec, lvec, request);
+    CeedChk(ierr);
+    return 0;
+  }
+
+  ierr = CeedElemRestrictionGetBlockSize(rstr, &blksize); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetElementSize(rstr, &elemsize); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumComponents(rstr, &ncomp); CeedChk(ierr);
+  ierr = CeedVectorGetLength(lvec, &llength); CeedChk(ierr);
+  const CeedInt blklength = blksize*elemsize*ncomp;
+  const CeedScalar *edata;
+  CeedScalar *ldata;
+  CeedVector *ewrap, *lwrap;
+  ierr = CeedVectorGetArrayRead(evec, CEED_MEM_HOST, &edata); CeedChk(ierr);
+  ierr = CeedVectorGetArray(lvec, CEED_MEM_HOST, &ldata); CeedChk(ierr);
+  ierr = CeedCalloc(nthreads, &ewrap); CeedChk(ierr);
+  ierr = CeedCalloc(nthreads, &lwrap); CeedChk(ierr);
+  for (CeedInt t=0; t<nthreads; t++) {
+    ierr = CeedVectorCreate(ceed, blklength, &ewrap[t]); CeedChk(ierr);
+    ierr = CeedVectorCreate(ceed, llength, &lwrap[t]); CeedChk(ierr);
+    ierr = CeedVectorSetArray(lwrap[t], CEED_MEM_HOST, CEED_USE_POINTER, ldata);
+    CeedChk(ierr);
+  }
+
+  int blkierr = 0;
+  #pragma omp parallel num_threads(nthreads)
+  {
+    CeedInt t = 0;
+#ifdef _OPENMP
+    t = omp_get_thread_num();
+#endif
+    for (CeedInt c=0; c<ncolors; c++) {
+      #pragma omp for schedule(static)
+      for (CeedInt i=colorptr[c]; i<colorptr[c+1]; i++) {
+        const CeedInt b = colorblks[i];
+        int err = CeedVectorSetArray(ewrap[t], CEED_MEM_HOST, CEED_USE_POINTER,
+                                     (CeedScalar *)&edata[b*blklength]);
+        if (!err)
+          err = CeedElemRestrictionApplyBlock(rstr, b, CEED_TRANSPOSE,
+                                              ewrap[t], lwrap[t],
+                                              CEED_REQUEST_IMMEDIATE);
+        if (err) {
+          #pragma omp atomic write
+          blkierr = err;
+        }
+      }
+    }
+  }
+  CeedChk(blkierr);
+
+  // Cleanup
+  for (CeedInt t=0; t<nthreads; t++) {
+    ierr = CeedVectorDestroy(&ewrap[t]); CeedChk(ierr);
+    ierr = CeedVectorDestroy(&lwrap[t]); CeedChk(ierr);
+  }
+  ierr = CeedFree(&ewrap); CeedChk(ierr);
+  ierr = CeedFree(&lwrap); CeedChk(ierr);
+  ierr = CeedVectorRestoreArrayRead(evec, &edata); CeedChk(ierr);
+  ierr = CeedVectorRestoreArray(lvec, &ldata); CeedChk(ierr);
+  if (request != CEED_REQUEST_IMMEDIATE && request != CEED_REQUEST_ORDERED)
+    *request = NULL;
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Operator Apply
+//------------------------------------------------------------------------------
+static int CeedOperatorApplyAdd_Omp(CeedOperator op, CeedVector invec,
+                                    CeedVector outvec, CeedRequest *request) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  Ceed_Omp *ceedimpl;
+  ierr = CeedGetData(ceed, &ceedimpl); CeedChk(ierr);
+  const CeedInt blksize = ceedimpl->blksize;
+  CeedOperator_Omp *impl;
+  ierr = CeedOperatorGetData(op, &impl); CeedChk(ierr);
+  CeedInt Q, numinputfields, numoutputfields, numelements;
+  ierr = CeedOperatorGetNumElements(op, &numelements); CeedChk(ierr);
+  ierr = CeedOperatorGetNumQuadraturePoints(op, &Q); CeedChk(ierr);
+  CeedInt nblks = (numelements/blksize) + !!(numelements%blksize);
+  CeedQFunction qf;
+  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
+  ierr= CeedQFunctionGetNumArgs(qf, &numinputfields, &numoutputfields);
+  CeedChk(ierr);
+  CeedOperatorField *opinputfields, *opoutputfields;
+  ierr = CeedOperatorGetFields(op, &opinputfields, &opoutputfields);
+  CeedChk(ierr);
+  CeedQFunctionField *qfinputfields, *qfoutputfields;
+  ierr = CeedQFunctionGetFields(qf, &qfinputfields, &qfoutputfields);
+  CeedChk(ierr);
+  CeedVector vec;
+
+  // Setup
+  ierr = CeedOperatorSetup_Omp(op); CeedChk(ierr);
+  const CeedInt nthreads = impl->nthreads;
+
+  // Input Evecs and Restriction
+  ierr = CeedOperatorPhaseBegin(op, CEED_PHASE_RESTRICTION); CeedChk(ierr);
+  ierr = CeedOperatorSetupInputs_Omp(numinputfields, qfinputfields,
+                                     opinputfields, invec, impl, request);
+  CeedChk(ierr);
+  ierr = CeedOperatorPhaseEnd(op, CEED_PHASE_RESTRICTION); CeedChk(ierr);
+
+  // Output Evecs, borrowed from the Ceed workspace pool
+  for (CeedInt i=0; i<numoutputfields; i++) {
+    ierr = CeedVectorGetWorkArray_Ref(impl->evecs[i + numinputfields]);
+    CeedChk(ierr);
+    ierr = CeedVectorGetArray(impl->evecs[i + numinputfields], CEED_MEM_HOST,
+                              &impl->edata[i + numinputfields]); CeedChk(ierr);
+  }
+
+  // Share the user context data with the per-thread context views
+  CeedQFunctionContext ctx;
+  ierr = CeedQFunctionGetInnerContext(qf, &ctx); CeedChk(ierr);
+  void *ctxdata = NULL;
+  if (ctx) {
+    size_t ctxsize;
+    ierr = CeedQFunctionContextGetContextSize(ctx, &ctxsize); CeedChk(ierr);
+    ierr = CeedQFunctionContextGetData(ctx, CEED_MEM_HOST, &ctxdata);
+    CeedChk(ierr);
+    for (CeedInt t=0; t<nthreads; t++) {
+      ierr = CeedQFunctionContextSetData(impl->ctxs[t], CEED_MEM_HOST,
+                                         CEED_USE_POINTER, ctxsize, ctxdata);
+      CeedChk(ierr);
+    }
+  }
+
+  // Loop through element blocks
+  //   The basis actions are fused with the QFunction in each block, so the
+  //   whole parallel region is timed as the QFunction phase
+  int blkierr = 0;
+  ierr = CeedOperatorPhaseBegin(op, CEED_PHASE_QFUNCTION); CeedChk(ierr);
+  #pragma omp parallel num_threads(nthreads)
+  {
+    CeedInt t = 0;
+#ifdef _OPENMP
+    t = omp_get_thread_num();
+#endif
+    #pragma omp for schedule(static)
+    for (CeedInt b=0; b<nblks; b++) {
+      int err = CeedOperatorApplyBlock_Omp(b, t, Q, blksize, qfinputfields,
+                                           opinputfields, qfoutputfields,
+                                           opoutputfields, impl);
+      if (err) {
+        #pragma omp atomic write
+        blkierr = err;
+      }
+    }
+  }
+  ierr = CeedOperatorPhaseEnd(op, CEED_PHASE_QFUNCTION); CeedChk(ierr);
+  CeedChk(blkierr);
+
+  if (ctx) {
+    ierr = CeedQFunctionContextRestoreData(ctx, &ctxdata); CeedChk(ierr);
+  }
+
+  // Restore input arrays
+  for (CeedInt i=0; i<numinputfields; i++) {
+    if (impl->evecs[i]) {
+      ierr = CeedVectorRestoreArrayRead(impl->evecs[i],
+                                        (const CeedScalar **) &impl->edata[i]);
+      CeedChk(ierr);
+      ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
+      if (vec == CEED_VECTOR_ACTIVE) {
+        ierr = CeedVectorRestoreWorkArray_Ref(impl->evecs[i]); CeedChk(ierr);
+      }
+    }
+  }
+
+  // Output restriction
+  //   Every block has written its own slice of the output E-vectors, so the
+  //   transpose restriction is applied after the threaded loop
+  ierr = CeedOperatorPhaseBegin(op, CEED_PHASE_RESTRICTION); CeedChk(ierr);
+  for (CeedInt i=0; i<numoutputfields; i++) {
+    ierr = CeedVectorRestoreArray(impl->evecs[i + numinputfields],
+                                  &impl->edata[i + numinputfields]);
+    CeedChk(ierr);
+    // Get output vector
+    ierr = CeedOperatorFieldGetVector(opoutputfields[i], &vec); CeedChk(ierr);
+    if (vec == CEED_VECTOR_ACTIVE)
+      vec = outvec;
+    // Restrict
+    ierr = CeedOperatorRestrictTranspose_Omp(impl->blkrestr[i + numinputfields],
+           impl->evecs[i + numinputfields], vec, nthreads, request);
+    CeedChk(ierr);
+    ierr = CeedVectorRestoreWorkArray_Ref(impl->evecs[i + numinputfields]);
+    CeedChk(ierr);
+  }
+  ierr = CeedOperatorPhaseEnd(op, CEED_PHASE_RESTRICTION); CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Operator Destroy
+//------------------------------------------------------------------------------
+static int CeedOperatorDestroy_Omp(CeedOperator op) {
+  int ierr;
+  CeedOperator_Omp *impl;
+  ierr = CeedOperatorGetData(op, &impl); CeedChk(ierr);
+
+  for (CeedInt i=0; i<impl->numein+impl->numeout; i++) {
+    ierr = CeedElemRestrictionDestroy(&impl->blkrestr[i]); CeedChk(ierr);
+    ierr = CeedVectorDestroy(&impl->evecs[i]); CeedChk(ierr);
+  }
+  ierr = CeedFree(&impl->blkrestr); CeedChk(ierr);
+  ierr = CeedFree(&impl->evecs); CeedChk(ierr);
+  ierr = CeedFree(&impl->edata); CeedChk(ierr);
+  ierr = CeedFree(&impl->inputstate); CeedChk(ierr);
+
+  for (CeedInt i=0; i<impl->nthreads*impl->numein; i++) {
+    ierr = CeedVectorDestroy(&impl->evecsin[i]); CeedChk(ierr);
+    ierr = CeedVectorDestroy(&impl->qvecsin[i]); CeedChk(ierr);
+  }
+  ierr = CeedFree(&impl->evecsin); CeedChk(ierr);
+  ierr = CeedFree(&impl->qvecsin); CeedChk(ierr);
+
+  for (CeedInt i=0; i<impl->nthreads*impl->numeout; i++) {
+    ierr = CeedVectorDestroy(&impl->evecsout[i]); CeedChk(ierr);
+    ierr = CeedVectorDestroy(&impl->qvecsout[i]); CeedChk(ierr);
+  }
+  ierr = CeedFree(&impl->evecsout); CeedChk(ierr);
+  ierr = CeedFree(&impl->qvecsout); CeedChk(ierr);
+
+  for (CeedInt t=0; t<impl->nthreads; t++) {
+    if (impl->qfs) {
+      ierr = CeedQFunctionDestroy(&impl->qfs[t]); CeedChk(ierr);
+    }
+    if (impl->ctxs) {
+      ierr = CeedQFunctionContextDestroy(&impl->ctxs[t]); CeedChk(ierr);
+    }
+  }
+  ierr = CeedFree(&impl->qfs); CeedChk(ierr);
+  ierr = CeedFree(&impl->ctxs); CeedChk(ierr);
+
+  ierr = CeedFree(&impl); CeedChk(ierr);
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Operator Create
+//------------------------------------------------------------------------------
+int CeedOperatorCreate_Omp(CeedOperator op) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  CeedOperator_Omp *impl;
+
+  ierr = CeedCalloc(1, &impl); CeedChk(ierr);
+  ierr = CeedOperatorSetData(op, impl); CeedChk(ierr);
+
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "ApplyAdd",
+                                CeedOperatorApplyAdd_Omp); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "Destroy",
+                                CeedOperatorDestroy_Omp); CeedChk(ierr);
+  return 0;
+}
+//------------------------------------------------------------------------------
@@ -0,0 +1,108 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#include <string.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "ceed-omp.h"
+
+//------------------------------------------------------------------------------
+// Backend Destroy
+//------------------------------------------------------------------------------
+static int CeedDestroy_Omp(Ceed ceed) {
+  int ierr;
+  Ceed_Omp *data;
+  ierr = CeedGetData(ceed, &data); CeedChk(ierr);
+  ierr = CeedFree(&data); CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Backend Init
+//------------------------------------------------------------------------------
+static int CeedInit_Omp(const char *resource, Ceed ceed) {
+  int ierr;
+  char *root;
+  ierr = CeedGetResourceRoot(ceed, resource, &root); CeedChk(ierr);
+  if (strcmp(root, "/cpu/self/opt/omp")) {
+    // LCOV_EXCL_START
+    ierr = CeedFree(&root); CeedChk(ierr);
+    return CeedError(ceed, 1, "OpenMP backend cannot use resource: %s",
+                     resource);
+    // LCOV_EXCL_STOP
+  }
+
+  // Set blocksize, 8 unless given in the resource as ":blksize=n", before
+  //   creating the delegate, so that an invalid blocksize leaks nothing
+  CeedInt blksize = 8;
+  ierr = CeedGetResourceQueryInt(ceed, resource, "blksize", &blksize);
+  if (!ierr && blksize < 1)
+    // LCOV_EXCL_START
+    ierr = CeedError(ceed, 1, "OpenMP backend cannot use blocksize: %d",
+                     blksize);
+  // LCOV_EXCL_STOP
+  if (ierr) {
+    // LCOV_EXCL_START
+    int ierrfree = CeedFree(&root); CeedChk(ierrfree);
+    return ierr;
+    // LCOV_EXCL_STOP
+  }
+
+  // Create blocked opt CEED that implementation will be dispatched
+  //   through unless overridden, with the same query arguments
+  char optresource[CEED_MAX_RESOURCE_LEN];
+  snprintf(optresource, sizeof optresource, "/cpu/self/opt/blocked%s",
+           &resource[strlen(root)]);
+  ierr = CeedFree(&root); CeedChk(ierr);
+  ierr = CeedSetDeterministic(ceed, true); CeedChk(ierr);
+  Ceed ceedref;
+  ierr = CeedInit(optresource, &ceedref); CeedChk(ierr);
+  ierr = CeedSetDelegate(ceed, ceedref);
+  if (ierr) {
+    // LCOV_EXCL_START
+    int ierrdestroy = CeedDestroy(&ceedref); CeedChk(ierrdestroy);
+    return ierr;
+    // LCOV_EXCL_STOP
+  }
+
+  ierr = CeedSetBackendFunction(ceed, "Ceed", ceed, "Destroy",
+                                CeedDestroy_Omp); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Ceed", ceed, "OperatorCreate",
+                                CeedOperatorCreate_Omp); CeedChk(ierr);
+
+  // Block size and number of threads
+  Ceed_Omp *data;
+  ierr = CeedCalloc(1, &data); CeedChk(ierr);
+  data->blksize = blksize;
+#ifdef _OPENMP
+  data->nthreads = omp_get_max_threads();
+#else
+  data->nthreads = 1;
+#endif
+  ierr = CeedSetData(ceed, data); CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Backend Register
+//------------------------------------------------------------------------------
+CEED_INTERN int CeedRegister_Opt_Omp(void) {
+  return CeedRegister("/cpu/self/opt/omp", CeedInit_Omp, 48);
+}
+//------------------------------------------------------------------------------
@@ -0,0 +1,42 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#include <ceed-backend.h>
+#include <string.h>
+
+typedef struct {
+  CeedInt blksize;
+  CeedInt nthreads;
+} Ceed_Omp;
+
+typedef struct {
+  CeedElemRestriction *blkrestr; /// Blocked versions of restrictions
+  CeedVector
+  *evecs;   /// E-vectors needed to apply operator (input followed by outputs)
+  CeedScalar **edata;
+  uint64_t *inputstate;  /// State counter of inputs
+  CeedVector *evecsin;   /// Per-thread input E-vectors, [nthreads][numein]
+  CeedVector *evecsout;  /// Per-thread output E-vectors, [nthreads][numeout]
+  CeedVector *qvecsin;   /// Per-thread input Q-vectors, [nthreads][numein]
+  CeedVector *qvecsout;  /// Per-thread output Q-vectors, [nthreads][numeout]
+  CeedQFunction *qfs;    /// Per-thread copies of the QFunction
+  CeedQFunctionContext *ctxs; /// Per-thread views of the QFunction context
+  CeedInt    numein;
+  CeedInt    numeout;
+  CeedInt    nthreads;
+} CeedOperator_Omp;
+
+CEED_INTERN int CeedOperatorCreate_Omp(CeedOperator op);
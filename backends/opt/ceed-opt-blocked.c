@@ -34,11 +34,16 @@ static int CeedDestroy_Opt(Ceed ceed) {
 //------------------------------------------------------------------------------
 static int CeedInit_Opt_Blocked(const char *resource, Ceed ceed) {
   int ierr;
-  if (strcmp(resource, "/cpu/self") && strcmp(resource, "/cpu/self/opt")
-      && strcmp(resource, "/cpu/self/opt/blocked"))
+  char *root;
+  ierr = CeedGetResourceRoot(ceed, resource, &root); CeedChk(ierr);
+  if (strcmp(root, "/cpu/self") && strcmp(root, "/cpu/self/opt")
+      && strcmp(root, "/cpu/self/opt/blocked")) {
     // LCOV_EXCL_START
+    ierr = CeedFree(&root); CeedChk(ierr);
     return CeedError(ceed, 1, "Opt backend cannot use resource: %s", resource);
-  // LCOV_EXCL_STOP
+    // LCOV_EXCL_STOP
+  }
+  ierr = CeedFree(&root); CeedChk(ierr);
   ierr = CeedSetDeterministic(ceed, true); CeedChk(ierr);
 
   // Create reference CEED that implementation will be dispatched
@@ -52,10 +57,18 @@ static int CeedInit_Opt_Blocked(const char *resource, Ceed ceed) {
   ierr = CeedSetBackendFunction(ceed, "Ceed", ceed, "OperatorCreate",
                                 CeedOperatorCreate_Opt); CeedChk(ierr);
 
-  // Set blocksize
+  // Set blocksize, 8 unless given in the resource as ":blksize=n"
+  CeedInt blksize = 8;
+  ierr = CeedGetResourceQueryInt(ceed, resource, "blksize", &blksize);
+  CeedChk(ierr);
+  if (blksize < 1)
+    // LCOV_EXCL_START
+    return CeedError(ceed, 1, "Opt backend cannot use blocksize: %d",
+                     blksize);
+  // LCOV_EXCL_STOP
   Ceed_Opt *data;
   ierr = CeedCalloc(1, &data); CeedChk(ierr);
-  data->blksize = 8;
+  data->blksize = blksize;
   ierr = CeedSetData(ceed, data); CeedChk(ierr);
 
   return 0;
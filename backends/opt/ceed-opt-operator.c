@@ -16,6 +16,7 @@
 
 #include <string.h>
 #include "ceed-opt.h"
+#include "../ref/ceed-ref.h"
 
 //------------------------------------------------------------------------------
 // Setup Input/Output Fields
@@ -164,13 +165,18 @@ static int CeedOperatorSetup_Opt(CeedOperator op) {
   CeedChk(ierr);
 
   ierr = CeedCalloc(16, &impl->inputstate); CeedChk(ierr);
+  ierr = CeedCalloc(16, &impl->cdata); CeedChk(ierr);
   ierr = CeedCalloc(16, &impl->evecsin); CeedChk(ierr);
   ierr = CeedCalloc(16, &impl->evecsout); CeedChk(ierr);
   ierr = CeedCalloc(16, &impl->qvecsin); CeedChk(ierr);
   ierr = CeedCalloc(16, &impl->qvecsout); CeedChk(ierr);
+  ierr = CeedCalloc(16, &impl->fusedin); CeedChk(ierr);
 
   impl->numein = numinputfields; impl->numeout = numoutputfields;
 
+  // Inputs evaluated together
+  ierr = CeedOperatorGetFusedInputs_Ref(op, impl->fusedin); CeedChk(ierr);
+
   // Set up infield and outfield pointer arrays
   // Infields
   ierr = CeedOperatorSetupFields_Opt(qf, op, 0, blksize, impl->blkrestr,
@@ -185,6 +191,24 @@ static int CeedOperatorSetup_Opt(CeedOperator op) {
                                      numoutputfields, Q);
   CeedChk(ierr);
 
+  // Compressed storage of passive inputs
+  for (CeedInt i=0; i<numinputfields; i++) {
+    CeedStorageMode storage;
+    ierr = CeedOperatorFieldGetStorage(opinputfields[i], &storage);
+    CeedChk(ierr);
+    if (storage != CEED_STORAGE_FULL) {
+      CeedInt nblks, size, csize;
+      size_t valsize;
+      ierr = CeedElemRestrictionGetNumBlocks(impl->blkrestr[i], &nblks);
+      CeedChk(ierr);
+      ierr = CeedQFunctionFieldGetSize(qfinputfields[i], &size); CeedChk(ierr);
+      ierr = CeedStorageGetSize_Ref(storage, size, &csize, &valsize);
+      CeedChk(ierr);
+      ierr = CeedMallocArray(nblks*blksize*Q*csize, valsize, &impl->cdata[i]);
+      CeedChk(ierr);
+    }
+  }
+
   // Identity QFunctions
   if (impl->identityqf) {
     CeedEvalMode inmode, outmode;
@@ -217,9 +241,13 @@ static inline int CeedOperatorSetupInputs_Opt(CeedInt numinputfields,
   CeedInt ierr;
   CeedEvalMode emode;
   CeedVector vec;
+  CeedStorageMode storage;
   uint64_t state;
 
   for (CeedInt i=0; i<numinputfields; i++) {
+    // Skip input restricted with the one it is fused with
+    if (impl->fusedin[i] >= 0 && impl->fusedin[i] < i)
+      continue;
     ierr = CeedQFunctionFieldGetEvalMode(qfinputfields[i], &emode);
     CeedChk(ierr);
     if (emode == CEED_EVAL_WEIGHT) { // Skip
@@ -229,12 +257,41 @@ static inline int CeedOperatorSetupInputs_Opt(CeedInt numinputfields,
       if (vec != CEED_VECTOR_ACTIVE) {
         // Restrict
         ierr = CeedVectorGetState(vec, &state); CeedChk(ierr);
+        ierr = CeedOperatorFieldGetStorage(opinputfields[i], &storage);
+        CeedChk(ierr);
         if (state != impl->inputstate[i]) {
+          if (!impl->evecs[i]) {
+            ierr = CeedElemRestrictionCreateVector(impl->blkrestr[i], NULL,
+                                                   &impl->evecs[i]);
+            CeedChk(ierr);
+          }
           ierr = CeedElemRestrictionApply(impl->blkrestr[i], CEED_NOTRANSPOSE,
                                           vec, impl->evecs[i], request);
           CeedChk(ierr);
           impl->inputstate[i] = state;
+          // Compress, keeping only the compressed copy of the Evec
+          if (storage != CEED_STORAGE_FULL) {
+            CeedInt nblks, blksize, Q, size;
+            const CeedScalar *e;
+            ierr = CeedElemRestrictionGetNumBlocks(impl->blkrestr[i], &nblks);
+            CeedChk(ierr);
+            ierr = CeedElemRestrictionGetBlockSize(impl->blkrestr[i], &blksize);
+            CeedChk(ierr);
+            ierr = CeedElemRestrictionGetElementSize(impl->blkrestr[i], &Q);
+            CeedChk(ierr);
+            ierr = CeedQFunctionFieldGetSize(qfinputfields[i], &size);
+            CeedChk(ierr);
+            ierr = CeedVectorGetArrayRead(impl->evecs[i], CEED_MEM_HOST, &e);
+            CeedChk(ierr);
+            ierr = CeedStorageCompress_Ref(storage, size, Q*blksize, nblks, e,
+                                           impl->cdata[i]); CeedChk(ierr);
+            ierr = CeedVectorRestoreArrayRead(impl->evecs[i], &e);
+            CeedChk(ierr);
+            ierr = CeedVectorDestroy(&impl->evecs[i]); CeedChk(ierr);
+          }
         }
+        if (storage != CEED_STORAGE_FULL)
+          continue;
       } else {
         // Set Qvec for CEED_EVAL_NONE
         if (emode == CEED_EVAL_NONE) {
@@ -246,6 +303,8 @@ static inline int CeedOperatorSetupInputs_Opt(CeedInt numinputfields,
           ierr = CeedVectorRestoreArray(impl->evecsin[i],
                                         &impl->edata[i]); CeedChk(ierr);
         }
+        // Active input is restricted block by block, so no full Evec
+        continue;
       }
       // Get evec
       ierr = CeedVectorGetArrayRead(impl->evecs[i], CEED_MEM_HOST,
@@ -261,8 +320,9 @@ static inline int CeedOperatorSetupInputs_Opt(CeedInt numinputfields,
 //------------------------------------------------------------------------------
 static inline int CeedOperatorInputBasis_Opt(CeedInt e, CeedInt Q,
     CeedQFunctionField *qfinputfields, CeedOperatorField *opinputfields,
-    CeedInt numinputfields, CeedInt blksize, CeedVector invec, bool skipactive,
-    CeedOperator_Opt *impl, CeedRequest *request) {
+    CeedInt numinputfields, CeedInt blksize, CeedOperator op, CeedVector invec,
+    bool skipactive, bool profile, CeedOperator_Opt *impl,
+    CeedRequest *request) {
   CeedInt ierr;
   CeedInt dim, elemsize, size;
   CeedElemRestriction Erestrict;
@@ -271,6 +331,10 @@ static inline int CeedOperatorInputBasis_Opt(CeedInt e, CeedInt Q,
   CeedVector vec;
 
   for (CeedInt i=0; i<numinputfields; i++) {
+    const CeedInt fused = impl->fusedin[i];
+    // Skip input evaluated with the one it is fused with
+    if (fused >= 0 && fused < i)
+      continue;
     ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
     // Skip active input
     if (skipactive) {
@@ -289,16 +353,38 @@ static inline int CeedOperatorInputBasis_Opt(CeedInt e, CeedInt Q,
     ierr = CeedQFunctionFieldGetSize(qfinputfields[i], &size); CeedChk(ierr);
     // Restrict block active input
     if (vec == CEED_VECTOR_ACTIVE) {
+      if (profile) {
+        ierr = CeedOperatorPhaseBegin(op, CEED_PHASE_RESTRICTION);
+        CeedChk(ierr);
+      }
       ierr = CeedElemRestrictionApplyBlock(impl->blkrestr[i], e/blksize,
                                            CEED_NOTRANSPOSE, invec,
                                            impl->evecsin[i], request);
       CeedChk(ierr);
+      if (profile) {
+        ierr = CeedOperatorPhaseEnd(op, CEED_PHASE_RESTRICTION);
+        CeedChk(ierr);
+      }
       activein = 1;
     }
     // Basis action
+    if (profile) {
+      ierr = CeedOperatorPhaseBegin(op, CEED_PHASE_BASIS); CeedChk(ierr);
+    }
     switch(emode) {
     case CEED_EVAL_NONE:
-      if (!activein) {
+      if (impl->cdata[i]) {
+        // Expand compressed storage
+        CeedStorageMode storage;
+        CeedScalar *q;
+        ierr = CeedOperatorFieldGetStorage(opinputfields[i], &storage);
+        CeedChk(ierr);
+        ierr = CeedVectorGetArray(impl->qvecsin[i], CEED_MEM_HOST, &q);
+        CeedChk(ierr);
+        ierr = CeedStorageExpand_Ref(storage, size, Q*blksize, e/blksize,
+                                     impl->cdata[i], q); CeedChk(ierr);
+        ierr = CeedVectorRestoreArray(impl->qvecsin[i], &q); CeedChk(ierr);
+      } else if (!activein) {
         ierr = CeedVectorSetArray(impl->qvecsin[i], CEED_MEM_HOST,
                                   CEED_USE_POINTER,
                                   &impl->edata[i][e*Q*size]); CeedChk(ierr);
@@ -313,9 +399,16 @@ static inline int CeedOperatorInputBasis_Opt(CeedInt e, CeedInt Q,
                                   &impl->edata[i][e*elemsize*size]);
         CeedChk(ierr);
       }
-      ierr = CeedBasisApply(basis, blksize, CEED_NOTRANSPOSE,
-                            CEED_EVAL_INTERP, impl->evecsin[i],
-                            impl->qvecsin[i]); CeedChk(ierr);
+      if (fused >= 0) {
+        ierr = CeedBasisApplyInterpGrad_Ref(basis, blksize, impl->evecsin[i],
+                                            impl->qvecsin[i],
+                                            impl->qvecsin[fused]);
+        CeedChk(ierr);
+      } else {
+        ierr = CeedBasisApply(basis, blksize, CEED_NOTRANSPOSE,
+                              CEED_EVAL_INTERP, impl->evecsin[i],
+                              impl->qvecsin[i]); CeedChk(ierr);
+      }
       break;
     case CEED_EVAL_GRAD:
       ierr = CeedOperatorFieldGetBasis(opinputfields[i], &basis);
@@ -327,9 +420,16 @@ static inline int CeedOperatorInputBasis_Opt(CeedInt e, CeedInt Q,
                                   &impl->edata[i][e*elemsize*size/dim]);
         CeedChk(ierr);
       }
-      ierr = CeedBasisApply(basis, blksize, CEED_NOTRANSPOSE,
-                            CEED_EVAL_GRAD, impl->evecsin[i],
-                            impl->qvecsin[i]); CeedChk(ierr);
+      if (fused >= 0) {
+        ierr = CeedBasisApplyInterpGrad_Ref(basis, blksize, impl->evecsin[i],
+                                            impl->qvecsin[fused],
+                                            impl->qvecsin[i]);
+        CeedChk(ierr);
+      } else {
+        ierr = CeedBasisApply(basis, blksize, CEED_NOTRANSPOSE,
+                              CEED_EVAL_GRAD, impl->evecsin[i],
+                              impl->qvecsin[i]); CeedChk(ierr);
+      }
       break;
     case CEED_EVAL_WEIGHT:
       break;  // No action
@@ -344,6 +444,9 @@ static inline int CeedOperatorInputBasis_Opt(CeedInt e, CeedInt Q,
       // LCOV_EXCL_STOP
     }
     }
+    if (profile) {
+      ierr = CeedOperatorPhaseEnd(op, CEED_PHASE_BASIS); CeedChk(ierr);
+    }
   }
   return 0;
 }
@@ -354,7 +457,7 @@ static inline int CeedOperatorInputBasis_Opt(CeedInt e, CeedInt Q,
 static inline int CeedOperatorOutputBasis_Opt(CeedInt e, CeedInt Q,
     CeedQFunctionField *qfoutputfields, CeedOperatorField *opoutputfields,
     CeedInt blksize, CeedInt numinputfields, CeedInt numoutputfields,
-    CeedOperator op, CeedVector outvec, CeedOperator_Opt *impl,
+    CeedOperator op, CeedVector outvec, bool profile, CeedOperator_Opt *impl,
     CeedRequest *request) {
   CeedInt ierr;
   CeedElemRestriction Erestrict;
@@ -369,6 +472,9 @@ static inline int CeedOperatorOutputBasis_Opt(CeedInt e, CeedInt Q,
     ierr = CeedQFunctionFieldGetEvalMode(qfoutputfields[i], &emode);
     CeedChk(ierr);
     // Basis action
+    if (profile) {
+      ierr = CeedOperatorPhaseBegin(op, CEED_PHASE_BASIS); CeedChk(ierr);
+    }
     switch(emode) {
     case CEED_EVAL_NONE:
       break; // No action
@@ -401,16 +507,25 @@ static inline int CeedOperatorOutputBasis_Opt(CeedInt e, CeedInt Q,
       // LCOV_EXCL_STOP
     }
     }
+    if (profile) {
+      ierr = CeedOperatorPhaseEnd(op, CEED_PHASE_BASIS); CeedChk(ierr);
+    }
     // Restrict output block
     // Get output vector
     ierr = CeedOperatorFieldGetVector(opoutputfields[i], &vec); CeedChk(ierr);
     if (vec == CEED_VECTOR_ACTIVE)
       vec = outvec;
     // Restrict
+    if (profile) {
+      ierr = CeedOperatorPhaseBegin(op, CEED_PHASE_RESTRICTION); CeedChk(ierr);
+    }
     ierr = CeedElemRestrictionApplyBlock(impl->blkrestr[i+impl->numein],
                                          e/blksize, CEED_TRANSPOSE,
                                          impl->evecsout[i], vec, request);
     CeedChk(ierr);
+    if (profile) {
+      ierr = CeedOperatorPhaseEnd(op, CEED_PHASE_RESTRICTION); CeedChk(ierr);
+    }
   }
   return 0;
 }
@@ -424,10 +539,15 @@ static inline int CeedOperatorRestoreInputs_Opt(CeedInt numinputfields,
   CeedInt ierr;
   CeedEvalMode emode;
 
+  CeedVector vec;
+
   for (CeedInt i=0; i<numinputfields; i++) {
     ierr = CeedQFunctionFieldGetEvalMode(qfinputfields[i], &emode);
     CeedChk(ierr);
-    if (emode == CEED_EVAL_WEIGHT) { // Skip
+    ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
+    if (emode == CEED_EVAL_WEIGHT || impl->cdata[i] ||
+        vec == CEED_VECTOR_ACTIVE ||
+        (impl->fusedin[i] >= 0 && impl->fusedin[i] < i)) { // Skip
     } else {
       ierr = CeedVectorRestoreArrayRead(impl->evecs[i],
                                         (const CeedScalar **) &impl->edata[i]);
@@ -470,9 +590,11 @@ static int CeedOperatorApplyAdd_Opt(CeedOperator op, CeedVector invec,
   ierr = CeedOperatorSetup_Opt(op); CeedChk(ierr);
 
   // Input Evecs and Restriction
+  ierr = CeedOperatorPhaseBegin(op, CEED_PHASE_RESTRICTION); CeedChk(ierr);
   ierr = CeedOperatorSetupInputs_Opt(numinputfields, qfinputfields,
                                      opinputfields, invec, impl, request);
   CeedChk(ierr);
+  ierr = CeedOperatorPhaseEnd(op, CEED_PHASE_RESTRICTION); CeedChk(ierr);
 
   // Output Lvecs, Evecs, and Qvecs
   for (CeedInt i=0; i<numoutputfields; i++) {
@@ -493,23 +615,31 @@ static int CeedOperatorApplyAdd_Opt(CeedOperator op, CeedVector invec,
     }
   }
 
-  // Loop through elements
+  // Loop through elements, timing phases only when profiling
+  bool profile;
+  ierr = CeedOperatorIsProfiling(op, &profile); CeedChk(ierr);
   for (CeedInt e=0; e<nblks*blksize; e+=blksize) {
     // Input basis apply
     ierr = CeedOperatorInputBasis_Opt(e, Q, qfinputfields, opinputfields,
-                                      numinputfields, blksize, invec, false,
-                                      impl, request); CeedChk(ierr);
+                                      numinputfields, blksize, op, invec, false,
+                                      profile, impl, request); CeedChk(ierr);
 
     // Q function
     if (!impl->identityqf) {
+      if (profile) {
+        ierr = CeedOperatorPhaseBegin(op, CEED_PHASE_QFUNCTION); CeedChk(ierr);
+      }
       ierr = CeedQFunctionApply(qf, Q*blksize, impl->qvecsin, impl->qvecsout);
       CeedChk(ierr);
+      if (profile) {
+        ierr = CeedOperatorPhaseEnd(op, CEED_PHASE_QFUNCTION); CeedChk(ierr);
+      }
     }
 
     // Output basis apply and restrict
     ierr = CeedOperatorOutputBasis_Opt(e, Q, qfoutputfields, opoutputfields,
                                        blksize, numinputfields, numoutputfields,
-                                       op, outvec, impl, request);
+                                       op, outvec, profile, impl, request);
     CeedChk(ierr);
   }
 
@@ -522,10 +652,12 @@ static int CeedOperatorApplyAdd_Opt(CeedOperator op, CeedVector invec,
 }
 
 //------------------------------------------------------------------------------
-// Assemble Linear QFunction
+// Assemble QFunction in blocked layout
+//   The assembled values are stored in the E-vector layout of a blocked
+//   strided restriction with numactivein*numactiveout components
 //------------------------------------------------------------------------------
-static int CeedOperatorLinearAssembleQFunction_Opt(CeedOperator op,
-    CeedVector *assembled, CeedElemRestriction *rstr, CeedRequest *request) {
+static int CeedOperatorAssembleQFunctionBlocked_Opt(CeedOperator op,
+    CeedVector *lvec, CeedInt *numactive, CeedRequest *request) {
   int ierr;
   Ceed ceed;
   ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
@@ -548,7 +680,7 @@ static int CeedOperatorLinearAssembleQFunction_Opt(CeedOperator op,
   CeedQFunctionField *qfinputfields, *qfoutputfields;
   ierr = CeedQFunctionGetFields(qf, &qfinputfields, &qfoutputfields);
   CeedChk(ierr);
-  CeedVector vec, lvec;
+  CeedVector vec;
   CeedInt numactivein = 0, numactiveout = 0;
   CeedVector *activein = NULL;
   CeedScalar *a, *tmp;
@@ -610,25 +742,16 @@ static int CeedOperatorLinearAssembleQFunction_Opt(CeedOperator op,
 
   // Setup lvec
   ierr = CeedVectorCreate(ceed, nblks*blksize*Q*numactivein*numactiveout,
-                          &lvec); CeedChk(ierr);
-  ierr = CeedVectorGetArray(lvec, CEED_MEM_HOST, &a); CeedChk(ierr);
-
-  // Create output restriction
-  CeedInt strides[3] = {1, Q, numactivein *numactiveout*Q};
-  ierr = CeedElemRestrictionCreateStrided(ceed, numelements, Q,
-                                          numactivein*numactiveout,
-                                          numactivein*numactiveout*numelements*Q,
-                                          strides, rstr); CeedChk(ierr);
-  // Create assembled vector
-  ierr = CeedVectorCreate(ceed, numelements*Q*numactivein*numactiveout,
-                          assembled); CeedChk(ierr);
+                          lvec); CeedChk(ierr);
+  ierr = CeedVectorGetArray(*lvec, CEED_MEM_HOST, &a); CeedChk(ierr);
+  *numactive = numactivein*numactiveout;
 
   // Loop through elements
   for (CeedInt e=0; e<nblks*blksize; e+=blksize) {
     // Input basis apply
     ierr = CeedOperatorInputBasis_Opt(e, Q, qfinputfields, opinputfields,
-                                      numinputfields, blksize, NULL, true,
-                                      impl, request); CeedChk(ierr);
+                                      numinputfields, blksize, op, NULL, true,
+                                      false, impl, request); CeedChk(ierr);
 
     // Assemble QFunction
     for (CeedInt in=0; in<numactivein; in++) {
@@ -675,27 +798,107 @@ static int CeedOperatorLinearAssembleQFunction_Opt(CeedOperator op,
                                        opinputfields, impl);
   CeedChk(ierr);
 
+  ierr = CeedVectorRestoreArray(*lvec, &a); CeedChk(ierr);
+
+  // Cleanup
+  for (CeedInt i=0; i<numactivein; i++) {
+    ierr = CeedVectorDestroy(&activein[i]); CeedChk(ierr);
+  }
+  ierr = CeedFree(&activein); CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Assemble Linear QFunction
+//------------------------------------------------------------------------------
+static int CeedOperatorLinearAssembleQFunction_Opt(CeedOperator op,
+    CeedVector *assembled, CeedElemRestriction *rstr, CeedRequest *request) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  Ceed_Opt *ceedimpl;
+  ierr = CeedGetData(ceed, &ceedimpl); CeedChk(ierr);
+  const CeedInt blksize = ceedimpl->blksize;
+  CeedInt Q, numelements, numactive;
+  ierr = CeedOperatorGetNumElements(op, &numelements); CeedChk(ierr);
+  ierr = CeedOperatorGetNumQuadraturePoints(op, &Q); CeedChk(ierr);
+
+  // Assemble QFunction
+  CeedVector lvec;
+  ierr = CeedOperatorAssembleQFunctionBlocked_Opt(op, &lvec, &numactive,
+         request); CeedChk(ierr);
+
+  // Create output restriction
+  CeedInt strides[3] = {1, Q, numactive*Q};
+  ierr = CeedElemRestrictionCreateStrided(ceed, numelements, Q, numactive,
+                                          numactive*numelements*Q, strides,
+                                          rstr); CeedChk(ierr);
+  // Create assembled vector
+  ierr = CeedVectorCreate(ceed, numelements*Q*numactive, assembled);
+  CeedChk(ierr);
+
   // Output blocked restriction
-  ierr = CeedVectorRestoreArray(lvec, &a); CeedChk(ierr);
   ierr = CeedVectorSetValue(*assembled, 0.0); CeedChk(ierr);
   CeedElemRestriction blkrstr;
   ierr = CeedElemRestrictionCreateBlockedStrided(ceed, numelements, Q, blksize,
-         numactivein*numactiveout, numactivein*numactiveout*numelements*Q,
-         strides, &blkrstr); CeedChk(ierr);
+         numactive, numactive*numelements*Q, strides, &blkrstr); CeedChk(ierr);
   ierr = CeedElemRestrictionApply(blkrstr, CEED_TRANSPOSE, lvec, *assembled,
                                   request); CeedChk(ierr);
 
   // Cleanup
-  for (CeedInt i=0; i<numactivein; i++) {
-    ierr = CeedVectorDestroy(&activein[i]); CeedChk(ierr);
-  }
-  ierr = CeedFree(&activein); CeedChk(ierr);
   ierr = CeedVectorDestroy(&lvec); CeedChk(ierr);
   ierr = CeedElemRestrictionDestroy(&blkrstr); CeedChk(ierr);
 
   return 0;
 }
 
+//------------------------------------------------------------------------------
+// Assemble diagonal common code
+//   The diagonal is accumulated per element block directly from the blocked
+//   assembled QFunction
+//------------------------------------------------------------------------------
+static int CeedOperatorAssembleAddDiagonalCore_Opt(CeedOperator op,
+    CeedVector assembled, CeedRequest *request, const bool pointBlock) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  Ceed_Opt *ceedimpl;
+  ierr = CeedGetData(ceed, &ceedimpl); CeedChk(ierr);
+  const CeedInt blksize = ceedimpl->blksize;
+  CeedInt numactive;
+
+  // Assemble QFunction
+  CeedVector lvec;
+  ierr = CeedOperatorAssembleQFunctionBlocked_Opt(op, &lvec, &numactive,
+         request); CeedChk(ierr);
+
+  // Assemble diagonal
+  ierr = CeedOperatorAssembleAddDiagonalBlocked_Ref(op, lvec, blksize,
+         assembled, request, pointBlock); CeedChk(ierr);
+
+  // Cleanup
+  ierr = CeedVectorDestroy(&lvec); CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Assemble Linear Diagonal
+//------------------------------------------------------------------------------
+static int CeedOperatorLinearAssembleAddDiagonal_Opt(CeedOperator op,
+    CeedVector assembled, CeedRequest *request) {
+  return CeedOperatorAssembleAddDiagonalCore_Opt(op, assembled, request, false);
+}
+
+//------------------------------------------------------------------------------
+// Assemble Linear Point Block Diagonal
+//------------------------------------------------------------------------------
+static int CeedOperatorLinearAssembleAddPointBlockDiagonal_Opt(CeedOperator op,
+    CeedVector assembled, CeedRequest *request) {
+  return CeedOperatorAssembleAddDiagonalCore_Opt(op, assembled, request, true);
+}
+
 //------------------------------------------------------------------------------
 // Operator Destroy
 //------------------------------------------------------------------------------
@@ -712,11 +915,14 @@ static int CeedOperatorDestroy_Opt(CeedOperator op) {
   ierr = CeedFree(&impl->evecs); CeedChk(ierr);
   ierr = CeedFree(&impl->edata); CeedChk(ierr);
   ierr = CeedFree(&impl->inputstate); CeedChk(ierr);
+  ierr = CeedFree(&impl->fusedin); CeedChk(ierr);
 
   for (CeedInt i=0; i<impl->numein; i++) {
     ierr = CeedVectorDestroy(&impl->evecsin[i]); CeedChk(ierr);
     ierr = CeedVectorDestroy(&impl->qvecsin[i]); CeedChk(ierr);
+    ierr = CeedFree(&impl->cdata[i]); CeedChk(ierr);
   }
+  ierr = CeedFree(&impl->cdata); CeedChk(ierr);
   ierr = CeedFree(&impl->evecsin); CeedChk(ierr);
   ierr = CeedFree(&impl->qvecsin); CeedChk(ierr);
 
@@ -746,7 +952,7 @@ int CeedOperatorCreate_Opt(CeedOperator op) {
   ierr = CeedCalloc(1, &impl); CeedChk(ierr);
   ierr = CeedOperatorSetData(op, impl); CeedChk(ierr);
 
-  if (blksize != 1 && blksize != 8)
+  if (blksize < 1)
     // LCOV_EXCL_START
     return CeedError(ceed, 1, "Opt backend cannot use blocksize: %d", blksize);
   // LCOV_EXCL_STOP
@@ -754,6 +960,22 @@ int CeedOperatorCreate_Opt(CeedOperator op) {
   ierr = CeedSetBackendFunction(ceed, "Operator", op, "LinearAssembleQFunction",
                                 CeedOperatorLinearAssembleQFunction_Opt);
   CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "LinearAssembleAddDiagonal",
+                                CeedOperatorLinearAssembleAddDiagonal_Opt);
+  CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op,
+                                "LinearAssembleAddPointBlockDiagonal",
+                                CeedOperatorLinearAssembleAddPointBlockDiagonal_Opt);
+  CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "LinearAssembleSymbolic",
+                                CeedOperatorLinearAssembleSymbolic_Ref);
+  CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "LinearAssemble",
+                                CeedOperatorLinearAssemble_Ref); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op,
+                                "LinearAssembleElementMatrices",
+                                CeedOperatorLinearAssembleElementMatrices_Ref);
+  CeedChk(ierr);
   ierr = CeedSetBackendFunction(ceed, "Operator", op, "ApplyAdd",
                                 CeedOperatorApplyAdd_Opt); CeedChk(ierr);
   ierr = CeedSetBackendFunction(ceed, "Operator", op, "Destroy",
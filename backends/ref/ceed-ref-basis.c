@@ -16,6 +16,51 @@
 
 #include "ceed-ref.h"
 
+//------------------------------------------------------------------------------
+// Basis Get Scratch
+//   The scratch of a basis is allocated once for the largest batch of elements
+//   seen so far and reused across calls; a concurrent caller, such as another
+//   OpenMP thread applying the same basis, gets a buffer of its own
+//------------------------------------------------------------------------------
+static int CeedBasisGetScratch_Ref(CeedBasis_Ref *impl, CeedInt length,
+                                   CeedScalar **scratch) {
+  int ierr;
+  if (pthread_mutex_trylock(&impl->scratchlock)) {
+    ierr = CeedMalloc(length, scratch); CeedChk(ierr);
+    return 0;
+  }
+  if (length > impl->scratchsize) {
+    ierr = CeedFree(&impl->scratch);
+    if (!ierr)
+      ierr = CeedMalloc(length, &impl->scratch);
+    if (ierr) {
+      // LCOV_EXCL_START
+      impl->scratchsize = 0;
+      pthread_mutex_unlock(&impl->scratchlock);
+      return ierr;
+      // LCOV_EXCL_STOP
+    }
+    impl->scratchsize = length;
+  }
+  *scratch = impl->scratch;
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Basis Restore Scratch
+//------------------------------------------------------------------------------
+static int CeedBasisRestoreScratch_Ref(CeedBasis_Ref *impl,
+                                       CeedScalar **scratch) {
+  int ierr;
+  if (*scratch == impl->scratch) {
+    pthread_mutex_unlock(&impl->scratchlock);
+    *scratch = NULL;
+  } else {
+    ierr = CeedFree(scratch); CeedChk(ierr);
+  }
+  return 0;
+}
+
 //------------------------------------------------------------------------------
 // Basis Apply
 //------------------------------------------------------------------------------
@@ -58,11 +103,23 @@ static int CeedBasisApply_Ref(CeedBasis basis, CeedInt nelem,
     CeedInt P1d, Q1d;
     ierr = CeedBasisGetNumNodes1D(basis, &P1d); CeedChk(ierr);
     ierr = CeedBasisGetNumQuadraturePoints1D(basis, &Q1d); CeedChk(ierr);
+    CeedBasis_Ref *impl;
+    ierr = CeedBasisGetData(basis, &impl); CeedChk(ierr);
+    // Scratch for up to three intermediate results, each large enough for
+    //   any pass and starting on a CEED_ALIGN boundary
+    CeedScalar *scratch = NULL, *tmp[3];
+    if (!impl->collointerp &&
+        (emode == CEED_EVAL_INTERP || emode == CEED_EVAL_GRAD)) {
+      const CeedInt align = CEED_ALIGN / sizeof(CeedScalar);
+      CeedInt tmpsize = nelem*ncomp*CeedIntPow(P1d>Q1d?P1d:Q1d, dim);
+      tmpsize = ((tmpsize + align - 1) / align) * align;
+      ierr = CeedBasisGetScratch_Ref(impl, 3*tmpsize, &scratch); CeedChk(ierr);
+      for (CeedInt i=0; i<3; i++)
+        tmp[i] = scratch + i*tmpsize;
+    }
     switch (emode) {
     // Interpolate to/from quadrature points
     case CEED_EVAL_INTERP: {
-      CeedBasis_Ref *impl;
-      ierr = CeedBasisGetData(basis, &impl); CeedChk(ierr);
       if (impl->collointerp) {
         memcpy(v, u, nelem*ncomp*nnodes*sizeof(u[0]));
       } else {
@@ -71,15 +128,15 @@ static int CeedBasisApply_Ref(CeedBasis basis, CeedInt nelem,
           P = Q1d; Q = P1d;
         }
         CeedInt pre = ncomp*CeedIntPow(P, dim-1), post = nelem;
-        CeedScalar tmp[2][nelem*ncomp*Q*CeedIntPow(P>Q?P:Q, dim-1)];
         const CeedScalar *interp1d;
-        ierr = CeedBasisGetInterp1D(basis, &interp1d); CeedChk(ierr);
+        ierr = CeedBasisGetInterp1D(basis, &interp1d);
+        if (ierr) goto cleanup;
         for (CeedInt d=0; d<dim; d++) {
           ierr = CeedTensorContractApply(contract, pre, P, post, Q,
                                          interp1d, tmode, add&&(d==dim-1),
                                          d==0?u:tmp[d%2],
                                          d==dim-1?v:tmp[(d+1)%2]);
-          CeedChk(ierr);
+          if (ierr) goto cleanup;
           pre /= P;
           post *= Q;
         }
@@ -95,14 +152,12 @@ static int CeedBasisApply_Ref(CeedBasis basis, CeedInt nelem,
       if (tmode == CEED_TRANSPOSE) {
         P = Q1d, Q = Q1d;
       }
-      CeedBasis_Ref *impl;
-      ierr = CeedBasisGetData(basis, &impl); CeedChk(ierr);
       CeedInt pre = ncomp*CeedIntPow(P, dim-1), post = nelem;
       const CeedScalar *interp1d;
-      ierr = CeedBasisGetInterp1D(basis, &interp1d); CeedChk(ierr);
+      ierr = CeedBasisGetInterp1D(basis, &interp1d);
+      if (ierr) goto cleanup;
       if (impl->collograd1d) {
-        CeedScalar tmp[2][nelem*ncomp*Q*CeedIntPow(P>Q?P:Q, dim-1)];
-        CeedScalar interp[nelem*ncomp*Q*CeedIntPow(P>Q?P:Q, dim-1)];
+        CeedScalar *interp = tmp[2];
         // Interpolate to quadrature points (NoTranspose)
         //  or Grad to quadrature points (Transpose)
         for (CeedInt d=0; d<dim; d++) {
@@ -117,7 +172,7 @@ static int CeedBasisApply_Ref(CeedBasis basis, CeedInt nelem,
                                          (tmode == CEED_NOTRANSPOSE
                                           ? (d==dim-1?interp:tmp[(d+1)%2])
                                           : interp));
-          CeedChk(ierr);
+          if (ierr) goto cleanup;
           pre /= P;
           post *= Q;
         }
@@ -140,13 +195,14 @@ static int CeedBasisApply_Ref(CeedBasis basis, CeedInt nelem,
                                          (tmode == CEED_NOTRANSPOSE
                                           ? v + d*nqpt*ncomp*nelem
                                           : (d==dim-1?v:tmp[(d+1)%2])));
-          CeedChk(ierr);
+          if (ierr) goto cleanup;
           pre /= P;
           post *= Q;
         }
       } else if (impl->collointerp) { // Qpts collocated with nodes
         const CeedScalar *grad1d;
-        ierr = CeedBasisGetGrad1D(basis, &grad1d); CeedChk(ierr);
+        ierr = CeedBasisGetGrad1D(basis, &grad1d);
+        if (ierr) goto cleanup;
 
         // Dim contractions, identity in other directions
         CeedInt pre = ncomp*CeedIntPow(P, dim-1), post = nelem;
@@ -157,18 +213,18 @@ static int CeedBasisApply_Ref(CeedBasis basis, CeedInt nelem,
                                          ? u : u+d*ncomp*nqpt*nelem,
                                          tmode == CEED_TRANSPOSE
                                          ? v : v+d*ncomp*nqpt*nelem);
-          CeedChk(ierr);
+          if (ierr) goto cleanup;
           pre /= P;
           post *= Q;
         }
       } else { // Underintegration, P > Q
         const CeedScalar *grad1d;
-        ierr = CeedBasisGetGrad1D(basis, &grad1d); CeedChk(ierr);
+        ierr = CeedBasisGetGrad1D(basis, &grad1d);
+        if (ierr) goto cleanup;
 
         if (tmode == CEED_TRANSPOSE) {
           P = Q1d, Q = P1d;
         }
-        CeedScalar tmp[2][nelem*ncomp*Q*CeedIntPow(P>Q?P:Q, dim-1)];
 
         // Dim**2 contractions, apply grad when pass == dim
         for (CeedInt p=0; p<dim; p++) {
@@ -185,7 +241,7 @@ static int CeedBasisApply_Ref(CeedBasis basis, CeedInt nelem,
                                             ? (tmode == CEED_TRANSPOSE
                                                ? v : v+p*ncomp*nqpt*nelem)
                                             : tmp[(d+1)%2]));
-            CeedChk(ierr);
+            if (ierr) goto cleanup;
             pre /= P;
             post *= Q;
           }
@@ -227,6 +283,13 @@ static int CeedBasisApply_Ref(CeedBasis basis, CeedInt nelem,
                        "CEED_EVAL_NONE does not make sense in this context");
       // LCOV_EXCL_STOP
     }
+    // Release the scratch, and its lock, before reporting an error
+cleanup:
+    if (scratch) {
+      int ierrscratch = CeedBasisRestoreScratch_Ref(impl, &scratch);
+      if (!ierr) ierr = ierrscratch;
+    }
+    CeedChk(ierr);
   } else {
     // Non-tensor basis
     switch (emode) {
@@ -300,6 +363,62 @@ static int CeedBasisApply_Ref(CeedBasis basis, CeedInt nelem,
   return 0;
 }
 
+//------------------------------------------------------------------------------
+// Basis Apply Interpolation and Gradient
+//   Evaluate a field at quadrature points and its gradient together. For a
+//   tensor basis with collocated gradient, or with quadrature points collocated
+//   with the nodes, the gradient is the derivative matrix applied to the
+//   interpolated values in each direction, so the interpolation passes are
+//   shared. Other bases fall back to two separate applications.
+//------------------------------------------------------------------------------
+int CeedBasisApplyInterpGrad_Ref(CeedBasis basis, CeedInt nelem, CeedVector U,
+                                 CeedVector Vinterp, CeedVector Vgrad) {
+  int ierr;
+  bool tensorbasis;
+  ierr = CeedBasisIsTensor(basis, &tensorbasis); CeedChk(ierr);
+  CeedBasis_Ref *impl = NULL;
+  if (tensorbasis) {
+    ierr = CeedBasisGetData(basis, &impl); CeedChk(ierr);
+  }
+  ierr = CeedBasisApply(basis, nelem, CEED_NOTRANSPOSE, CEED_EVAL_INTERP, U,
+                        Vinterp); CeedChk(ierr);
+  if (!impl || (!impl->collograd1d && !impl->collointerp)) {
+    ierr = CeedBasisApply(basis, nelem, CEED_NOTRANSPOSE, CEED_EVAL_GRAD, U,
+                          Vgrad); CeedChk(ierr);
+    return 0;
+  }
+
+  CeedInt dim, ncomp, nqpt, Q1d;
+  ierr = CeedBasisGetDimension(basis, &dim); CeedChk(ierr);
+  ierr = CeedBasisGetNumComponents(basis, &ncomp); CeedChk(ierr);
+  ierr = CeedBasisGetNumQuadraturePoints(basis, &nqpt); CeedChk(ierr);
+  ierr = CeedBasisGetNumQuadraturePoints1D(basis, &Q1d); CeedChk(ierr);
+  const CeedScalar *grad1d;
+  ierr = CeedBasisGetGrad1D(basis, &grad1d); CeedChk(ierr);
+  const CeedScalar *D = impl->collograd1d ? impl->collograd1d : grad1d;
+  CeedTensorContract contract;
+  ierr = CeedBasisGetTensorContract(basis, &contract); CeedChk(ierr);
+  const CeedScalar *interp;
+  CeedScalar *grad;
+  ierr = CeedVectorGetArrayRead(Vinterp, CEED_MEM_HOST, &interp);
+  CeedChk(ierr);
+  ierr = CeedVectorGetArray(Vgrad, CEED_MEM_HOST, &grad); CeedChk(ierr);
+
+  // One contraction per direction, identity in the others
+  CeedInt pre = ncomp*CeedIntPow(Q1d, dim-1), post = nelem;
+  for (CeedInt d=0; d<dim; d++) {
+    ierr = CeedTensorContractApply(contract, pre, Q1d, post, Q1d, D,
+                                   CEED_NOTRANSPOSE, false, interp,
+                                   grad + d*nqpt*ncomp*nelem); CeedChk(ierr);
+    pre /= Q1d;
+    post *= Q1d;
+  }
+
+  ierr = CeedVectorRestoreArrayRead(Vinterp, &interp); CeedChk(ierr);
+  ierr = CeedVectorRestoreArray(Vgrad, &grad); CeedChk(ierr);
+  return 0;
+}
+
 //------------------------------------------------------------------------------
 // Basis Destroy Non-Tensor
 //------------------------------------------------------------------------------
@@ -351,6 +470,8 @@ static int CeedBasisDestroyTensor_Ref(CeedBasis basis) {
   CeedBasis_Ref *impl;
   ierr = CeedBasisGetData(basis, &impl); CeedChk(ierr);
   ierr = CeedFree(&impl->collograd1d); CeedChk(ierr);
+  ierr = CeedFree(&impl->scratch); CeedChk(ierr);
+  pthread_mutex_destroy(&impl->scratchlock);
   ierr = CeedFree(&impl); CeedChk(ierr);
 
   return 0;
@@ -374,10 +495,12 @@ int CeedBasisCreateTensorH1_Ref(CeedInt dim, CeedInt P1d,
   if (Q1d == P1d) {
     bool collocated = 1;
     for (CeedInt i=0; i<P1d; i++) {
-      collocated = collocated && (fabs(interp1d[i+P1d*i] - 1.0) < 1e-14);
+      collocated = collocated &&
+                   (fabs(interp1d[i+P1d*i] - 1.0) < 100*CEED_EPSILON);
       for (CeedInt j=0; j<P1d; j++)
         if (j != i)
-          collocated = collocated && (fabs(interp1d[j+P1d*i]) < 1e-14);
+          collocated = collocated &&
+                       (fabs(interp1d[j+P1d*i]) < 100*CEED_EPSILON);
     }
     impl->collointerp = collocated;
   }
@@ -386,6 +509,7 @@ int CeedBasisCreateTensorH1_Ref(CeedInt dim, CeedInt P1d,
     ierr = CeedMalloc(Q1d*Q1d, &impl->collograd1d); CeedChk(ierr);
     ierr = CeedBasisGetCollocatedGrad(basis, impl->collograd1d); CeedChk(ierr);
   }
+  pthread_mutex_init(&impl->scratchlock, NULL);
   ierr = CeedBasisSetData(basis, impl); CeedChk(ierr);
 
   Ceed parent;
@@ -16,6 +16,154 @@
 
 #include "ceed-ref.h"
 
+//------------------------------------------------------------------------------
+// Compressed Storage of Passive Fields
+//   Fields are stored in chunks of size components of len contiguous values,
+//   one element for the serial backends or one block for the blocked ones.
+//------------------------------------------------------------------------------
+int CeedStorageGetSize_Ref(CeedStorageMode storage, CeedInt size,
+                           CeedInt *csize, size_t *valsize) {
+  CeedInt n = 0;
+  while (n*n < size) n++;
+  *csize = (storage & CEED_STORAGE_SYMMETRIC) ? n*(n+1)/2 : size;
+  *valsize = (storage & CEED_STORAGE_SINGLE) ? sizeof(float) :
+             sizeof(CeedScalar);
+  return 0;
+}
+
+int CeedStorageCompress_Ref(CeedStorageMode storage, CeedInt size,
+                            CeedInt len, CeedInt nchunks,
+                            const CeedScalar *full, void *compressed) {
+  int ierr;
+  const bool symmetric = storage & CEED_STORAGE_SYMMETRIC;
+  const bool single = storage & CEED_STORAGE_SINGLE;
+  CeedInt csize;
+  size_t valsize;
+  ierr = CeedStorageGetSize_Ref(storage, size, &csize, &valsize);
+  CeedChk(ierr);
+  // Symmetric fields are n x n, others a single row of size components
+  CeedInt n = 1;
+  while (symmetric && n*n < size) n++;
+  const CeedInt nrows = symmetric ? n : 1, ncols = symmetric ? n : size;
+
+  for (CeedInt chunk=0; chunk<nchunks; chunk++) {
+    const CeedScalar *u = &full[chunk*size*len];
+    CeedInt p = 0;
+    for (CeedInt r=0; r<nrows; r++)
+      for (CeedInt c=(symmetric ? r : 0); c<ncols; c++, p++) {
+        const CeedScalar *uk = &u[(r*ncols + c)*len];
+        const CeedInt offset = (chunk*csize + p)*len;
+        if (single)
+          for (CeedInt j=0; j<len; j++)
+            ((float *)compressed)[offset + j] = (float)uk[j];
+        else
+          memcpy(&((CeedScalar *)compressed)[offset], uk,
+                 len*sizeof(CeedScalar));
+      }
+  }
+  return 0;
+}
+
+int CeedStorageExpand_Ref(CeedStorageMode storage, CeedInt size, CeedInt len,
+                          CeedInt chunk, const void *compressed,
+                          CeedScalar *full) {
+  int ierr;
+  const bool symmetric = storage & CEED_STORAGE_SYMMETRIC;
+  const bool single = storage & CEED_STORAGE_SINGLE;
+  CeedInt csize;
+  size_t valsize;
+  ierr = CeedStorageGetSize_Ref(storage, size, &csize, &valsize);
+  CeedChk(ierr);
+  CeedInt n = 1;
+  while (symmetric && n*n < size) n++;
+  const CeedInt nrows = symmetric ? n : 1, ncols = symmetric ? n : size;
+
+  CeedInt p = 0;
+  for (CeedInt r=0; r<nrows; r++)
+    for (CeedInt c=(symmetric ? r : 0); c<ncols; c++, p++) {
+      CeedScalar *uk = &full[(r*ncols + c)*len];
+      const CeedInt offset = (chunk*csize + p)*len;
+      if (single) {
+        const float *v = &((const float *)compressed)[offset];
+        CeedPragmaSIMD
+        for (CeedInt j=0; j<len; j++)
+          uk[j] = v[j];
+      } else {
+        memcpy(uk, &((const CeedScalar *)compressed)[offset],
+               len*sizeof(CeedScalar));
+      }
+      // Mirror the lower triangle
+      if (symmetric && r != c)
+        memcpy(&full[(c*ncols + r)*len], uk, len*sizeof(CeedScalar));
+    }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Fused Input Fields
+//   An input with CEED_EVAL_INTERP and one with CEED_EVAL_GRAD that share the
+//   restriction, basis, and vector are restricted once and evaluated together
+//   by the first of the two. fused[i] is the other input of the pair, so
+//   fused[i] > i for the first and fused[i] < i for the second, or -1.
+//------------------------------------------------------------------------------
+int CeedOperatorGetFusedInputs_Ref(CeedOperator op, CeedInt *fused) {
+  int ierr;
+  CeedQFunction qf;
+  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
+  CeedInt numinputfields;
+  ierr = CeedQFunctionGetNumArgs(qf, &numinputfields, NULL); CeedChk(ierr);
+  CeedOperatorField *opinputfields;
+  ierr = CeedOperatorGetFields(op, &opinputfields, NULL); CeedChk(ierr);
+  CeedQFunctionField *qfinputfields;
+  ierr = CeedQFunctionGetFields(qf, &qfinputfields, NULL); CeedChk(ierr);
+
+  for (CeedInt i=0; i<numinputfields; i++)
+    fused[i] = -1;
+  for (CeedInt i=0; i<numinputfields; i++) {
+    CeedEvalMode emodei;
+    CeedStorageMode storagei;
+    ierr = CeedQFunctionFieldGetEvalMode(qfinputfields[i], &emodei);
+    CeedChk(ierr);
+    ierr = CeedOperatorFieldGetStorage(opinputfields[i], &storagei);
+    CeedChk(ierr);
+    if (fused[i] >= 0 || storagei != CEED_STORAGE_FULL ||
+        (emodei != CEED_EVAL_INTERP && emodei != CEED_EVAL_GRAD))
+      continue;
+    CeedElemRestriction rstri;
+    CeedBasis basisi;
+    CeedVector veci;
+    ierr = CeedOperatorFieldGetElemRestriction(opinputfields[i], &rstri);
+    CeedChk(ierr);
+    ierr = CeedOperatorFieldGetBasis(opinputfields[i], &basisi); CeedChk(ierr);
+    ierr = CeedOperatorFieldGetVector(opinputfields[i], &veci); CeedChk(ierr);
+    for (CeedInt j=i+1; j<numinputfields; j++) {
+      CeedEvalMode emodej;
+      CeedStorageMode storagej;
+      CeedElemRestriction rstrj;
+      CeedBasis basisj;
+      CeedVector vecj;
+      ierr = CeedQFunctionFieldGetEvalMode(qfinputfields[j], &emodej);
+      CeedChk(ierr);
+      ierr = CeedOperatorFieldGetStorage(opinputfields[j], &storagej);
+      CeedChk(ierr);
+      ierr = CeedOperatorFieldGetElemRestriction(opinputfields[j], &rstrj);
+      CeedChk(ierr);
+      ierr = CeedOperatorFieldGetBasis(opinputfields[j], &basisj);
+      CeedChk(ierr);
+      ierr = CeedOperatorFieldGetVector(opinputfields[j], &vecj); CeedChk(ierr);
+      if (fused[j] < 0 && storagej == CEED_STORAGE_FULL &&
+          emodej == (emodei == CEED_EVAL_INTERP ? CEED_EVAL_GRAD :
+                     CEED_EVAL_INTERP) &&
+          rstrj == rstri && basisj == basisi && vecj == veci) {
+        fused[i] = j;
+        fused[j] = i;
+        break;
+      }
+    }
+  }
+  return 0;
+}
+
 //------------------------------------------------------------------------------
 // Setup Input/Output Fields
 //------------------------------------------------------------------------------
@@ -121,13 +269,18 @@ static int CeedOperatorSetup_Ref(CeedOperator op) {
   CeedChk(ierr);
 
   ierr = CeedCalloc(16, &impl->inputstate); CeedChk(ierr);
+  ierr = CeedCalloc(16, &impl->cdata); CeedChk(ierr);
   ierr = CeedCalloc(16, &impl->evecsin); CeedChk(ierr);
   ierr = CeedCalloc(16, &impl->evecsout); CeedChk(ierr);
   ierr = CeedCalloc(16, &impl->qvecsin); CeedChk(ierr);
   ierr = CeedCalloc(16, &impl->qvecsout); CeedChk(ierr);
+  ierr = CeedCalloc(16, &impl->fusedin); CeedChk(ierr);
 
   impl->numein = numinputfields; impl->numeout = numoutputfields;
 
+  // Inputs evaluated together
+  ierr = CeedOperatorGetFusedInputs_Ref(op, impl->fusedin); CeedChk(ierr);
+
   // Set up infield and outfield evecs and qvecs
   // Infields
   ierr = CeedOperatorSetupFields_Ref(qf, op, 0, impl->evecs,
@@ -140,6 +293,23 @@ static int CeedOperatorSetup_Ref(CeedOperator op) {
                                      numinputfields, numoutputfields, Q);
   CeedChk(ierr);
 
+  // Compressed storage of passive inputs
+  for (CeedInt i=0; i<numinputfields; i++) {
+    CeedStorageMode storage;
+    ierr = CeedOperatorFieldGetStorage(opinputfields[i], &storage);
+    CeedChk(ierr);
+    if (storage != CEED_STORAGE_FULL) {
+      CeedInt numelements, size, csize;
+      size_t valsize;
+      ierr = CeedOperatorGetNumElements(op, &numelements); CeedChk(ierr);
+      ierr = CeedQFunctionFieldGetSize(qfinputfields[i], &size); CeedChk(ierr);
+      ierr = CeedStorageGetSize_Ref(storage, size, &csize, &valsize);
+      CeedChk(ierr);
+      ierr = CeedMallocArray(numelements*Q*csize, valsize, &impl->cdata[i]);
+      CeedChk(ierr);
+    }
+  }
+
   // Identity QFunctions
   if (impl->identityqf) {
     CeedEvalMode inmode, outmode;
@@ -174,12 +344,17 @@ static inline int CeedOperatorSetupInputs_Ref(CeedInt numinputfields,
   CeedEvalMode emode;
   CeedVector vec;
   CeedElemRestriction Erestrict;
+  CeedStorageMode storage;
   uint64_t state;
 
   for (CeedInt i=0; i<numinputfields; i++) {
+    // Skip input restricted with the one it is fused with
+    if (impl->fusedin[i] >= 0 && impl->fusedin[i] < i)
+      continue;
     // Get input vector
     ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
-    if (vec == CEED_VECTOR_ACTIVE) {
+    const bool isactive = vec == CEED_VECTOR_ACTIVE;
+    if (isactive) {
       if (skipactive)
         continue;
       else
@@ -188,6 +363,8 @@ static inline int CeedOperatorSetupInputs_Ref(CeedInt numinputfields,
 
     ierr = CeedQFunctionFieldGetEvalMode(qfinputfields[i], &emode);
     CeedChk(ierr);
+    ierr = CeedOperatorFieldGetStorage(opinputfields[i], &storage);
+    CeedChk(ierr);
     // Restrict and Evec
     if (emode == CEED_EVAL_WEIGHT) { // Skip
     } else {
@@ -197,10 +374,38 @@ static inline int CeedOperatorSetupInputs_Ref(CeedInt numinputfields,
       if (state != impl->inputstate[i] || vec == invec) {
         ierr = CeedOperatorFieldGetElemRestriction(opinputfields[i], &Erestrict);
         CeedChk(ierr);
+        if (!impl->evecs[i]) {
+          ierr = CeedElemRestrictionCreateVector(Erestrict, NULL,
+                                                 &impl->evecs[i]);
+          CeedChk(ierr);
+        }
+        // Active Evec is borrowed from the Ceed workspace pool
+        if (isactive) {
+          ierr = CeedVectorGetWorkArray_Ref(impl->evecs[i]); CeedChk(ierr);
+        }
         ierr = CeedElemRestrictionApply(Erestrict, CEED_NOTRANSPOSE, vec,
                                         impl->evecs[i], request); CeedChk(ierr);
         impl->inputstate[i] = state;
+        // Compress, keeping only the compressed copy of the Evec
+        if (storage != CEED_STORAGE_FULL) {
+          CeedInt numelements, Q, size;
+          const CeedScalar *e;
+          ierr = CeedElemRestrictionGetNumElements(Erestrict, &numelements);
+          CeedChk(ierr);
+          ierr = CeedElemRestrictionGetElementSize(Erestrict, &Q);
+          CeedChk(ierr);
+          ierr = CeedQFunctionFieldGetSize(qfinputfields[i], &size);
+          CeedChk(ierr);
+          ierr = CeedVectorGetArrayRead(impl->evecs[i], CEED_MEM_HOST, &e);
+          CeedChk(ierr);
+          ierr = CeedStorageCompress_Ref(storage, size, Q, numelements, e,
+                                         impl->cdata[i]); CeedChk(ierr);
+          ierr = CeedVectorRestoreArrayRead(impl->evecs[i], &e); CeedChk(ierr);
+          ierr = CeedVectorDestroy(&impl->evecs[i]); CeedChk(ierr);
+        }
       }
+      if (storage != CEED_STORAGE_FULL)
+        continue;
       // Get evec
       ierr = CeedVectorGetArrayRead(impl->evecs[i], CEED_MEM_HOST,
                                     (const CeedScalar **) &impl->edata[i]);
@@ -223,6 +428,10 @@ static inline int CeedOperatorInputBasis_Ref(CeedInt e, CeedInt Q,
   CeedBasis basis;
 
   for (CeedInt i=0; i<numinputfields; i++) {
+    const CeedInt fused = impl->fusedin[i];
+    // Skip input evaluated with the one it is fused with
+    if (fused >= 0 && fused < i)
+      continue;
     // Skip active input
     if (skipactive) {
       CeedVector vec;
@@ -241,9 +450,22 @@ static inline int CeedOperatorInputBasis_Ref(CeedInt e, CeedInt Q,
     // Basis action
     switch(emode) {
     case CEED_EVAL_NONE:
-      ierr = CeedVectorSetArray(impl->qvecsin[i], CEED_MEM_HOST,
-                                CEED_USE_POINTER,
-                                &impl->edata[i][e*Q*size]); CeedChk(ierr);
+      if (impl->cdata[i]) {
+        // Expand compressed storage
+        CeedStorageMode storage;
+        CeedScalar *q;
+        ierr = CeedOperatorFieldGetStorage(opinputfields[i], &storage);
+        CeedChk(ierr);
+        ierr = CeedVectorGetArray(impl->qvecsin[i], CEED_MEM_HOST, &q);
+        CeedChk(ierr);
+        ierr = CeedStorageExpand_Ref(storage, size, Q, e, impl->cdata[i], q);
+        CeedChk(ierr);
+        ierr = CeedVectorRestoreArray(impl->qvecsin[i], &q); CeedChk(ierr);
+      } else {
+        ierr = CeedVectorSetArray(impl->qvecsin[i], CEED_MEM_HOST,
+                                  CEED_USE_POINTER,
+                                  &impl->edata[i][e*Q*size]); CeedChk(ierr);
+      }
       break;
     case CEED_EVAL_INTERP:
       ierr = CeedOperatorFieldGetBasis(opinputfields[i], &basis); CeedChk(ierr);
@@ -251,9 +473,16 @@ static inline int CeedOperatorInputBasis_Ref(CeedInt e, CeedInt Q,
                                 CEED_USE_POINTER,
                                 &impl->edata[i][e*elemsize*size]);
       CeedChk(ierr);
-      ierr = CeedBasisApply(basis, 1, CEED_NOTRANSPOSE,
-                            CEED_EVAL_INTERP, impl->evecsin[i],
-                            impl->qvecsin[i]); CeedChk(ierr);
+      if (fused >= 0) {
+        ierr = CeedBasisApplyInterpGrad_Ref(basis, 1, impl->evecsin[i],
+                                            impl->qvecsin[i],
+                                            impl->qvecsin[fused]);
+        CeedChk(ierr);
+      } else {
+        ierr = CeedBasisApply(basis, 1, CEED_NOTRANSPOSE,
+                              CEED_EVAL_INTERP, impl->evecsin[i],
+                              impl->qvecsin[i]); CeedChk(ierr);
+      }
       break;
     case CEED_EVAL_GRAD:
       ierr = CeedOperatorFieldGetBasis(opinputfields[i], &basis); CeedChk(ierr);
@@ -262,9 +491,16 @@ static inline int CeedOperatorInputBasis_Ref(CeedInt e, CeedInt Q,
                                 CEED_USE_POINTER,
                                 &impl->edata[i][e*elemsize*size/dim]);
       CeedChk(ierr);
-      ierr = CeedBasisApply(basis, 1, CEED_NOTRANSPOSE,
-                            CEED_EVAL_GRAD, impl->evecsin[i],
-                            impl->qvecsin[i]); CeedChk(ierr);
+      if (fused >= 0) {
+        ierr = CeedBasisApplyInterpGrad_Ref(basis, 1, impl->evecsin[i],
+                                            impl->qvecsin[fused],
+                                            impl->qvecsin[i]);
+        CeedChk(ierr);
+      } else {
+        ierr = CeedBasisApply(basis, 1, CEED_NOTRANSPOSE,
+                              CEED_EVAL_GRAD, impl->evecsin[i],
+                              impl->qvecsin[i]); CeedChk(ierr);
+      }
       break;
     case CEED_EVAL_WEIGHT:
       break;  // No action
@@ -362,20 +598,25 @@ static inline int CeedOperatorRestoreInputs_Ref(CeedInt numinputfields,
 
   for (CeedInt i=0; i<numinputfields; i++) {
     // Skip active inputs
-    if (skipactive) {
-      CeedVector vec;
-      ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
-      if (vec == CEED_VECTOR_ACTIVE)
-        continue;
-    }
+    CeedVector vec;
+    ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
+    if (skipactive && vec == CEED_VECTOR_ACTIVE)
+      continue;
+    // Skip input restricted with the one it is fused with
+    if (impl->fusedin[i] >= 0 && impl->fusedin[i] < i)
+      continue;
     // Restore input
     ierr = CeedQFunctionFieldGetEvalMode(qfinputfields[i], &emode);
     CeedChk(ierr);
-    if (emode == CEED_EVAL_WEIGHT) { // Skip
+    if (emode == CEED_EVAL_WEIGHT || impl->cdata[i]) { // Skip
     } else {
       ierr = CeedVectorRestoreArrayRead(impl->evecs[i],
                                         (const CeedScalar **) &impl->edata[i]);
       CeedChk(ierr);
+      // Return active Evec to the Ceed workspace pool
+      if (vec == CEED_VECTOR_ACTIVE) {
+        ierr = CeedVectorRestoreWorkArray_Ref(impl->evecs[i]); CeedChk(ierr);
+      }
     }
   }
   return 0;
@@ -410,17 +651,23 @@ static int CeedOperatorApplyAdd_Ref(CeedOperator op, CeedVector invec,
   ierr = CeedOperatorSetup_Ref(op); CeedChk(ierr);
 
   // Input Evecs and Restriction
+  ierr = CeedOperatorPhaseBegin(op, CEED_PHASE_RESTRICTION); CeedChk(ierr);
   ierr = CeedOperatorSetupInputs_Ref(numinputfields, qfinputfields,
                                      opinputfields, invec, false, impl,
                                      request); CeedChk(ierr);
+  ierr = CeedOperatorPhaseEnd(op, CEED_PHASE_RESTRICTION); CeedChk(ierr);
 
-  // Output Evecs
+  // Output Evecs, borrowed from the Ceed workspace pool
   for (CeedInt i=0; i<numoutputfields; i++) {
+    ierr = CeedVectorGetWorkArray_Ref(impl->evecs[i+impl->numein]);
+    CeedChk(ierr);
     ierr = CeedVectorGetArray(impl->evecs[i+impl->numein], CEED_MEM_HOST,
                               &impl->edata[i + numinputfields]); CeedChk(ierr);
   }
 
-  // Loop through elements
+  // Loop through elements, timing phases only when profiling
+  bool profile;
+  ierr = CeedOperatorIsProfiling(op, &profile); CeedChk(ierr);
   for (CeedInt e=0; e<numelements; e++) {
     // Output pointers
     for (CeedInt i=0; i<numoutputfields; i++) {
@@ -437,23 +684,42 @@ static int CeedOperatorApplyAdd_Ref(CeedOperator op, CeedVector invec,
     }
 
     // Input basis apply
+    if (profile) {
+      ierr = CeedOperatorPhaseBegin(op, CEED_PHASE_BASIS); CeedChk(ierr);
+    }
     ierr = CeedOperatorInputBasis_Ref(e, Q, qfinputfields, opinputfields,
                                       numinputfields, false, impl);
     CeedChk(ierr);
+    if (profile) {
+      ierr = CeedOperatorPhaseEnd(op, CEED_PHASE_BASIS); CeedChk(ierr);
+    }
 
     // Q function
     if (!impl->identityqf) {
+      if (profile) {
+        ierr = CeedOperatorPhaseBegin(op, CEED_PHASE_QFUNCTION); CeedChk(ierr);
+      }
       ierr = CeedQFunctionApply(qf, Q, impl->qvecsin, impl->qvecsout);
       CeedChk(ierr);
+      if (profile) {
+        ierr = CeedOperatorPhaseEnd(op, CEED_PHASE_QFUNCTION); CeedChk(ierr);
+      }
     }
 
     // Output basis apply
+    if (profile) {
+      ierr = CeedOperatorPhaseBegin(op, CEED_PHASE_BASIS); CeedChk(ierr);
+    }
     ierr = CeedOperatorOutputBasis_Ref(e, Q, qfoutputfields, opoutputfields,
                                        numinputfields, numoutputfields, op, impl);
     CeedChk(ierr);
+    if (profile) {
+      ierr = CeedOperatorPhaseEnd(op, CEED_PHASE_BASIS); CeedChk(ierr);
+    }
   }
 
   // Output restriction
+  ierr = CeedOperatorPhaseBegin(op, CEED_PHASE_RESTRICTION); CeedChk(ierr);
   for (CeedInt i=0; i<numoutputfields; i++) {
     // Restore evec
     ierr = CeedVectorRestoreArray(impl->evecs[i+impl->numein],
@@ -470,7 +736,10 @@ static int CeedOperatorApplyAdd_Ref(CeedOperator op, CeedVector invec,
     ierr = CeedElemRestrictionApply(Erestrict, CEED_TRANSPOSE,
                                     impl->evecs[i+impl->numein], vec, request);
     CeedChk(ierr);
+    ierr = CeedVectorRestoreWorkArray_Ref(impl->evecs[i+impl->numein]);
+    CeedChk(ierr);
   }
+  ierr = CeedOperatorPhaseEnd(op, CEED_PHASE_RESTRICTION); CeedChk(ierr);
 
   // Restore input arrays
   ierr = CeedOperatorRestoreInputs_Ref(numinputfields, qfinputfields,
@@ -667,7 +936,7 @@ static inline void CeedOperatorGetBasisPointer_Ref(const CeedScalar **basisptr,
 //------------------------------------------------------------------------------
 // Create point block restriction
 //------------------------------------------------------------------------------
-static int CreatePBRestriction_Ref(CeedElemRestriction rstr,
+static int CreatePBRestriction_Ref(CeedElemRestriction rstr, CeedInt blksize,
                                    CeedElemRestriction *pbRstr) {
   int ierr;
   Ceed ceed;
@@ -693,10 +962,18 @@ static int CreatePBRestriction_Ref(CeedElemRestriction rstr,
   }
 
   // Create new restriction
-  ierr = CeedElemRestrictionCreate(ceed, nelem, elemsize, ncomp*ncomp, 1,
-                                   max + ncomp*ncomp, CEED_MEM_HOST,
-                                   CEED_OWN_POINTER, pbOffsets, pbRstr);
-  CeedChk(ierr);
+  if (blksize == 1) {
+    ierr = CeedElemRestrictionCreate(ceed, nelem, elemsize, ncomp*ncomp, 1,
+                                     max + ncomp*ncomp, CEED_MEM_HOST,
+                                     CEED_OWN_POINTER, pbOffsets, pbRstr);
+    CeedChk(ierr);
+  } else {
+    ierr = CeedElemRestrictionCreateBlocked(ceed, nelem, elemsize, blksize,
+                                            ncomp*ncomp, 1, max + ncomp*ncomp,
+                                            CEED_MEM_HOST, CEED_COPY_VALUES,
+                                            pbOffsets, pbRstr); CeedChk(ierr);
+    ierr = CeedFree(&pbOffsets); CeedChk(ierr);
+  }
 
   // Cleanup
   ierr = CeedElemRestrictionRestoreOffsets(rstr, &offsets); CeedChk(ierr);
@@ -705,25 +982,61 @@ static int CreatePBRestriction_Ref(CeedElemRestriction rstr,
 }
 
 //------------------------------------------------------------------------------
-// Assemble diagonal common code
+// Create blocked restriction
 //------------------------------------------------------------------------------
-static inline int CeedOperatorAssembleAddDiagonalCore_Ref(CeedOperator op,
-    CeedVector assembled, CeedRequest *request, const bool pointBlock) {
+static int CreateBlockedRestriction_Ref(CeedElemRestriction rstr,
+                                        CeedInt blksize,
+                                        CeedElemRestriction *blkRstr) {
   int ierr;
   Ceed ceed;
-  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetCeed(rstr, &ceed); CeedChk(ierr);
+  CeedInt nelem, elemsize, lsize, ncomp, compstride;
+  ierr = CeedElemRestrictionGetNumElements(rstr, &nelem); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetElementSize(rstr, &elemsize); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetLVectorSize(rstr, &lsize); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumComponents(rstr, &ncomp); CeedChk(ierr);
 
-  // Assemble QFunction
+  bool strided;
+  ierr = CeedElemRestrictionIsStrided(rstr, &strided); CeedChk(ierr);
+  if (strided) {
+    CeedInt strides[3];
+    ierr = CeedElemRestrictionGetStrides(rstr, &strides); CeedChk(ierr);
+    ierr = CeedElemRestrictionCreateBlockedStrided(ceed, nelem, elemsize,
+           blksize, ncomp, lsize, strides, blkRstr); CeedChk(ierr);
+  } else {
+    const CeedInt *offsets;
+    ierr = CeedElemRestrictionGetOffsets(rstr, CEED_MEM_HOST, &offsets);
+    CeedChk(ierr);
+    ierr = CeedElemRestrictionGetCompStride(rstr, &compstride); CeedChk(ierr);
+    ierr = CeedElemRestrictionCreateBlocked(ceed, nelem, elemsize, blksize,
+                                            ncomp, compstride, lsize,
+                                            CEED_MEM_HOST, CEED_COPY_VALUES,
+                                            offsets, blkRstr); CeedChk(ierr);
+    ierr = CeedElemRestrictionRestoreOffsets(rstr, &offsets); CeedChk(ierr);
+  }
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Assemble diagonal from a blocked assembled QFunction
+//   The assembled QFunction has the layout of the E-vector of a blocked
+//   strided restriction with numactivein*numactiveout components, so the
+//   element-major layout of CeedOperatorLinearAssembleQFunction() is the case
+//   blksize = 1. Element diagonals are accumulated in the matching blocked
+//   E-vector, so the innermost loop runs over the elements of a block.
+//------------------------------------------------------------------------------
+int CeedOperatorAssembleAddDiagonalBlocked_Ref(CeedOperator op,
+    CeedVector assembledqf, CeedInt blksize, CeedVector assembled,
+    CeedRequest *request, const bool pointBlock) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
   CeedQFunction qf;
   ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
   CeedInt numinputfields, numoutputfields;
   ierr= CeedQFunctionGetNumArgs(qf, &numinputfields, &numoutputfields);
   CeedChk(ierr);
-  CeedVector assembledqf;
-  CeedElemRestriction rstr;
-  ierr = CeedOperatorLinearAssembleQFunction(op,  &assembledqf, &rstr, request);
-  CeedChk(ierr);
-  ierr = CeedElemRestrictionDestroy(&rstr); CeedChk(ierr);
   CeedScalar maxnorm = 0;
   ierr = CeedVectorNorm(assembledqf, CEED_NORM_MAX, &maxnorm); CeedChk(ierr);
 
@@ -820,10 +1133,13 @@ static inline int CeedOperatorAssembleAddDiagonalCore_Ref(CeedOperator op,
     }
   }
 
-  // Assemble point-block diagonal restriction, if needed
+  // Assemble point-block or blocked diagonal restriction, if needed
   CeedElemRestriction diagrstr = rstrout;
   if (pointBlock) {
-    ierr = CreatePBRestriction_Ref(rstrout, &diagrstr); CeedChk(ierr);
+    ierr = CreatePBRestriction_Ref(rstrout, blksize, &diagrstr); CeedChk(ierr);
+  } else if (blksize > 1) {
+    ierr = CreateBlockedRestriction_Ref(rstrout, blksize, &diagrstr);
+    CeedChk(ierr);
   }
 
   // Create diagonal vector
@@ -840,6 +1156,7 @@ static inline int CeedOperatorAssembleAddDiagonalCore_Ref(CeedOperator op,
   CeedChk(ierr);
   CeedInt nelem, nnodes, nqpts;
   ierr = CeedElemRestrictionGetNumElements(diagrstr, &nelem); CeedChk(ierr);
+  const CeedInt nblks = nelem/blksize + !!(nelem%blksize);
   ierr = CeedBasisGetNumNodes(basisin, &nnodes); CeedChk(ierr);
   ierr = CeedBasisGetNumQuadraturePoints(basisin, &nqpts); CeedChk(ierr);
   // Basis matrices
@@ -859,12 +1176,12 @@ static inline int CeedOperatorAssembleAddDiagonalCore_Ref(CeedOperator op,
   ierr = CeedBasisGetInterp(basisout, &interpout); CeedChk(ierr);
   ierr = CeedBasisGetGrad(basisin, &gradin); CeedChk(ierr);
   ierr = CeedBasisGetGrad(basisout, &gradout); CeedChk(ierr);
-  // Compute the diagonal of B^T D B
-  // Each element
-  const CeedScalar qfvaluebound = maxnorm*1e-12;
-  for (CeedInt e=0; e<nelem; e++) {
+  // Products of basis matrix entries for each eval mode pair
+  //   bbt has shape [numemodeout, numemodein, nqpts, nnodes]
+  CeedScalar *bbt;
+  ierr = CeedMalloc(numemodeout*numemodein*nqpts*nnodes, &bbt); CeedChk(ierr);
+  {
     CeedInt dout = -1;
-    // Each basis eval mode pair
     for (CeedInt eout=0; eout<numemodeout; eout++) {
       const CeedScalar *bt = NULL;
       if (emodeout[eout] == CEED_EVAL_GRAD)
@@ -878,33 +1195,49 @@ static inline int CeedOperatorAssembleAddDiagonalCore_Ref(CeedOperator op,
           din += 1;
         CeedOperatorGetBasisPointer_Ref(&b, emodein[ein], identity, interpin,
                                         &gradin[din*nqpts*nnodes]);
+        CeedScalar *bb = &bbt[(eout*numemodein+ein)*nqpts*nnodes];
+        for (CeedInt i=0; i<nqpts*nnodes; i++)
+          bb[i] = bt[i] * b[i];
+      }
+    }
+  }
+  // Compute the diagonal of B^T D B
+  // Each element block
+  const CeedScalar qfvaluebound = maxnorm*1e-12;
+  for (CeedInt e=0; e<nblks; e++) {
+    // Each basis eval mode pair
+    for (CeedInt eout=0; eout<numemodeout; eout++)
+      for (CeedInt ein=0; ein<numemodein; ein++) {
+        const CeedScalar *bb = &bbt[(eout*numemodein+ein)*nqpts*nnodes];
         // Each component
         for (CeedInt compOut=0; compOut<ncomp; compOut++)
-          // Each qpoint/node pair
-          for (CeedInt q=0; q<nqpts; q++)
-            if (pointBlock) {
-              // Point Block Diagonal
-              for (CeedInt compIn=0; compIn<ncomp; compIn++) {
-                const CeedScalar qfvalue =
-                  assembledqfarray[((((e*numemodein+ein)*ncomp+compIn)*
-                                     numemodeout+eout)*ncomp+compOut)*nqpts+q];
-                if (fabs(qfvalue) > qfvaluebound)
-                  for (CeedInt n=0; n<nnodes; n++)
-                    elemdiagarray[((e*ncomp+compOut)*ncomp+compIn)*nnodes+n] +=
-                      bt[q*nnodes+n] * qfvalue * b[q*nnodes+n];
+          for (CeedInt compIn=0; compIn<ncomp; compIn++) {
+            if (!pointBlock && compIn != compOut)
+              continue;
+            const CeedInt qfcomp = ((e*numemodein+ein)*ncomp+compIn)*
+                                   numemodeout*ncomp + eout*ncomp+compOut;
+            const CeedInt diagcomp = pointBlock ? (e*ncomp+compOut)*ncomp+compIn
+                                     : e*ncomp+compOut;
+            const CeedScalar *qfvalues =
+              &assembledqfarray[qfcomp*nqpts*blksize];
+            CeedScalar *diag = &elemdiagarray[diagcomp*nnodes*blksize];
+            // Each qpoint/node pair, skipping negligible QFunction values
+            for (CeedInt q=0; q<nqpts; q++) {
+              CeedScalar qfvalue[blksize];
+              bool nonzero = false;
+              for (CeedInt j=0; j<blksize; j++) {
+                const CeedScalar value = qfvalues[q*blksize+j];
+                qfvalue[j] = fabs(value) > qfvaluebound ? value : 0.0;
+                nonzero = nonzero || qfvalue[j] != 0.0;
               }
-            } else {
-              // Diagonal Only
-              const CeedScalar qfvalue =
-                assembledqfarray[((((e*numemodein+ein)*ncomp+compOut)*
-                                   numemodeout+eout)*ncomp+compOut)*nqpts+q];
-              if (fabs(qfvalue) > qfvaluebound)
-                for (CeedInt n=0; n<nnodes; n++)
-                  elemdiagarray[(e*ncomp+compOut)*nnodes+n] +=
-                    bt[q*nnodes+n] * qfvalue * b[q*nnodes+n];
+              if (!nonzero)
+                continue;
+              for (CeedInt n=0; n<nnodes; n++)
+                for (CeedInt j=0; j<blksize; j++)
+                  diag[n*blksize+j] += bb[q*nnodes+n] * qfvalue[j];
             }
+          }
       }
-    }
   }
   ierr = CeedVectorRestoreArray(elemdiag, &elemdiagarray); CeedChk(ierr);
   ierr = CeedVectorRestoreArray(assembledqf, &assembledqfarray); CeedChk(ierr);
@@ -914,14 +1247,38 @@ static inline int CeedOperatorAssembleAddDiagonalCore_Ref(CeedOperator op,
                                   assembled, request); CeedChk(ierr);
 
   // Cleanup
-  if (pointBlock) {
+  if (diagrstr != rstrout) {
     ierr = CeedElemRestrictionDestroy(&diagrstr); CeedChk(ierr);
   }
-  ierr = CeedVectorDestroy(&assembledqf); CeedChk(ierr);
   ierr = CeedVectorDestroy(&elemdiag); CeedChk(ierr);
   ierr = CeedFree(&emodein); CeedChk(ierr);
   ierr = CeedFree(&emodeout); CeedChk(ierr);
   ierr = CeedFree(&identity); CeedChk(ierr);
+  ierr = CeedFree(&bbt); CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Assemble diagonal common code
+//------------------------------------------------------------------------------
+static inline int CeedOperatorAssembleAddDiagonalCore_Ref(CeedOperator op,
+    CeedVector assembled, CeedRequest *request, const bool pointBlock) {
+  int ierr;
+
+  // Assemble QFunction
+  CeedVector assembledqf;
+  CeedElemRestriction rstr;
+  ierr = CeedOperatorLinearAssembleQFunction(op,  &assembledqf, &rstr, request);
+  CeedChk(ierr);
+  ierr = CeedElemRestrictionDestroy(&rstr); CeedChk(ierr);
+
+  // Assemble diagonal
+  ierr = CeedOperatorAssembleAddDiagonalBlocked_Ref(op, assembledqf, 1,
+         assembled, request, pointBlock); CeedChk(ierr);
+
+  // Cleanup
+  ierr = CeedVectorDestroy(&assembledqf); CeedChk(ierr);
 
   return 0;
 }
@@ -938,8 +1295,13 @@ static inline int CeedOperatorLinearAssembleAddDiagonalCompositeCore_Ref(
   ierr = CeedOperatorGetNumSub(op, &numSub); CeedChk(ierr);
   ierr = CeedOperatorGetSubList(op, &subOperators); CeedChk(ierr);
   for (CeedInt i = 0; i < numSub; i++) {
-    ierr = CeedOperatorAssembleAddDiagonalCore_Ref(subOperators[i], assembled,
-           request, pointBlock); CeedChk(ierr);
+    if (pointBlock) {
+      ierr = CeedOperatorLinearAssembleAddPointBlockDiagonal(subOperators[i],
+             assembled, request); CeedChk(ierr);
+    } else {
+      ierr = CeedOperatorLinearAssembleAddDiagonal(subOperators[i], assembled,
+             request); CeedChk(ierr);
+    }
   }
   return 0;
 }
@@ -947,7 +1309,7 @@ static inline int CeedOperatorLinearAssembleAddDiagonalCompositeCore_Ref(
 //------------------------------------------------------------------------------
 // Assemble Linear Diagonal
 //------------------------------------------------------------------------------
-static int CeedOperatorLinearAssembleAddDiagonal_Ref(CeedOperator op,
+int CeedOperatorLinearAssembleAddDiagonal_Ref(CeedOperator op,
     CeedVector assembled, CeedRequest *request) {
   int ierr;
   bool isComposite;
@@ -963,7 +1325,7 @@ static int CeedOperatorLinearAssembleAddDiagonal_Ref(CeedOperator op,
 //------------------------------------------------------------------------------
 // Assemble Linear Point Block Diagonal
 //------------------------------------------------------------------------------
-static int CeedOperatorLinearAssembleAddPointBlockDiagonal_Ref(CeedOperator op,
+int CeedOperatorLinearAssembleAddPointBlockDiagonal_Ref(CeedOperator op,
     CeedVector assembled, CeedRequest *request) {
   int ierr;
   bool isComposite;
@@ -976,6 +1338,449 @@ static int CeedOperatorLinearAssembleAddPointBlockDiagonal_Ref(CeedOperator op,
   }
 }
 
+//------------------------------------------------------------------------------
+// Get Active Field Basis, Restriction, and Eval Modes
+//------------------------------------------------------------------------------
+static int CeedOperatorGetActiveField_Ref(CeedOperator op, bool isinput,
+    CeedBasis *basis, CeedElemRestriction *rstr, CeedInt *numemode,
+    CeedEvalMode **emodes) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  CeedQFunction qf;
+  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
+  CeedInt numinputfields, numoutputfields, numfields;
+  ierr = CeedQFunctionGetNumArgs(qf, &numinputfields, &numoutputfields);
+  CeedChk(ierr);
+  CeedOperatorField *opfields;
+  CeedQFunctionField *qffields;
+  if (isinput) {
+    ierr = CeedOperatorGetFields(op, &opfields, NULL); CeedChk(ierr);
+    ierr = CeedQFunctionGetFields(qf, &qffields, NULL); CeedChk(ierr);
+    numfields = numinputfields;
+  } else {
+    ierr = CeedOperatorGetFields(op, NULL, &opfields); CeedChk(ierr);
+    ierr = CeedQFunctionGetFields(qf, NULL, &qffields); CeedChk(ierr);
+    numfields = numoutputfields;
+  }
+
+  *basis = NULL;
+  *rstr = NULL;
+  *numemode = 0;
+  *emodes = NULL;
+  for (CeedInt i=0; i<numfields; i++) {
+    CeedVector vec;
+    ierr = CeedOperatorFieldGetVector(opfields[i], &vec); CeedChk(ierr);
+    if (vec == CEED_VECTOR_ACTIVE) {
+      CeedElemRestriction fieldrstr;
+      CeedInt dim;
+      ierr = CeedOperatorFieldGetBasis(opfields[i], basis); CeedChk(ierr);
+      ierr = CeedBasisGetDimension(*basis, &dim); CeedChk(ierr);
+      ierr = CeedOperatorFieldGetElemRestriction(opfields[i], &fieldrstr);
+      CeedChk(ierr);
+      if (*rstr && *rstr != fieldrstr)
+        // LCOV_EXCL_START
+        return CeedError(ceed, 1,
+                         "Multi-field non-composite operator assembly not supported");
+      // LCOV_EXCL_STOP
+      *rstr = fieldrstr;
+      CeedEvalMode emode;
+      ierr = CeedQFunctionFieldGetEvalMode(qffields[i], &emode); CeedChk(ierr);
+      switch (emode) {
+      case CEED_EVAL_NONE:
+      case CEED_EVAL_INTERP:
+        ierr = CeedRealloc(*numemode + 1, emodes); CeedChk(ierr);
+        (*emodes)[*numemode] = emode;
+        *numemode += 1;
+        break;
+      case CEED_EVAL_GRAD:
+        ierr = CeedRealloc(*numemode + dim, emodes); CeedChk(ierr);
+        for (CeedInt d=0; d<dim; d++)
+          (*emodes)[*numemode+d] = emode;
+        *numemode += dim;
+        break;
+      case CEED_EVAL_WEIGHT:
+      case CEED_EVAL_DIV:
+      case CEED_EVAL_CURL:
+        break; // Caught by QF Assembly
+      }
+    }
+  }
+  if (!*rstr)
+    // LCOV_EXCL_START
+    return CeedError(ceed, 1, "Operator assembly requires active %s field",
+                     isinput ? "input" : "output");
+  // LCOV_EXCL_STOP
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Get L-vector Indices of Element Nodes
+//   ind has shape [nelem, ncomp, elemsize]
+//------------------------------------------------------------------------------
+static int CeedOperatorGetAssemblyIndices_Ref(CeedElemRestriction rstr,
+    CeedInt *ind) {
+  int ierr;
+  CeedInt nelem, elemsize, ncomp;
+  ierr = CeedElemRestrictionGetNumElements(rstr, &nelem); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetElementSize(rstr, &elemsize); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumComponents(rstr, &ncomp); CeedChk(ierr);
+  bool isstrided;
+  ierr = CeedElemRestrictionIsStrided(rstr, &isstrided); CeedChk(ierr);
+
+  if (isstrided) {
+    CeedInt strides[3] = {1, elemsize, elemsize*ncomp}; // CEED_STRIDES_BACKEND
+    bool backendstrides;
+    ierr = CeedElemRestrictionHasBackendStrides(rstr, &backendstrides);
+    CeedChk(ierr);
+    if (!backendstrides) {
+      ierr = CeedElemRestrictionGetStrides(rstr, &strides); CeedChk(ierr);
+    }
+    for (CeedInt e=0; e<nelem; e++)
+      for (CeedInt k=0; k<ncomp; k++)
+        for (CeedInt n=0; n<elemsize; n++)
+          ind[(e*ncomp+k)*elemsize+n] = n*strides[0] + k*strides[1] +
+                                        e*strides[2];
+  } else {
+    const CeedInt *offsets;
+    CeedInt compstride;
+    ierr = CeedElemRestrictionGetCompStride(rstr, &compstride); CeedChk(ierr);
+    ierr = CeedElemRestrictionGetOffsets(rstr, CEED_MEM_HOST, &offsets);
+    CeedChk(ierr);
+    for (CeedInt e=0; e<nelem; e++)
+      for (CeedInt k=0; k<ncomp; k++)
+        for (CeedInt n=0; n<elemsize; n++)
+          ind[(e*ncomp+k)*elemsize+n] = offsets[e*elemsize+n] + k*compstride;
+    ierr = CeedElemRestrictionRestoreOffsets(rstr, &offsets); CeedChk(ierr);
+  }
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Get Number of Assembled Entries
+//------------------------------------------------------------------------------
+static int CeedOperatorGetNumAssemblyEntries_Ref(CeedOperator op,
+    CeedInt *nentries) {
+  int ierr;
+  bool isComposite;
+  ierr = CeedOperatorIsComposite(op, &isComposite); CeedChk(ierr);
+
+  *nentries = 0;
+  if (isComposite) {
+    CeedInt numSub;
+    CeedOperator *subOperators;
+    ierr = CeedOperatorGetNumSub(op, &numSub); CeedChk(ierr);
+    ierr = CeedOperatorGetSubList(op, &subOperators); CeedChk(ierr);
+    for (CeedInt i = 0; i < numSub; i++) {
+      CeedInt subentries;
+      ierr = CeedOperatorGetNumAssemblyEntries_Ref(subOperators[i],
+             &subentries); CeedChk(ierr);
+      *nentries += subentries;
+    }
+  } else {
+    CeedInt nelem, elemsizein, elemsizeout, ncompin, ncompout;
+    CeedInt numemodein, numemodeout;
+    CeedEvalMode *emodein, *emodeout;
+    CeedBasis basisin, basisout;
+    CeedElemRestriction rstrin, rstrout;
+    ierr = CeedOperatorGetActiveField_Ref(op, true, &basisin, &rstrin,
+                                          &numemodein, &emodein); CeedChk(ierr);
+    ierr = CeedOperatorGetActiveField_Ref(op, false, &basisout, &rstrout,
+                                          &numemodeout, &emodeout); CeedChk(ierr);
+    ierr = CeedElemRestrictionGetNumElements(rstrin, &nelem); CeedChk(ierr);
+    ierr = CeedElemRestrictionGetElementSize(rstrin, &elemsizein); CeedChk(ierr);
+    ierr = CeedElemRestrictionGetElementSize(rstrout, &elemsizeout);
+    CeedChk(ierr);
+    ierr = CeedElemRestrictionGetNumComponents(rstrin, &ncompin); CeedChk(ierr);
+    ierr = CeedElemRestrictionGetNumComponents(rstrout, &ncompout);
+    CeedChk(ierr);
+    *nentries = nelem*elemsizeout*ncompout*elemsizein*ncompin;
+    ierr = CeedFree(&emodein); CeedChk(ierr);
+    ierr = CeedFree(&emodeout); CeedChk(ierr);
+  }
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Assemble symbolic common code
+//------------------------------------------------------------------------------
+static int CeedOperatorAssembleSymbolicCore_Ref(CeedOperator op,
+    CeedInt *rows, CeedInt *cols) {
+  int ierr;
+  CeedInt nelem, elemsizein, elemsizeout, ncompin, ncompout;
+  CeedInt numemodein, numemodeout, *indin, *indout;
+  CeedEvalMode *emodein, *emodeout;
+  CeedBasis basisin, basisout;
+  CeedElemRestriction rstrin, rstrout;
+  ierr = CeedOperatorGetActiveField_Ref(op, true, &basisin, &rstrin,
+                                        &numemodein, &emodein); CeedChk(ierr);
+  ierr = CeedOperatorGetActiveField_Ref(op, false, &basisout, &rstrout,
+                                        &numemodeout, &emodeout); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumElements(rstrin, &nelem); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetElementSize(rstrin, &elemsizein); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetElementSize(rstrout, &elemsizeout); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumComponents(rstrin, &ncompin); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumComponents(rstrout, &ncompout); CeedChk(ierr);
+  const CeedInt sizein = elemsizein*ncompin, sizeout = elemsizeout*ncompout;
+
+  // L-vector indices of element nodes
+  ierr = CeedMalloc(nelem*sizein, &indin); CeedChk(ierr);
+  ierr = CeedOperatorGetAssemblyIndices_Ref(rstrin, indin); CeedChk(ierr);
+  if (rstrout == rstrin) {
+    indout = indin;
+  } else {
+    ierr = CeedMalloc(nelem*sizeout, &indout); CeedChk(ierr);
+    ierr = CeedOperatorGetAssemblyIndices_Ref(rstrout, indout); CeedChk(ierr);
+  }
+
+  // Dense element blocks
+  for (CeedInt e=0; e<nelem; e++)
+    for (CeedInt i=0; i<sizeout; i++)
+      for (CeedInt j=0; j<sizein; j++) {
+        const CeedInt entry = (e*sizeout + i)*sizein + j;
+        rows[entry] = indout[e*sizeout + i];
+        cols[entry] = indin[e*sizein + j];
+      }
+
+  // Cleanup
+  if (indout != indin) {
+    ierr = CeedFree(&indout); CeedChk(ierr);
+  }
+  ierr = CeedFree(&indin); CeedChk(ierr);
+  ierr = CeedFree(&emodein); CeedChk(ierr);
+  ierr = CeedFree(&emodeout); CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Assemble element matrices common code
+//   values has shape [nelem, ncompout, elemsizeout, ncompin, elemsizein]
+//------------------------------------------------------------------------------
+static int CeedOperatorAssembleElementMatricesCore_Ref(CeedOperator op,
+    CeedScalar *values) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+
+  // Assemble QFunction
+  CeedVector assembledqf;
+  CeedElemRestriction rstr;
+  ierr = CeedOperatorLinearAssembleQFunction(op,  &assembledqf, &rstr,
+         CEED_REQUEST_IMMEDIATE); CeedChk(ierr);
+  ierr = CeedElemRestrictionDestroy(&rstr); CeedChk(ierr);
+
+  // Determine active input and output bases
+  CeedInt numemodein, numemodeout;
+  CeedEvalMode *emodein, *emodeout;
+  CeedBasis basisin, basisout;
+  CeedElemRestriction rstrin, rstrout;
+  ierr = CeedOperatorGetActiveField_Ref(op, true, &basisin, &rstrin,
+                                        &numemodein, &emodein); CeedChk(ierr);
+  ierr = CeedOperatorGetActiveField_Ref(op, false, &basisout, &rstrout,
+                                        &numemodeout, &emodeout); CeedChk(ierr);
+  CeedInt nelem, ncompin, ncompout, nnodesin, nnodesout, nqpts, nqptsout;
+  ierr = CeedElemRestrictionGetNumElements(rstrin, &nelem); CeedChk(ierr);
+  ierr = CeedBasisGetNumComponents(basisin, &ncompin); CeedChk(ierr);
+  ierr = CeedBasisGetNumComponents(basisout, &ncompout); CeedChk(ierr);
+  ierr = CeedBasisGetNumNodes(basisin, &nnodesin); CeedChk(ierr);
+  ierr = CeedBasisGetNumNodes(basisout, &nnodesout); CeedChk(ierr);
+  ierr = CeedBasisGetNumQuadraturePoints(basisin, &nqpts); CeedChk(ierr);
+  ierr = CeedBasisGetNumQuadraturePoints(basisout, &nqptsout); CeedChk(ierr);
+  if (nqpts != nqptsout)
+    // LCOV_EXCL_START
+    return CeedError(ceed, 1, "Active input and output bases must have the "
+                     "same number of quadrature points");
+  // LCOV_EXCL_STOP
+  const CeedInt sizein = nnodesin*ncompin, sizeout = nnodesout*ncompout;
+
+  // Basis matrices
+  const CeedScalar *interpin, *interpout, *gradin, *gradout;
+  CeedScalar *identityin = NULL, *identityout = NULL;
+  bool evalNone = false;
+  for (CeedInt i=0; i<numemodein; i++)
+    evalNone = evalNone || (emodein[i] == CEED_EVAL_NONE);
+  if (evalNone) {
+    ierr = CeedCalloc(nqpts*nnodesin, &identityin); CeedChk(ierr);
+    for (CeedInt i=0; i<(nnodesin<nqpts?nnodesin:nqpts); i++)
+      identityin[i*nnodesin+i] = 1.0;
+  }
+  evalNone = false;
+  for (CeedInt i=0; i<numemodeout; i++)
+    evalNone = evalNone || (emodeout[i] == CEED_EVAL_NONE);
+  if (evalNone) {
+    ierr = CeedCalloc(nqpts*nnodesout, &identityout); CeedChk(ierr);
+    for (CeedInt i=0; i<(nnodesout<nqpts?nnodesout:nqpts); i++)
+      identityout[i*nnodesout+i] = 1.0;
+  }
+  ierr = CeedBasisGetInterp(basisin, &interpin); CeedChk(ierr);
+  ierr = CeedBasisGetInterp(basisout, &interpout); CeedChk(ierr);
+  ierr = CeedBasisGetGrad(basisin, &gradin); CeedChk(ierr);
+  ierr = CeedBasisGetGrad(basisout, &gradout); CeedChk(ierr);
+
+  // Compute B^T D B
+  const CeedScalar *assembledqfarray;
+  ierr = CeedVectorGetArrayRead(assembledqf, CEED_MEM_HOST, &assembledqfarray);
+  CeedChk(ierr);
+  for (CeedInt e=0; e<nelem; e++) {
+    CeedScalar *elemmat = &values[e*sizeout*sizein];
+    for (CeedInt i=0; i<sizeout*sizein; i++)
+      elemmat[i] = 0.0;
+    // Each basis eval mode pair
+    CeedInt dout = -1;
+    for (CeedInt eout=0; eout<numemodeout; eout++) {
+      const CeedScalar *bt = NULL;
+      if (emodeout[eout] == CEED_EVAL_GRAD)
+        dout += 1;
+      CeedOperatorGetBasisPointer_Ref(&bt, emodeout[eout], identityout,
+                                      interpout, &gradout[dout*nqpts*nnodesout]);
+      CeedInt din = -1;
+      for (CeedInt ein=0; ein<numemodein; ein++) {
+        const CeedScalar *b = NULL;
+        if (emodein[ein] == CEED_EVAL_GRAD)
+          din += 1;
+        CeedOperatorGetBasisPointer_Ref(&b, emodein[ein], identityin, interpin,
+                                        &gradin[din*nqpts*nnodesin]);
+        // Each component pair
+        for (CeedInt compIn=0; compIn<ncompin; compIn++)
+          for (CeedInt compOut=0; compOut<ncompout; compOut++)
+            // Each qpoint
+            for (CeedInt q=0; q<nqpts; q++) {
+              const CeedScalar qfvalue =
+                assembledqfarray[((((e*numemodein+ein)*ncompin+compIn)*
+                                   numemodeout+eout)*ncompout+compOut)*nqpts+q];
+              if (qfvalue == 0.0)
+                continue;
+              // Each node pair
+              for (CeedInt i=0; i<nnodesout; i++) {
+                const CeedScalar btd = bt[q*nnodesout+i] * qfvalue;
+                CeedScalar *row = &elemmat[(compOut*nnodesout+i)*sizein +
+                                           compIn*nnodesin];
+                for (CeedInt j=0; j<nnodesin; j++)
+                  row[j] += btd * b[q*nnodesin+j];
+              }
+            }
+      }
+    }
+  }
+  ierr = CeedVectorRestoreArrayRead(assembledqf, &assembledqfarray);
+  CeedChk(ierr);
+
+  // Cleanup
+  ierr = CeedVectorDestroy(&assembledqf); CeedChk(ierr);
+  ierr = CeedFree(&emodein); CeedChk(ierr);
+  ierr = CeedFree(&emodeout); CeedChk(ierr);
+  ierr = CeedFree(&identityin); CeedChk(ierr);
+  ierr = CeedFree(&identityout); CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Assemble Linear Symbolic
+//------------------------------------------------------------------------------
+int CeedOperatorLinearAssembleSymbolic_Ref(CeedOperator op, CeedInt *nentries,
+    CeedInt **rows, CeedInt **cols) {
+  int ierr;
+  ierr = CeedOperatorGetNumAssemblyEntries_Ref(op, nentries); CeedChk(ierr);
+  ierr = CeedMalloc(*nentries, rows); CeedChk(ierr);
+  ierr = CeedMalloc(*nentries, cols); CeedChk(ierr);
+
+  bool isComposite;
+  ierr = CeedOperatorIsComposite(op, &isComposite); CeedChk(ierr);
+  if (isComposite) {
+    CeedInt numSub, offset = 0;
+    CeedOperator *subOperators;
+    ierr = CeedOperatorGetNumSub(op, &numSub); CeedChk(ierr);
+    ierr = CeedOperatorGetSubList(op, &subOperators); CeedChk(ierr);
+    for (CeedInt i = 0; i < numSub; i++) {
+      CeedInt subentries;
+      ierr = CeedOperatorGetNumAssemblyEntries_Ref(subOperators[i],
+             &subentries); CeedChk(ierr);
+      ierr = CeedOperatorAssembleSymbolicCore_Ref(subOperators[i],
+             &(*rows)[offset], &(*cols)[offset]); CeedChk(ierr);
+      offset += subentries;
+    }
+  } else {
+    ierr = CeedOperatorAssembleSymbolicCore_Ref(op, *rows, *cols);
+    CeedChk(ierr);
+  }
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Assemble Linear Numeric
+//------------------------------------------------------------------------------
+int CeedOperatorLinearAssemble_Ref(CeedOperator op, CeedVector values) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  CeedInt nentries, length;
+  ierr = CeedOperatorGetNumAssemblyEntries_Ref(op, &nentries); CeedChk(ierr);
+  ierr = CeedVectorGetLength(values, &length); CeedChk(ierr);
+  if (length != nentries)
+    // LCOV_EXCL_START
+    return CeedError(ceed, 1, "Values vector length %d does not match the "
+                     "%d assembled entries", length, nentries);
+  // LCOV_EXCL_STOP
+
+  CeedScalar *valuesarray;
+  ierr = CeedVectorGetArray(values, CEED_MEM_HOST, &valuesarray); CeedChk(ierr);
+  bool isComposite;
+  ierr = CeedOperatorIsComposite(op, &isComposite); CeedChk(ierr);
+  if (isComposite) {
+    CeedInt numSub, offset = 0;
+    CeedOperator *subOperators;
+    ierr = CeedOperatorGetNumSub(op, &numSub); CeedChk(ierr);
+    ierr = CeedOperatorGetSubList(op, &subOperators); CeedChk(ierr);
+    for (CeedInt i = 0; i < numSub; i++) {
+      CeedInt subentries;
+      ierr = CeedOperatorGetNumAssemblyEntries_Ref(subOperators[i],
+             &subentries); CeedChk(ierr);
+      ierr = CeedOperatorAssembleElementMatricesCore_Ref(subOperators[i],
+             &valuesarray[offset]); CeedChk(ierr);
+      offset += subentries;
+    }
+  } else {
+    ierr = CeedOperatorAssembleElementMatricesCore_Ref(op, valuesarray);
+    CeedChk(ierr);
+  }
+  ierr = CeedVectorRestoreArray(values, &valuesarray); CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Assemble Linear Element Matrices
+//------------------------------------------------------------------------------
+int CeedOperatorLinearAssembleElementMatrices_Ref(CeedOperator op,
+    CeedVector *assembled, CeedRequest *request) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  CeedInt nentries;
+  ierr = CeedOperatorGetNumAssemblyEntries_Ref(op, &nentries); CeedChk(ierr);
+
+  // Create output vector
+  CeedScalar *assembledarray;
+  ierr = CeedVectorCreate(ceed, nentries, assembled); CeedChk(ierr);
+  ierr = CeedVectorGetArray(*assembled, CEED_MEM_HOST, &assembledarray);
+  CeedChk(ierr);
+
+  // Assemble element matrices
+  ierr = CeedOperatorAssembleElementMatricesCore_Ref(op, assembledarray);
+  CeedChk(ierr);
+  ierr = CeedVectorRestoreArray(*assembled, &assembledarray); CeedChk(ierr);
+  if (request != CEED_REQUEST_IMMEDIATE && request != CEED_REQUEST_ORDERED)
+    *request = NULL;
+
+  return 0;
+}
+
 //------------------------------------------------------------------------------
 // Create FDM Element Inverse
 //------------------------------------------------------------------------------
@@ -1192,11 +1997,14 @@ static int CeedOperatorDestroy_Ref(CeedOperator op) {
   ierr = CeedFree(&impl->evecs); CeedChk(ierr);
   ierr = CeedFree(&impl->edata); CeedChk(ierr);
   ierr = CeedFree(&impl->inputstate); CeedChk(ierr);
+  ierr = CeedFree(&impl->fusedin); CeedChk(ierr);
 
   for (CeedInt i=0; i<impl->numein; i++) {
     ierr = CeedVectorDestroy(&impl->evecsin[i]); CeedChk(ierr);
     ierr = CeedVectorDestroy(&impl->qvecsin[i]); CeedChk(ierr);
+    ierr = CeedFree(&impl->cdata[i]); CeedChk(ierr);
   }
+  ierr = CeedFree(&impl->cdata); CeedChk(ierr);
   ierr = CeedFree(&impl->evecsin); CeedChk(ierr);
   ierr = CeedFree(&impl->qvecsin); CeedChk(ierr);
 
@@ -1233,6 +2041,15 @@ int CeedOperatorCreate_Ref(CeedOperator op) {
                                 "LinearAssembleAddPointBlockDiagonal",
                                 CeedOperatorLinearAssembleAddPointBlockDiagonal_Ref);
   CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "LinearAssembleSymbolic",
+                                CeedOperatorLinearAssembleSymbolic_Ref);
+  CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "LinearAssemble",
+                                CeedOperatorLinearAssemble_Ref); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op,
+                                "LinearAssembleElementMatrices",
+                                CeedOperatorLinearAssembleElementMatrices_Ref);
+  CeedChk(ierr);
   ierr = CeedSetBackendFunction(ceed, "Operator", op, "CreateFDMElementInverse",
                                 CeedOperatorCreateFDMElementInverse_Ref);
   CeedChk(ierr);
@@ -1257,6 +2074,11 @@ int CeedCompositeOperatorCreate_Ref(CeedOperator op) {
                                 "LinearAssembleAddPointBlockDiagonal",
                                 CeedOperatorLinearAssembleAddPointBlockDiagonal_Ref);
   CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "LinearAssembleSymbolic",
+                                CeedOperatorLinearAssembleSymbolic_Ref);
+  CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "LinearAssemble",
+                                CeedOperatorLinearAssemble_Ref); CeedChk(ierr);
   return 0;
 }
 //------------------------------------------------------------------------------
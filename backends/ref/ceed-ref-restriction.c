@@ -14,8 +14,54 @@
 // software, applications, hardware, advanced system engineering and early
 // testbed platforms, in support of the nation's exascale computing imperative.
 
+#include <stdlib.h>
 #include "ceed-ref.h"
 
+//------------------------------------------------------------------------------
+// Setup L-vector to E-vector Transpose Map
+//   For each L-vector node, list the E-vector entries of its first component
+//   in increasing order, so the transpose can be applied as a gather. The map
+//   costs one CeedInt per E-vector node and is only built when requested with
+//   the environment variable CEED_TRANSPOSE_MAP.
+//------------------------------------------------------------------------------
+static int CeedElemRestrictionSetupTranspose_Ref(CeedElemRestriction r,
+    CeedElemRestriction_Ref *impl) {
+  int ierr;
+  CeedInt nelem, elemsize, numblk, blksize, ncomp, nnodes = 0;
+  ierr = CeedElemRestrictionGetNumElements(r, &nelem); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetElementSize(r, &elemsize); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumBlocks(r, &numblk); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetBlockSize(r, &blksize); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumComponents(r, &ncomp); CeedChk(ierr);
+  const CeedInt *offsets = impl->offsets;
+
+  for (CeedInt i = 0; i < numblk*blksize*elemsize; i++)
+    nnodes = CeedIntMax(nnodes, offsets[i] + 1);
+  ierr = CeedCalloc(nnodes + 1, &impl->tindices); CeedChk(ierr);
+  ierr = CeedMalloc(nelem*elemsize, &impl->toffsets); CeedChk(ierr);
+
+  // Count entries per node, discarding padding elements
+  for (CeedInt e = 0; e < numblk*blksize; e+=blksize)
+    for (CeedInt i = 0; i < elemsize*blksize; i+=blksize)
+      for (CeedInt j = i; j < i+CeedIntMin(blksize, nelem-e); j++)
+        impl->tindices[offsets[j+e*elemsize] + 1]++;
+  for (CeedInt n = 0; n < nnodes; n++)
+    impl->tindices[n + 1] += impl->tindices[n];
+  // Fill E-vector offsets in element order
+  for (CeedInt e = 0; e < numblk*blksize; e+=blksize)
+    for (CeedInt i = 0; i < elemsize*blksize; i+=blksize)
+      for (CeedInt j = i; j < i+CeedIntMin(blksize, nelem-e); j++)
+        impl->toffsets[impl->tindices[offsets[j+e*elemsize]]++]
+          = elemsize*ncomp*e + j;
+  for (CeedInt n = nnodes; n > 0; n--)
+    impl->tindices[n] = impl->tindices[n - 1];
+  impl->tindices[0] = 0;
+  impl->tnnodes = nnodes;
+  impl->tnumblk = numblk;
+
+  return 0;
+}
+
 //------------------------------------------------------------------------------
 // Core ElemRestriction Apply Code
 //------------------------------------------------------------------------------
@@ -117,6 +163,17 @@ static inline int CeedElemRestrictionApply_Ref_Core(CeedElemRestriction r,
                 vv[n*strides[0] + k*strides[1] + (e+j)*strides[2]]
                 += uu[e*elemsize*ncomp + (k*elemsize+n)*blksize + j - voffset];
       }
+    } else if (impl->tindices && start == 0 && stop == impl->tnumblk) {
+      // Offsets provided, full transpose as a gather over L-vector nodes
+      // Each entry of vv is written once and contributions are summed in the
+      //   same order as the scatter below
+      for (CeedInt n = 0; n < impl->tnnodes; n++)
+        for (CeedInt k = 0; k < ncomp; k++) {
+          CeedScalar vk = vv[n + k*compstride];
+          for (CeedInt j = impl->tindices[n]; j < impl->tindices[n+1]; j++)
+            vk += uu[impl->toffsets[j] + k*elemsize*blksize];
+          vv[n + k*compstride] = vk;
+        }
     } else {
       // Offsets provided, standard or blocked restriction
       // uu has shape [elemsize, ncomp, nelem]
@@ -306,6 +363,8 @@ static int CeedElemRestrictionDestroy_Ref(CeedElemRestriction r) {
   ierr = CeedElemRestrictionGetData(r, &impl); CeedChk(ierr);
 
   ierr = CeedFree(&impl->offsets_allocated); CeedChk(ierr);
+  ierr = CeedFree(&impl->toffsets); CeedChk(ierr);
+  ierr = CeedFree(&impl->tindices); CeedChk(ierr);
   ierr = CeedFree(&impl); CeedChk(ierr);
   return 0;
 }
@@ -377,6 +436,12 @@ int CeedElemRestrictionCreate_Ref(CeedMemType mtype, CeedCopyMode cmode,
     case CEED_USE_POINTER:
       impl->offsets = offsets;
     }
+
+    // Transpose map, if requested
+    const char *tmap = getenv("CEED_TRANSPOSE_MAP");
+    if (tmap && strcmp(tmap, "") && strcmp(tmap, "0")) {
+      ierr = CeedElemRestrictionSetupTranspose_Ref(r, impl); CeedChk(ierr);
+    }
   }
 
   ierr = CeedElemRestrictionSetData(r, impl); CeedChk(ierr);
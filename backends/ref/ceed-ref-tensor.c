@@ -16,15 +16,26 @@
 
 #include "ceed-ref.h"
 
+// Largest (P+1)/2 and (Q+1)/2 of a factored matrix
+#define CEED_EVENODD_MAX_HALF 16
+// Entries of the last index of u and v handled by each pair of contractions
+#define CEED_EVENODD_CHUNK 64
+// Largest B and J with a specialized contraction, covering tensor bases up to
+//   degree 10 with one or two extra quadrature points
+#define CEED_TENSOR_MAX_FIXED 12
+#if defined(__GNUC__)
+#  define CEED_TENSOR_INLINE static inline __attribute__((always_inline))
+#else
+#  define CEED_TENSOR_INLINE static inline
+#endif
+
 //------------------------------------------------------------------------------
-// Tensor Contract Apply
+// Tensor Contract Apply Full Matrix
 //------------------------------------------------------------------------------
-int CeedTensorContractApply_Ref(CeedTensorContract contract, CeedInt A,
-                                CeedInt B, CeedInt C, CeedInt J,
-                                const CeedScalar *restrict t,
-                                CeedTransposeMode tmode, const CeedInt Add,
-                                const CeedScalar *restrict u,
-                                CeedScalar *restrict v) {
+static int CeedTensorContractApplyFull_Ref(CeedTensorContract contract,
+    CeedInt A, CeedInt B, CeedInt C, CeedInt J, const CeedScalar *restrict t,
+    CeedTransposeMode tmode, const CeedInt Add, const CeedScalar *restrict u,
+    CeedScalar *restrict v) {
   CeedInt tstride0 = B, tstride1 = 1;
   if (tmode == CEED_TRANSPOSE) {
     tstride0 = 1; tstride1 = J;
@@ -44,10 +55,336 @@ int CeedTensorContractApply_Ref(CeedTensorContract contract, CeedInt A,
   return 0;
 }
 
+//------------------------------------------------------------------------------
+// Tensor Contract Apply Fixed Size
+//   B and J are compile-time constants in each instantiation below, so that
+//   the loops over them have known trip counts and the matrix fits in a local
+//   array with constant strides
+//------------------------------------------------------------------------------
+CEED_TENSOR_INLINE int CeedTensorContractApplyFixed_Ref(CeedInt A,
+    const CeedInt B, CeedInt C, const CeedInt J, const CeedScalar *restrict t,
+    CeedTransposeMode tmode, const CeedInt Add, const CeedScalar *restrict u,
+    CeedScalar *restrict v) {
+  CeedInt tstride0 = B, tstride1 = 1;
+  if (tmode == CEED_TRANSPOSE) {
+    tstride0 = 1; tstride1 = J;
+  }
+  CeedScalar tt[J][B];
+  for (CeedInt j=0; j<J; j++)
+    for (CeedInt b=0; b<B; b++)
+      tt[j][b] = t[j*tstride0 + b*tstride1];
+
+  if (C == 1) {
+    // Contraction over the last index, as in the first pass of a serial basis
+    for (CeedInt a=0; a<A; a++)
+      for (CeedInt j=0; j<J; j++) {
+        CeedScalar vj = Add ? v[a*J+j] : 0.0;
+        for (CeedInt b=0; b<B; b++)
+          vj += tt[j][b] * u[a*B+b];
+        v[a*J+j] = vj;
+      }
+    return 0;
+  }
+
+  if (!Add)
+    for (CeedInt q=0; q<A*J*C; q++)
+      v[q] = (CeedScalar) 0.0;
+  for (CeedInt a=0; a<A; a++)
+    for (CeedInt j=0; j<J; j++)
+      for (CeedInt b=0; b<B; b++) {
+        const CeedScalar tq = tt[j][b];
+        CeedPragmaSIMD
+        for (CeedInt c=0; c<C; c++)
+          v[(a*J+j)*C+c] += tq * u[(a*B+b)*C+c];
+      }
+  return 0;
+}
+
+#define CEED_TENSOR_FIXED(B, J)                                                \
+  static int CeedTensorContractApply_Ref_##B##_##J(                             \
+      CeedTensorContract contract, CeedInt A, CeedInt b, CeedInt C, CeedInt j,  \
+      const CeedScalar *restrict t, CeedTransposeMode tmode, const CeedInt Add, \
+      const CeedScalar *restrict u, CeedScalar *restrict v) {                   \
+    return CeedTensorContractApplyFixed_Ref(A, B, C, J, t, tmode, Add, u, v);   \
+  }
+#define CEED_TENSOR_FIXED_B(B)                                                 \
+  CEED_TENSOR_FIXED(B, 1) CEED_TENSOR_FIXED(B, 2) CEED_TENSOR_FIXED(B, 3)      \
+  CEED_TENSOR_FIXED(B, 4) CEED_TENSOR_FIXED(B, 5) CEED_TENSOR_FIXED(B, 6)      \
+  CEED_TENSOR_FIXED(B, 7) CEED_TENSOR_FIXED(B, 8) CEED_TENSOR_FIXED(B, 9)      \
+  CEED_TENSOR_FIXED(B, 10) CEED_TENSOR_FIXED(B, 11) CEED_TENSOR_FIXED(B, 12)
+CEED_TENSOR_FIXED_B(1) CEED_TENSOR_FIXED_B(2) CEED_TENSOR_FIXED_B(3)
+CEED_TENSOR_FIXED_B(4) CEED_TENSOR_FIXED_B(5) CEED_TENSOR_FIXED_B(6)
+CEED_TENSOR_FIXED_B(7) CEED_TENSOR_FIXED_B(8) CEED_TENSOR_FIXED_B(9)
+CEED_TENSOR_FIXED_B(10) CEED_TENSOR_FIXED_B(11) CEED_TENSOR_FIXED_B(12)
+#undef CEED_TENSOR_FIXED
+#undef CEED_TENSOR_FIXED_B
+
+// Specialized contractions, indexed by B-1 and J-1
+#define CEED_TENSOR_FIXED(B, J) CeedTensorContractApply_Ref_##B##_##J
+#define CEED_TENSOR_FIXED_B(B)                                                 \
+  {CEED_TENSOR_FIXED(B, 1), CEED_TENSOR_FIXED(B, 2), CEED_TENSOR_FIXED(B, 3),  \
+   CEED_TENSOR_FIXED(B, 4), CEED_TENSOR_FIXED(B, 5), CEED_TENSOR_FIXED(B, 6),  \
+   CEED_TENSOR_FIXED(B, 7), CEED_TENSOR_FIXED(B, 8), CEED_TENSOR_FIXED(B, 9),  \
+   CEED_TENSOR_FIXED(B, 10), CEED_TENSOR_FIXED(B, 11), CEED_TENSOR_FIXED(B, 12)}
+static const CeedTensorContractKernel_Ref
+CeedTensorContractFixed_Ref[CEED_TENSOR_MAX_FIXED][CEED_TENSOR_MAX_FIXED] = {
+  CEED_TENSOR_FIXED_B(1), CEED_TENSOR_FIXED_B(2), CEED_TENSOR_FIXED_B(3),
+  CEED_TENSOR_FIXED_B(4), CEED_TENSOR_FIXED_B(5), CEED_TENSOR_FIXED_B(6),
+  CEED_TENSOR_FIXED_B(7), CEED_TENSOR_FIXED_B(8), CEED_TENSOR_FIXED_B(9),
+  CEED_TENSOR_FIXED_B(10), CEED_TENSOR_FIXED_B(11), CEED_TENSOR_FIXED_B(12)
+};
+#undef CEED_TENSOR_FIXED
+#undef CEED_TENSOR_FIXED_B
+
+//------------------------------------------------------------------------------
+// Tensor Contract Apply Matrix
+//   Dispatch to the specialized contraction for B and J, if there is one
+//------------------------------------------------------------------------------
+static int CeedTensorContractApplyMatrix_Ref(CeedTensorContract contract,
+    CeedInt A, CeedInt B, CeedInt C, CeedInt J, const CeedScalar *restrict t,
+    CeedTransposeMode tmode, const CeedInt Add, const CeedScalar *restrict u,
+    CeedScalar *restrict v) {
+  if (B <= CEED_TENSOR_MAX_FIXED && J <= CEED_TENSOR_MAX_FIXED)
+    return CeedTensorContractFixed_Ref[B-1][J-1](contract, A, B, C, J, t,
+           tmode, Add, u, v);
+  return CeedTensorContractApplyFull_Ref(contract, A, B, C, J, t, tmode, Add,
+                                         u, v);
+}
+
+//------------------------------------------------------------------------------
+// Even-Odd Factors
+//   A matrix M with J rows and B columns and M[J-1-j][B-1-b] = s M[j][b] for a
+//   parity s of 1 or -1 splits into an even and an odd half. With
+//     u+[b] = u[b] + u[B-1-b] and u-[b] = u[b] - u[B-1-b]
+//   the contraction v = M u becomes, for j < (J+1)/2,
+//     v[j] = E u+ + O u-,  v[J-1-j] = s (E u+ - O u-)
+//   with E[j][b] = (M[j][b] + M[j][B-1-b])/2 and O[j][b] = (M[j][b] -
+//   M[j][B-1-b])/2, which halves the number of multiplications. For odd B the
+//   middle column of M is the last column of E, multiplying u[B/2].
+//   Folding and unfolding cost more than they save while M fits the fixed
+//   size contractions, so only larger matrices are factored.
+//------------------------------------------------------------------------------
+static int CeedEvenOddCreate_Ref(const CeedScalar *t, CeedInt P, CeedInt Q,
+                                 CeedEvenOdd_Ref *evenodd, bool *factored) {
+  int ierr;
+  *factored = false;
+  if ((P <= CEED_TENSOR_MAX_FIXED && Q <= CEED_TENSOR_MAX_FIXED) ||
+      (P+1)/2 > CEED_EVENODD_MAX_HALF || (Q+1)/2 > CEED_EVENODD_MAX_HALF)
+    return 0;
+
+  // Detect parity
+  CeedScalar maxabs = 0.0;
+  for (CeedInt i=0; i<P*Q; i++)
+    maxabs = fmax(maxabs, fabs(t[i]));
+  CeedInt parity = 0;
+  for (CeedInt s=1; s>=-1 && !parity && maxabs > 0.0; s-=2) {
+    bool match = true;
+    for (CeedInt i=0; i<P*Q; i++)
+      match = match && fabs(t[P*Q-1-i] - s*t[i]) <= 1000*CEED_EPSILON*maxabs;
+    if (match)
+      parity = s;
+  }
+  if (!parity)
+    return 0;
+
+  // Factors in both orientations
+  evenodd->t = t;
+  evenodd->P = P;
+  evenodd->Q = Q;
+  evenodd->parity = parity;
+  for (CeedInt o=0; o<2; o++) {
+    const CeedInt B = o ? Q : P, J = o ? P : Q;
+    const CeedInt Be = (B+1)/2, Bo = B/2, J2 = (J+1)/2;
+    const CeedInt tstride0 = o ? 1 : P, tstride1 = o ? P : 1;
+    ierr = CeedMalloc(J2*Be, &evenodd->even[o]); CeedChk(ierr);
+    ierr = CeedMalloc(J2*Bo, &evenodd->odd[o]); CeedChk(ierr);
+    for (CeedInt j=0; j<J2; j++) {
+      for (CeedInt b=0; b<Bo; b++) {
+        const CeedScalar lo = t[j*tstride0 + b*tstride1];
+        const CeedScalar hi = t[j*tstride0 + (B-1-b)*tstride1];
+        evenodd->even[o][j*Be+b] = (lo + hi) / 2;
+        evenodd->odd[o][j*Bo+b] = (lo - hi) / 2;
+      }
+      if (B % 2)
+        evenodd->even[o][j*Be+Bo] = t[j*tstride0 + Bo*tstride1];
+    }
+  }
+  *factored = true;
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Tensor Contract Setup Even-Odd
+//   Factor the 1D matrices of a tensor basis built on symmetric nodes and
+//   quadrature points, such as by CeedBasisCreateTensorH1Lagrange
+//------------------------------------------------------------------------------
+static int CeedTensorContractSetupEvenOdd_Ref(CeedBasis basis,
+    CeedTensorContract contract) {
+  int ierr;
+  bool tensorbasis;
+  ierr = CeedBasisIsTensor(basis, &tensorbasis); CeedChk(ierr);
+  if (!tensorbasis)
+    return 0;
+  CeedInt P1d, Q1d;
+  ierr = CeedBasisGetNumNodes1D(basis, &P1d); CeedChk(ierr);
+  ierr = CeedBasisGetNumQuadraturePoints1D(basis, &Q1d); CeedChk(ierr);
+  const CeedScalar *interp1d, *grad1d;
+  ierr = CeedBasisGetInterp1D(basis, &interp1d); CeedChk(ierr);
+  ierr = CeedBasisGetGrad1D(basis, &grad1d); CeedChk(ierr);
+  CeedBasis_Ref *basisimpl;
+  ierr = CeedBasisGetData(basis, &basisimpl); CeedChk(ierr);
+
+  CeedTensorContract_Ref *impl;
+  ierr = CeedCalloc(1, &impl); CeedChk(ierr);
+  const CeedScalar *t[3] = {interp1d, grad1d,
+                            basisimpl ? basisimpl->collograd1d : NULL
+                           };
+  const CeedInt P[3] = {P1d, P1d, Q1d};
+  for (CeedInt i=0; i<3; i++) {
+    bool factored;
+    if (!t[i])
+      continue;
+    ierr = CeedEvenOddCreate_Ref(t[i], P[i], Q1d,
+                                 &impl->evenodd[impl->numevenodd], &factored);
+    CeedChk(ierr);
+    impl->numevenodd += factored;
+  }
+  ierr = CeedTensorContractSetData(contract, impl); CeedChk(ierr);
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Tensor Contract Destroy Even-Odd
+//------------------------------------------------------------------------------
+static int CeedTensorContractDestroyEvenOdd_Ref(CeedTensorContract contract) {
+  int ierr;
+  CeedTensorContract_Ref *impl;
+  ierr = CeedTensorContractGetData(contract, &impl); CeedChk(ierr);
+  if (!impl)
+    return 0;
+  for (CeedInt i=0; i<impl->numevenodd; i++)
+    for (CeedInt o=0; o<2; o++) {
+      ierr = CeedFree(&impl->evenodd[i].even[o]); CeedChk(ierr);
+      ierr = CeedFree(&impl->evenodd[i].odd[o]); CeedChk(ierr);
+    }
+  ierr = CeedFree(&impl); CeedChk(ierr);
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Tensor Contract Apply Even-Odd
+//   If t has even-odd factors, fold u, apply the even and odd factors, and
+//   unfold into v. Chunks of u are folded into buffers on the stack, so this
+//   is safe to call from several threads.
+//------------------------------------------------------------------------------
+static int CeedTensorContractApplyEvenOdd_Ref(CeedTensorContract contract,
+    CeedInt A, CeedInt B, CeedInt C, CeedInt J, const CeedScalar *restrict t,
+    CeedTransposeMode tmode, const CeedInt Add, const CeedScalar *restrict u,
+    CeedScalar *restrict v, bool *applied) {
+  int ierr;
+  CeedTensorContract_Ref *impl;
+  ierr = CeedTensorContractGetData(contract, &impl); CeedChk(ierr);
+  const CeedInt o = tmode == CEED_TRANSPOSE;
+  const CeedEvenOdd_Ref *evenodd = NULL;
+  *applied = false;
+  for (CeedInt i=0; impl && i<impl->numevenodd; i++)
+    if (impl->evenodd[i].t == t && B == (o ? impl->evenodd[i].Q :
+                                         impl->evenodd[i].P) &&
+        J == (o ? impl->evenodd[i].P : impl->evenodd[i].Q))
+      evenodd = &impl->evenodd[i];
+  if (!evenodd)
+    return 0;
+
+  const CeedInt Be = (B+1)/2, Bo = B/2, J2 = (J+1)/2, s = evenodd->parity;
+  // Chunks of na slices of the first index and n entries of the last index
+  const CeedInt n = C < CEED_EVENODD_CHUNK ? C : CEED_EVENODD_CHUNK;
+  const CeedInt na = CEED_EVENODD_CHUNK / n;
+  CeedScalar up[CEED_EVENODD_MAX_HALF*CEED_EVENODD_CHUNK],
+             um[CEED_EVENODD_MAX_HALF*CEED_EVENODD_CHUNK],
+             vp[CEED_EVENODD_MAX_HALF*CEED_EVENODD_CHUNK],
+             vm[CEED_EVENODD_MAX_HALF*CEED_EVENODD_CHUNK];
+  for (CeedInt a0=0; a0<A; a0+=na) {
+    const CeedInt nna = A-a0 < na ? A-a0 : na;
+    for (CeedInt c0=0; c0<C; c0+=n) {
+      const CeedInt nn = C-c0 < n ? C-c0 : n;
+      // Fold u
+      for (CeedInt aa=0; aa<nna; aa++) {
+        const CeedScalar *ua = &u[(a0+aa)*B*C + c0];
+        for (CeedInt b=0; b<Bo; b++)
+          CeedPragmaSIMD
+          for (CeedInt c=0; c<nn; c++) {
+            const CeedScalar lo = ua[b*C+c], hi = ua[(B-1-b)*C+c];
+            up[(aa*Be+b)*nn+c] = lo + hi;
+            um[(aa*Bo+b)*nn+c] = lo - hi;
+          }
+        if (B % 2)
+          for (CeedInt c=0; c<nn; c++)
+            up[(aa*Be+Bo)*nn+c] = ua[Bo*C+c];
+      }
+      // Even and odd contractions
+      ierr = CeedTensorContractApplyMatrix_Ref(contract, nna, Be, nn, J2,
+             evenodd->even[o], CEED_NOTRANSPOSE, false, up, vp);
+      CeedChk(ierr);
+      ierr = CeedTensorContractApplyMatrix_Ref(contract, nna, Bo, nn, J2,
+             evenodd->odd[o], CEED_NOTRANSPOSE, false, um, vm);
+      CeedChk(ierr);
+      // Unfold into v
+      for (CeedInt aa=0; aa<nna; aa++) {
+        CeedScalar *va = &v[(a0+aa)*J*C + c0];
+        for (CeedInt j=0; j<J2; j++) {
+          const CeedScalar *vpj = &vp[(aa*J2+j)*nn], *vmj = &vm[(aa*J2+j)*nn];
+          CeedScalar *vlo = &va[j*C], *vhi = &va[(J-1-j)*C];
+          if (j == J-1-j) {
+            for (CeedInt c=0; c<nn; c++)
+              vlo[c] = (Add ? vlo[c] : 0.0) + vpj[c] + vmj[c];
+          } else if (Add) {
+            CeedPragmaSIMD
+            for (CeedInt c=0; c<nn; c++) {
+              vlo[c] += vpj[c] + vmj[c];
+              vhi[c] += s*(vpj[c] - vmj[c]);
+            }
+          } else {
+            CeedPragmaSIMD
+            for (CeedInt c=0; c<nn; c++) {
+              vlo[c] = vpj[c] + vmj[c];
+              vhi[c] = s*(vpj[c] - vmj[c]);
+            }
+          }
+        }
+      }
+    }
+  }
+  *applied = true;
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Tensor Contract Apply
+//------------------------------------------------------------------------------
+static int CeedTensorContractApply_Ref(CeedTensorContract contract, CeedInt A,
+                                       CeedInt B, CeedInt C, CeedInt J,
+                                       const CeedScalar *restrict t,
+                                       CeedTransposeMode tmode,
+                                       const CeedInt Add,
+                                       const CeedScalar *restrict u,
+                                       CeedScalar *restrict v) {
+  int ierr;
+  bool evenodd;
+  ierr = CeedTensorContractApplyEvenOdd_Ref(contract, A, B, C, J, t, tmode,
+         Add, u, v, &evenodd);
+  CeedChk(ierr);
+  if (evenodd)
+    return 0;
+  return CeedTensorContractApplyMatrix_Ref(contract, A, B, C, J, t, tmode, Add,
+         u, v);
+}
+
 //------------------------------------------------------------------------------
 // Tensor Contract Destroy
 //------------------------------------------------------------------------------
 static int CeedTensorContractDestroy_Ref(CeedTensorContract contract) {
+  int ierr;
+  ierr = CeedTensorContractDestroyEvenOdd_Ref(contract); CeedChk(ierr);
   return 0;
 }
 
@@ -59,6 +396,8 @@ int CeedTensorContractCreate_Ref(CeedBasis basis, CeedTensorContract contract) {
   Ceed ceed;
   ierr = CeedTensorContractGetCeed(contract, &ceed); CeedChk(ierr);
 
+  ierr = CeedTensorContractSetupEvenOdd_Ref(basis, contract); CeedChk(ierr);
+
   ierr = CeedSetBackendFunction(ceed, "TensorContract", contract, "Apply",
                                 CeedTensorContractApply_Ref); CeedChk(ierr);
   ierr = CeedSetBackendFunction(ceed, "TensorContract", contract, "Destroy",
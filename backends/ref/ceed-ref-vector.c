@@ -170,4 +170,38 @@ int CeedVectorCreate_Ref(CeedInt n, CeedVector vec) {
   ierr = CeedVectorSetData(vec, impl); CeedChk(ierr);
   return 0;
 }
+
+//------------------------------------------------------------------------------
+// Vector Get Work Array
+//   Attach storage borrowed from the workspace pool of the Ceed to an E-vector
+//   that is only needed during an operator apply
+//------------------------------------------------------------------------------
+int CeedVectorGetWorkArray_Ref(CeedVector vec) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedVectorGetCeed(vec, &ceed); CeedChk(ierr);
+  CeedInt length;
+  ierr = CeedVectorGetLength(vec, &length); CeedChk(ierr);
+  CeedScalar *array;
+
+  ierr = CeedGetWorkArray(ceed, length, &array); CeedChk(ierr);
+  ierr = CeedVectorSetArray(vec, CEED_MEM_HOST, CEED_USE_POINTER, array);
+  CeedChk(ierr);
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Vector Restore Work Array
+//   Detach the borrowed storage and return it to the workspace pool
+//------------------------------------------------------------------------------
+int CeedVectorRestoreWorkArray_Ref(CeedVector vec) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedVectorGetCeed(vec, &ceed); CeedChk(ierr);
+  CeedScalar *array;
+
+  ierr = CeedVectorTakeArray(vec, CEED_MEM_HOST, &array); CeedChk(ierr);
+  ierr = CeedRestoreWorkArray(ceed, &array); CeedChk(ierr);
+  return 0;
+}
 //------------------------------------------------------------------------------
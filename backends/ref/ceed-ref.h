@@ -15,14 +15,36 @@
 // testbed platforms, in support of the nation's exascale computing imperative.
 
 #include <ceed-backend.h>
+#include <pthread.h>
 #include <string.h>
 #include <math.h>
 
 typedef struct {
   CeedScalar *collograd1d;
   bool collointerp;
+  CeedScalar *scratch;   /// Aligned scratch for intermediate contractions
+  CeedInt scratchsize;   /// Number of entries in scratch
+  pthread_mutex_t scratchlock;  /// Held while scratch is in use
 } CeedBasis_Ref;
 
+// Even-odd factors of a centro-symmetric or centro-antisymmetric 1D matrix
+typedef struct {
+  const CeedScalar *t;  /// Basis matrix with Q rows and P columns
+  CeedInt P, Q;
+  CeedInt parity;       /// 1 if t is centro-symmetric, -1 if antisymmetric
+  CeedScalar *even[2];  /// Even factors for CEED_NOTRANSPOSE, CEED_TRANSPOSE
+  CeedScalar *odd[2];   /// Odd factors for CEED_NOTRANSPOSE, CEED_TRANSPOSE
+} CeedEvenOdd_Ref;
+
+typedef struct {
+  CeedInt numevenodd;
+  CeedEvenOdd_Ref evenodd[3];  /// interp1d, grad1d, and collocated grad1d
+} CeedTensorContract_Ref;
+
+typedef int (*CeedTensorContractKernel_Ref)(CeedTensorContract, CeedInt,
+    CeedInt, CeedInt, CeedInt, const CeedScalar *restrict, CeedTransposeMode,
+    const CeedInt, const CeedScalar *restrict, CeedScalar *restrict);
+
 typedef struct {
   CeedScalar *array;
   CeedScalar *array_allocated;
@@ -31,6 +53,10 @@ typedef struct {
 typedef struct {
   const CeedInt *offsets;
   CeedInt *offsets_allocated;
+  CeedInt tnumblk;          /* number of blocks in transpose map */
+  CeedInt tnnodes;          /* number of L-vector nodes in transpose map */
+  CeedInt *toffsets;        /* E-vector offsets for each node, CSR ordered */
+  CeedInt *tindices;        /* CSR row pointers into toffsets, by node */
   int (*Apply)(CeedElemRestriction, const CeedInt, const CeedInt,
                const CeedInt, CeedInt, CeedInt, CeedTransposeMode, CeedVector,
                CeedVector, CeedRequest *);
@@ -53,6 +79,8 @@ typedef struct {
   *evecs;   /// E-vectors needed to apply operator (input followed by outputs)
   CeedScalar **edata;
   uint64_t *inputstate;  /// State counter of inputs
+  void **cdata;          /// Compressed E-vector data of passive inputs
+  CeedInt *fusedin;      /// Input evaluated together with each input, or -1
   CeedVector *evecsin;   /// Input E-vectors needed to apply operator
   CeedVector *evecsout;  /// Output E-vectors needed to apply operator
   CeedVector *qvecsin;   /// Input Q-vectors needed to apply operator
@@ -62,6 +90,8 @@ typedef struct {
 } CeedOperator_Ref;
 
 CEED_INTERN int CeedVectorCreate_Ref(CeedInt n, CeedVector vec);
+CEED_INTERN int CeedVectorGetWorkArray_Ref(CeedVector vec);
+CEED_INTERN int CeedVectorRestoreWorkArray_Ref(CeedVector vec);
 
 CEED_INTERN int CeedElemRestrictionCreate_Ref(CeedMemType mtype,
     CeedCopyMode cmode, const CeedInt *indices, CeedElemRestriction r);
@@ -78,6 +108,9 @@ CEED_INTERN int CeedBasisCreateH1_Ref(CeedElemTopology topo,
                                       const CeedScalar *qweight,
                                       CeedBasis basis);
 
+CEED_INTERN int CeedBasisApplyInterpGrad_Ref(CeedBasis basis, CeedInt nelem,
+    CeedVector U, CeedVector Vinterp, CeedVector Vgrad);
+
 CEED_INTERN int CeedTensorContractCreate_Ref(CeedBasis basis,
     CeedTensorContract contract);
 
@@ -87,4 +120,38 @@ CEED_INTERN int CeedQFunctionContextCreate_Ref(CeedQFunctionContext ctx);
 
 CEED_INTERN int CeedOperatorCreate_Ref(CeedOperator op);
 
+CEED_INTERN int CeedOperatorGetFusedInputs_Ref(CeedOperator op,
+    CeedInt *fused);
+
+CEED_INTERN int CeedStorageGetSize_Ref(CeedStorageMode storage, CeedInt size,
+                                       CeedInt *csize, size_t *valsize);
+
+CEED_INTERN int CeedStorageCompress_Ref(CeedStorageMode storage, CeedInt size,
+                                        CeedInt len, CeedInt nchunks,
+                                        const CeedScalar *full,
+                                        void *compressed);
+
+CEED_INTERN int CeedStorageExpand_Ref(CeedStorageMode storage, CeedInt size,
+                                      CeedInt len, CeedInt chunk,
+                                      const void *compressed, CeedScalar *full);
+
+CEED_INTERN int CeedOperatorAssembleAddDiagonalBlocked_Ref(CeedOperator op,
+    CeedVector assembledqf, CeedInt blksize, CeedVector assembled,
+    CeedRequest *request, const bool pointBlock);
+
+CEED_INTERN int CeedOperatorLinearAssembleAddDiagonal_Ref(CeedOperator op,
+    CeedVector assembled, CeedRequest *request);
+
+CEED_INTERN int CeedOperatorLinearAssembleAddPointBlockDiagonal_Ref(
+  CeedOperator op, CeedVector assembled, CeedRequest *request);
+
+CEED_INTERN int CeedOperatorLinearAssembleSymbolic_Ref(CeedOperator op,
+    CeedInt *nentries, CeedInt **rows, CeedInt **cols);
+
+CEED_INTERN int CeedOperatorLinearAssemble_Ref(CeedOperator op,
+    CeedVector values);
+
+CEED_INTERN int CeedOperatorLinearAssembleElementMatrices_Ref(CeedOperator op,
+    CeedVector *assembled, CeedRequest *request);
+
 CEED_INTERN int CeedCompositeOperatorCreate_Ref(CeedOperator op);
@@ -16,6 +16,18 @@
 
 #include "ceed-xsmm.h"
 
+//------------------------------------------------------------------------------
+// Backend Destroy
+//------------------------------------------------------------------------------
+static int CeedDestroy_Xsmm(Ceed ceed) {
+  int ierr;
+  Ceed_Xsmm *data;
+  ierr = CeedGetData(ceed, &data); CeedChk(ierr);
+  ierr = CeedFree(&data); CeedChk(ierr);
+
+  return 0;
+}
+
 //------------------------------------------------------------------------------
 // Backend Init
 //------------------------------------------------------------------------------
@@ -35,6 +47,14 @@ static int CeedInit_Xsmm_Serial(const char *resource, Ceed ceed) {
   CeedInit("/cpu/self/opt/serial", &ceedref);
   ierr = CeedSetDelegate(ceed, ceedref); CeedChk(ierr);
 
+  // Elements per block of the delegate, which fixes the tensor contractions
+  Ceed_Xsmm *data;
+  ierr = CeedCalloc(1, &data); CeedChk(ierr);
+  data->blksize = 1;
+  ierr = CeedSetData(ceed, data); CeedChk(ierr);
+
+  ierr = CeedSetBackendFunction(ceed, "Ceed", ceed, "Destroy",
+                                CeedDestroy_Xsmm); CeedChk(ierr);
   ierr = CeedSetBackendFunction(ceed, "Ceed", ceed, "TensorContractCreate",
                                 CeedTensorContractCreate_Xsmm); CeedChk(ierr);
 
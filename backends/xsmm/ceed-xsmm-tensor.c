@@ -36,9 +36,9 @@ static int CeedTensorContract_Xsmm_C1(CeedTensorContract contract,
     beta = 0.0;
 
   // libXSMM GEMM
-  libxsmm_dgemm(&transt, &transu, &J, &A, &B,
-                &alpha, &t[0], NULL, &u[0], NULL,
-                &beta, &v[0], NULL);
+  CeedXsmmGemm(&transt, &transu, &J, &A, &B,
+               &alpha, &t[0], NULL, &u[0], NULL,
+               &beta, &v[0], NULL);
 
   return 0;
 }
@@ -57,18 +57,30 @@ static int CeedTensorContractApply_Xsmm(CeedTensorContract contract, CeedInt A,
   CeedTensorContract_Xsmm *impl;
   ierr = CeedTensorContractGetData(contract, &impl); CeedChk(ierr);
 
-  // Get kernel
-  libxsmm_dmmfunction kernel;
-  CeedHashIJKLMKey key = {B, C, J, tmode, add};
-  khint_t k = kh_get(m32, impl->lookup, key);
-  CeedHashGetValue(impl->lookup, k, kernel);
+  if (C == 1)
+    return CeedTensorContract_Xsmm_C1(contract, A, B, C, J, t, tmode, add, u,
+                                      v);
+
+  // Get kernel; gradients contract with the collocated Q by Q matrix for
+  //   tensor bases and produce dim Q values for other bases
+  const CeedInt grad = impl->isTensor ? (tmode ? J : B) != impl->P :
+                       (tmode ? B : J) != impl->Q;
+  CeedInt step = 0, c = impl->blksize;
+  if (impl->isTensor)
+    for (; c < C && step < impl->dim - 1; c *= J) step++;
+  CeedXsmmFunction kernel = impl->kernels[tmode][add != 0][grad][step];
+  if (c != C || !kernel) {
+    // LCOV_EXCL_START
+    Ceed ceed;
+    ierr = CeedTensorContractGetCeed(contract, &ceed); CeedChk(ierr);
+    return CeedError(ceed, 1, "No LIBXSMM kernel for B=%d, C=%d, J=%d", B, C,
+                     J);
+    // LCOV_EXCL_STOP
+  }
 
-  // Run kernel or fallback to default implementation
-  if (C != 1)
-    for (CeedInt a=0; a<A; a++)
-      kernel(&u[a*B*C], &t[0], &v[a*J*C], NULL, NULL, NULL);
-  else
-    CeedTensorContract_Xsmm_C1(contract, A, B, C, J, t, tmode, add, u, v);
+  // Run kernel
+  for (CeedInt a=0; a<A; a++)
+    kernel(&u[a*B*C], &t[0], &v[a*J*C], NULL, NULL, NULL);
 
   return 0;
 }
@@ -79,98 +91,88 @@ static int CeedTensorContractApply_Xsmm(CeedTensorContract contract, CeedInt A,
 static int CeedTensorContractDestroy_Xsmm(CeedTensorContract contract) {
   int ierr;
   CeedTensorContract_Xsmm *impl;
-  libxsmm_dmmfunction kernel;
 
   ierr = CeedTensorContractGetData(contract, &impl); CeedChk(ierr);
-  // Free kernels
-  kh_foreach_value(impl->lookup, kernel, libxsmm_release_kernel(&kernel));
-  kh_destroy(m32, impl->lookup);
+  // Free kernels, which may appear in several entries of the table
+  CeedXsmmFunction *kernels = &impl->kernels[0][0][0][0];
+  const CeedInt numkernels = sizeof(impl->kernels) / sizeof(kernels[0]);
+  for (CeedInt i=0; i<numkernels; i++) {
+    if (!kernels[i])
+      continue;
+    CeedXsmmFunction kernel = kernels[i];
+    for (CeedInt j=i; j<numkernels; j++)
+      if (kernels[j] == kernel)
+        kernels[j] = NULL;
+    libxsmm_release_kernel(&kernel);
+  }
   ierr = CeedFree(&impl); CeedChk(ierr);
   return 0;
 }
 
 //------------------------------------------------------------------------------
 // Tensor Contract Create
+//   Kernels for every step of the basis actions are built here, so that
+//   applying a contraction is a direct call through the table
 //------------------------------------------------------------------------------
 int CeedTensorContractCreate_Xsmm(CeedBasis basis,
                                   CeedTensorContract contract) {
   int ierr;
   Ceed ceed;
   ierr = CeedTensorContractGetCeed(contract, &ceed); CeedChk(ierr);
+  Ceed_Xsmm *data;
+  ierr = CeedGetData(ceed, &data); CeedChk(ierr);
   CeedTensorContract_Xsmm *impl;
   ierr = CeedCalloc(1, &impl); CeedChk(ierr);
-
-  // Setup kernels hash table
-  impl->lookup = kh_init(m32);
+  impl->blksize = data->blksize;
 
   // Set up pointers to kernels
   ierr = CeedBasisIsTensor(basis, &impl->isTensor); CeedChk(ierr);
+  ierr = CeedBasisGetDimension(basis, &impl->dim); CeedChk(ierr);
   if (impl->isTensor) {
     ierr = CeedBasisGetNumNodes1D(basis, &impl->P); CeedChk(ierr);
     ierr = CeedBasisGetNumQuadraturePoints1D(basis, &impl->Q); CeedChk(ierr);
-    ierr = CeedBasisGetDimension(basis, &impl->dim); CeedChk(ierr);
-    // Build all required kernels
-    for (CeedInt nelem = 1; nelem <= 8; nelem+=7)
-      for (CeedInt add = 0; add <= 1; add++)
-        for (CeedInt tmode = 0; tmode <= 1; tmode++)
-          for (CeedInt grad = 0; grad <=1; grad++)
-            for (CeedInt dim = 0; dim < impl->dim; dim++) {
-              const int flags = LIBXSMM_GEMM_FLAGS('N', tmode ? 'T' : 'N');
-              CeedInt B = grad ? impl->Q : (tmode ? impl->Q : impl->P),
-                      J = grad ? impl->Q : (tmode ? impl->P : impl->Q),
-                      C = nelem*CeedIntPow(J, dim);
-              // Add key, kernel pair to hash table
-              CeedHashIJKLMKey key = {B, C, J, tmode, add};
-              int new_item;
-              khint_t k = kh_put(m32, impl->lookup, key, &new_item);
-              if (new_item) {
-                // Build kernel
-                CeedScalar alpha = 1.0, beta = 1.0;
-                if (!add) beta = 0.0;
-                libxsmm_dmmfunction kernel = libxsmm_dmmdispatch(
-                                               C, J, B, NULL, NULL, NULL, &alpha, &beta, &flags, NULL);
-                if (!kernel)
-                  // LCOV_EXCL_START
-                  return CeedError(ceed, 1, "LIBXSMM kernel failed to build.");
-                // LCOV_EXCL_STOP
-                // Add kernel to hash table
-                kh_value(impl->lookup, k) = kernel;
-              }
-            }
   } else {
     ierr = CeedBasisGetNumNodes(basis, &impl->P); CeedChk(ierr);
     ierr = CeedBasisGetNumQuadraturePoints(basis, &impl->Q); CeedChk(ierr);
-    ierr = CeedBasisGetDimension(basis, &impl->dim); CeedChk(ierr);
-    // Build all required kernels
-    for (CeedInt nelem = 1; nelem <= 8; nelem+=7)
-      for (CeedInt add = 0; add <= 1; add++)
-        for (CeedInt tmode = 0; tmode <= 1; tmode++) {
-          CeedInt gradstride = CeedIntMax(impl->dim-1, 1);
-          for (CeedInt grad = 1; grad <= impl->dim; grad+=gradstride) {
-            const int flags = LIBXSMM_GEMM_FLAGS('N', tmode ? 'T' : 'N');
-            CeedInt B = tmode ? grad*impl->Q : impl->P,
-                    J = tmode ? impl->P : grad*impl->Q,
-                    C = nelem;
-            // Add key, kernel pair to hash table
-            CeedHashIJKLMKey key = {B, C, J, tmode, add};
-            int new_item;
-            khint_t k = kh_put(m32, impl->lookup, key, &new_item);
-            if (new_item) {
-              // Build kernel
-              CeedScalar alpha = 1.0, beta = 1.0;
-              if (!add) beta = 0.0;
-              libxsmm_dmmfunction kernel = libxsmm_dmmdispatch(
-                                             C, J, B, NULL, NULL, NULL, &alpha, &beta, &flags, NULL);
-              if (!kernel)
-                // LCOV_EXCL_START
-                return CeedError(ceed, 1, "LIBXSMM kernel failed to build.");
-              // LCOV_EXCL_STOP
-              // Add kernel to hash table
-              kh_value(impl->lookup, k) = kernel;
-            }
+  }
+  if (impl->isTensor && impl->dim > CEED_XSMM_MAX_DIM)
+    // LCOV_EXCL_START
+    return CeedError(ceed, 1, "LIBXSMM backend does not support dim %d",
+                     impl->dim);
+  // LCOV_EXCL_STOP
+  const CeedInt numsteps = impl->isTensor ? impl->dim : 1;
+
+  // Build all required kernels
+  for (CeedInt add = 0; add <= 1; add++)
+    for (CeedInt tmode = 0; tmode <= 1; tmode++)
+      for (CeedInt grad = 0; grad <= 1; grad++)
+        for (CeedInt step = 0; step < numsteps; step++) {
+          const int flags = LIBXSMM_GEMM_FLAGS('N', tmode ? 'T' : 'N');
+          CeedInt B, J, C;
+          if (impl->isTensor) {
+            B = grad ? impl->Q : (tmode ? impl->Q : impl->P);
+            J = grad ? impl->Q : (tmode ? impl->P : impl->Q);
+            C = impl->blksize*CeedIntPow(J, step);
+          } else {
+            const CeedInt ngrad = grad ? impl->dim : 1;
+            B = tmode ? ngrad*impl->Q : impl->P;
+            J = tmode ? impl->P : ngrad*impl->Q;
+            C = impl->blksize;
           }
+          // C = 1 uses GEMM without a kernel
+          if (C == 1)
+            continue;
+          // Build kernel
+          CeedScalar alpha = 1.0, beta = 1.0;
+          if (!add) beta = 0.0;
+          CeedXsmmFunction kernel = CeedXsmmDispatch(
+                                      C, J, B, NULL, NULL, NULL, &alpha, &beta, &flags, NULL);
+          if (!kernel)
+            // LCOV_EXCL_START
+            return CeedError(ceed, 1, "LIBXSMM kernel failed to build.");
+          // LCOV_EXCL_STOP
+          impl->kernels[tmode][add][grad][step] = kernel;
         }
-  }
   ierr = CeedTensorContractSetData(contract, impl); CeedChk(ierr);
 
   ierr = CeedSetBackendFunction(ceed, "TensorContract", contract, "Apply",
@@ -15,18 +15,34 @@
 // testbed platforms, in support of the nation's exascale computing imperative.
 
 #include <ceed-backend.h>
-#include <ceed-hash.h>
 #include <libxsmm.h>
 #include <string.h>
 #include <math.h>
 
-// Instantiate khash structs and methods
-CeedHashIJKLMInit(m32, libxsmm_dmmfunction)
+// libXSMM kernels matching the precision of CeedScalar
+#ifdef CEED_SCALAR_FLOAT
+#  define CeedXsmmFunction libxsmm_smmfunction
+#  define CeedXsmmDispatch libxsmm_smmdispatch
+#  define CeedXsmmGemm     libxsmm_sgemm
+#else
+#  define CeedXsmmFunction libxsmm_dmmfunction
+#  define CeedXsmmDispatch libxsmm_dmmdispatch
+#  define CeedXsmmGemm     libxsmm_dgemm
+#endif
+
+// Largest dimension of a tensor basis
+#define CEED_XSMM_MAX_DIM 3
+
+typedef struct {
+  CeedInt blksize;       /// Elements per block of the delegate backend
+} Ceed_Xsmm;
 
 typedef struct {
   bool isTensor;
-  CeedInt P, Q, dim;
-  khash_t(m32) *lookup;
+  CeedInt P, Q, dim, blksize;
+  // Kernels by [tmode][add][grad][step], where step is the direction of a
+  //   tensor basis contraction, with C = blksize J^step, and 0 otherwise
+  CeedXsmmFunction kernels[2][2][2][CEED_XSMM_MAX_DIM];
 } CeedTensorContract_Xsmm;
 
 CEED_INTERN int CeedTensorContractCreate_Xsmm(CeedBasis basis,
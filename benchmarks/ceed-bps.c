@@ -0,0 +1,438 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+//                    libCEED Standalone Benchmark Problems
+//
+// This driver measures the throughput of the operator action for the CEED
+// benchmark problems BP1-BP6 on structured hexahedral meshes of the unit cube,
+// sweeping over backends, polynomial degrees, and problem sizes.  Unlike the
+// PETSc based benchmarks in this directory, it has no dependencies besides
+// libCEED and runs on a single process.
+//
+//   BP1, BP2: scalar and vector mass operator, Gauss quadrature with q = p+2
+//   BP3, BP4: scalar and vector Poisson operator, Gauss quadrature with q = p+2
+//   BP5, BP6: scalar and vector Poisson operator, Gauss-Lobatto quadrature
+//             collocated with the nodes, q = p+1
+//
+// All operators use the gallery QFunctions.  By default the geometric factors
+// are computed once and stored at the quadrature points; with -fused they are
+// recomputed from the element coordinates at each application instead, which
+// trades flops for the memory traffic of the quadrature data.
+//
+// Results are reported in DoFs
+// times operator applications per second, and can be written as JSON records,
+// one per line, that postprocess_plot.py and postprocess_table.py can read.
+//
+// Build and run with:
+//
+//     make bench BACKENDS="/cpu/self/ref/serial /cpu/self/opt/blocked"
+//     make bench BENCH_OPTS="-b 1,3 -p 1:8 -s 1000:1000000"
+//
+// Sample runs:
+//
+//     ./ceed-bps -c /cpu/self -b 1,3 -p 1:8
+//     ./ceed-bps -c "/cpu/self/ref/serial /cpu/self/avx/blocked" -json out.json
+//     ./ceed-bps -c /cpu/self/opt/blocked -b 5 -p 4 -s 1000:1000000 -t 1
+//     ./ceed-bps -c /cpu/self/avx/blocked -b 3 -p 1:8 -fused
+
+/// @file
+/// Standalone libCEED driver for the CEED benchmark problems BP1-BP6
+
+#define _POSIX_C_SOURCE 200112
+#include <ceed.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_LIST 64
+
+// Auxiliary functions.
+static double WallTime(void);
+static int ParseIntList(const char *str, int list[MAX_LIST]);
+static int GetCartesianMeshSize(int order, int prob_size, int nxyz[3]);
+static int BuildCartesianRestriction(Ceed ceed, int nxyz[3], int order,
+                                     int ncomp, int num_qpts, CeedInt *size,
+                                     CeedElemRestriction *restr,
+                                     CeedElemRestriction *restr_i);
+static int SetCartesianMeshCoords(int nxyz[3], CeedVector mesh_coords);
+static int RunBenchmark(const char *ceed_spec, int bp, int degree,
+                        int nxyz[3], int fused, double min_time,
+                        FILE *json);
+
+int main(int argc, const char *argv[]) {
+  char ceed_specs[4096] = "/cpu/self";
+  const char *bp_list = "1:6", *degree_list = "1:8", *json_file = NULL;
+  int min_size = 1000, max_size = 256*1024;
+  double min_time = 0.1;
+  int fused = 0, help = 0;
+
+  // Process command line arguments.
+  for (int ia = 1; ia < argc; ia++) {
+    int next_arg = ((ia+1) < argc), parse_error = 0;
+    if (!strcmp(argv[ia],"-h")) {
+      help = 1;
+    } else if (!strcmp(argv[ia],"-c") || !strcmp(argv[ia],"-ceed")) {
+      parse_error = next_arg ? snprintf(ceed_specs, sizeof ceed_specs, "%s",
+                                        argv[++ia]), 0 : 1;
+    } else if (!strcmp(argv[ia],"-b")) {
+      parse_error = next_arg ? bp_list = argv[++ia], 0 : 1;
+    } else if (!strcmp(argv[ia],"-p")) {
+      parse_error = next_arg ? degree_list = argv[++ia], 0 : 1;
+    } else if (!strcmp(argv[ia],"-s")) {
+      parse_error = next_arg ? sscanf(argv[++ia], "%d:%d", &min_size,
+                                      &max_size) < 1 : 1;
+      if (!parse_error && !strchr(argv[ia], ':')) max_size = min_size;
+    } else if (!strcmp(argv[ia],"-fused")) {
+      fused = 1;
+    } else if (!strcmp(argv[ia],"-t")) {
+      parse_error = next_arg ? min_time = atof(argv[++ia]), 0 : 1;
+    } else if (!strcmp(argv[ia],"-json")) {
+      parse_error = next_arg ? json_file = argv[++ia], 0 : 1;
+    } else {
+      parse_error = 1;
+    }
+    if (parse_error) {
+      printf("Error parsing command line options.\n");
+      return 1;
+    }
+  }
+
+  int bps[MAX_LIST], degrees[MAX_LIST];
+  int num_bps = ParseIntList(bp_list, bps);
+  int num_degrees = ParseIntList(degree_list, degrees);
+  for (int i = 0; i < num_bps; i++)
+    if (bps[i] < 1 || bps[i] > 6) {
+      printf("Unknown benchmark problem: bp%d\n", bps[i]);
+      return 1;
+    }
+  for (int i = 0; i < num_degrees; i++)
+    if (degrees[i] < 1) {
+      printf("Invalid polynomial degree: %d\n", degrees[i]);
+      return 1;
+    }
+  if (min_size < 1 || max_size < min_size) {
+    printf("Invalid problem size range: %d:%d\n", min_size, max_size);
+    return 1;
+  }
+
+  // Print the values of all options:
+  printf("Selected options: [command line option] : <current value>\n");
+  printf("  Ceed specifications  [-c] : %s\n", ceed_specs);
+  printf("  Benchmark problems   [-b] : %s\n", bp_list);
+  printf("  Polynomial degrees   [-p] : %s\n", degree_list);
+  printf("  Approx. # unknowns   [-s] : %d:%d\n", min_size, max_size);
+  printf("  Fused geometry   [-fused] : %s\n", fused ? "yes" : "no");
+  printf("  Min. time per run    [-t] : %g s\n", min_time);
+  printf("  JSON output       [-json] : %s\n", json_file ? json_file : "none");
+  if (help) {
+    printf("Lists may be given as ranges \"1:6\" or as \"1,3,5\"\n");
+    return 0;
+  }
+  printf("\n");
+
+  FILE *json = NULL;
+  if (json_file) {
+    json = strcmp(json_file, "-") ? fopen(json_file, "w") : stdout;
+    if (!json) {
+      printf("Unable to open JSON output file: %s\n", json_file);
+      return 1;
+    }
+  }
+
+  // Sweep over backends, problems, degrees, and sizes.
+  printf("%-24s %-4s %3s %3s %10s %10s %8s %12s %12s\n", "backend", "bp", "p",
+         "q", "elements", "DoFs", "applies", "s/apply", "DoFs/s");
+  for (char *ceed_spec = strtok(ceed_specs, ", "); ceed_spec;
+       ceed_spec = strtok(NULL, ", "))
+    for (int b = 0; b < num_bps; b++)
+      for (int d = 0; d < num_degrees; d++) {
+        const int ncomp = (bps[b] % 2) ? 1 : 3;
+        int last_num_elem = 0;
+        for (int prob_size = min_size; prob_size <= max_size; prob_size *= 2) {
+          // Small sizes may round to the same mesh
+          int nxyz[3];
+          GetCartesianMeshSize(degrees[d], prob_size / ncomp, nxyz);
+          if (nxyz[0]*nxyz[1]*nxyz[2] == last_num_elem) continue;
+          last_num_elem = nxyz[0]*nxyz[1]*nxyz[2];
+
+          int ierr = RunBenchmark(ceed_spec, bps[b], degrees[d], nxyz, fused,
+                                  min_time, json);
+          if (ierr) return ierr;
+        }
+      }
+
+  if (json && json != stdout)
+    fclose(json);
+  return 0;
+}
+
+// Run a single benchmark problem on one backend and report its throughput.
+static int RunBenchmark(const char *ceed_spec, int bp, int degree,
+                        int nxyz[3], int fused, double min_time,
+                        FILE *json) {
+  const int dim = 3;
+  const int ncomp = (bp % 2) ? 1 : 3;
+  const int is_mass = bp <= 2;
+  const int num_qpts = bp <= 4 ? degree + 2 : degree + 1;
+  const CeedQuadMode quad_mode = bp <= 4 ? CEED_GAUSS : CEED_GAUSS_LOBATTO;
+  const int qdata_size = is_mass ? 1 : dim*(dim+1)/2;
+
+  Ceed ceed;
+  CeedInit(ceed_spec, &ceed);
+
+  // Mesh and solution bases, the mesh is trilinear.
+  CeedBasis mesh_basis, sol_basis;
+  CeedBasisCreateTensorH1Lagrange(ceed, dim, dim, 2, num_qpts, quad_mode,
+                                  &mesh_basis);
+  CeedBasisCreateTensorH1Lagrange(ceed, dim, ncomp, degree+1, num_qpts,
+                                  quad_mode, &sol_basis);
+
+  // Mesh restrictions and coordinates.
+  CeedInt num_elem = nxyz[0]*nxyz[1]*nxyz[2];
+  CeedInt mesh_size, sol_size, qdata_restr_size;
+  CeedElemRestriction mesh_restr, sol_restr, qdata_restr;
+  BuildCartesianRestriction(ceed, nxyz, 1, dim, num_qpts, &mesh_size,
+                            &mesh_restr, NULL);
+  BuildCartesianRestriction(ceed, nxyz, degree, ncomp, num_qpts, &sol_size,
+                            &sol_restr, NULL);
+  BuildCartesianRestriction(ceed, nxyz, degree, qdata_size, num_qpts,
+                            &qdata_restr_size, NULL, &qdata_restr);
+  CeedVector mesh_coords;
+  CeedVectorCreate(ceed, mesh_size, &mesh_coords);
+  SetCartesianMeshCoords(nxyz, mesh_coords);
+
+  // Operator computing the quadrature data, unless it is fused into the
+  // operator for the benchmark problem.
+  char build_name[16], apply_name[32];
+  snprintf(build_name, sizeof build_name, is_mass ? "Mass%dDBuild" :
+           "Poisson%dDBuild", dim);
+  snprintf(apply_name, sizeof apply_name, "%s%s%s", ncomp > 1 ? "Vector3" : "",
+           is_mass ? (fused ? "Mass3D" : "Mass") : "Poisson3D",
+           fused ? "FusedApply" : "Apply");
+  CeedQFunction qf_build = NULL, qf_apply;
+  CeedOperator op_build = NULL, op_apply;
+  CeedVector qdata = NULL;
+  CeedQFunctionCreateInteriorByName(ceed, apply_name, &qf_apply);
+  if (!fused) {
+    CeedQFunctionCreateInteriorByName(ceed, build_name, &qf_build);
+    CeedOperatorCreate(ceed, qf_build, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                       &op_build);
+    CeedOperatorSetField(op_build, "dx", mesh_restr, mesh_basis,
+                         CEED_VECTOR_ACTIVE);
+    CeedOperatorSetField(op_build, "weights", CEED_ELEMRESTRICTION_NONE,
+                         mesh_basis, CEED_VECTOR_NONE);
+    CeedOperatorSetField(op_build, "qdata", qdata_restr, CEED_BASIS_COLLOCATED,
+                         CEED_VECTOR_ACTIVE);
+
+    CeedVectorCreate(ceed, num_elem*CeedIntPow(num_qpts, dim)*qdata_size,
+                     &qdata);
+    CeedOperatorApply(op_build, mesh_coords, qdata, CEED_REQUEST_IMMEDIATE);
+  }
+
+  // Operator for the benchmark problem.
+  const char *u_name = is_mass ? "u" : "du", *v_name = is_mass ? "v" : "dv";
+  CeedOperatorCreate(ceed, qf_apply, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_apply);
+  if (fused) {
+    CeedOperatorSetField(op_apply, "dx", mesh_restr, mesh_basis, mesh_coords);
+    CeedOperatorSetField(op_apply, "weights", CEED_ELEMRESTRICTION_NONE,
+                         mesh_basis, CEED_VECTOR_NONE);
+  }
+  CeedOperatorSetField(op_apply, u_name, sol_restr, sol_basis,
+                       CEED_VECTOR_ACTIVE);
+  if (!fused)
+    CeedOperatorSetField(op_apply, "qdata", qdata_restr, CEED_BASIS_COLLOCATED,
+                         qdata);
+  CeedOperatorSetField(op_apply, v_name, sol_restr, sol_basis,
+                       CEED_VECTOR_ACTIVE);
+
+  CeedVector u, v;
+  CeedVectorCreate(ceed, sol_size, &u);
+  CeedVectorCreate(ceed, sol_size, &v);
+  CeedVectorSetValue(u, 1.0);
+
+  // Check the operator on a constant: 1^T M 1 is the volume of the unit cube
+  // for each component, and the Poisson operator annihilates constants.
+  CeedOperatorApply(op_apply, u, v, CEED_REQUEST_IMMEDIATE);
+  const CeedScalar *v_host;
+  CeedVectorGetArrayRead(v, CEED_MEM_HOST, &v_host);
+  CeedScalar sum = 0.;
+  for (CeedInt i = 0; i < sol_size; i++)
+    sum += v_host[i];
+  CeedVectorRestoreArrayRead(v, &v_host);
+  const CeedScalar expected = is_mass ? ncomp : 0.;
+  if (fabs(sum - expected) > 1e-8*sol_size)
+    printf("Warning: %s bp%d p=%d: 1^T A 1 = %g, expected %g\n", ceed_spec,
+           bp, degree, sum, expected);
+
+  // Time repeated applications until the minimum time has elapsed.
+  int applies = 0;
+  double start = WallTime(), elapsed;
+  do {
+    CeedOperatorApply(op_apply, u, v, CEED_REQUEST_IMMEDIATE);
+    applies++;
+    elapsed = WallTime() - start;
+  } while (elapsed < min_time);
+  const double time_per_apply = elapsed / applies;
+  const double dps = sol_size / time_per_apply;
+
+  printf("%-24s bp%-2d %3d %3d %10d %10d %8d %12.4e %12.4e\n", ceed_spec, bp,
+         degree, num_qpts, num_elem, sol_size, applies, time_per_apply, dps);
+  fflush(stdout);
+
+  if (json) {
+    char hostname[256] = "unknown";
+    gethostname(hostname, sizeof hostname);
+    hostname[sizeof hostname - 1] = '\0';
+    CeedMemType mem_type;
+    CeedGetPreferredMemType(ceed, &mem_type);
+    fprintf(json, "{\"code\": \"libCEED\", \"backend\": \"%s\", "
+            "\"backend_memtype\": \"%s\", \"hostname\": \"%s\", "
+            "\"test\": \"CEED Benchmark Problem %d\", \"bp\": \"bp%d\", "
+            "\"case\": \"%s\", \"geometry\": \"%s\", \"num_procs\": 1, "
+            "\"num_procs_node\": 1, \"degree\": %d, \"quadrature_pts\": %d, "
+            "\"num_elem\": %d, \"num_unknowns\": %d, \"dof_per_node\": %d, "
+            "\"applies\": %d, \"time_per_apply\": %.6e, "
+            "\"apply_dps\": %.6e}\n", ceed_spec, CeedMemTypes[mem_type],
+            hostname, bp, bp, ncomp > 1 ? "vector" : "scalar",
+            fused ? "fused" : "stored", degree, num_qpts, num_elem, sol_size,
+            ncomp, applies, time_per_apply, dps);
+    fflush(json);
+  }
+
+  // Free dynamically allocated memory.
+  CeedVectorDestroy(&u);
+  CeedVectorDestroy(&v);
+  if (!fused) {
+    CeedVectorDestroy(&qdata);
+    CeedOperatorDestroy(&op_build);
+    CeedQFunctionDestroy(&qf_build);
+  }
+  CeedVectorDestroy(&mesh_coords);
+  CeedOperatorDestroy(&op_apply);
+  CeedQFunctionDestroy(&qf_apply);
+  CeedElemRestrictionDestroy(&sol_restr);
+  CeedElemRestrictionDestroy(&mesh_restr);
+  CeedElemRestrictionDestroy(&qdata_restr);
+  CeedBasisDestroy(&sol_basis);
+  CeedBasisDestroy(&mesh_basis);
+  CeedDestroy(&ceed);
+  return 0;
+}
+
+static double WallTime(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + 1e-9*ts.tv_nsec;
+}
+
+// Parse a list of integers given as a range "a:b" or as "a,b,c".
+static int ParseIntList(const char *str, int list[MAX_LIST]) {
+  int first, last, n = 0;
+  if (sscanf(str, "%d:%d", &first, &last) == 2) {
+    for (int i = first; i <= last && n < MAX_LIST; i++)
+      list[n++] = i;
+    return n;
+  }
+  while (*str && n < MAX_LIST) {
+    char *end;
+    list[n++] = strtol(str, &end, 10);
+    if (end == str || (*end && *end != ',')) return 0;
+    str = *end ? end + 1 : end;
+  }
+  return n;
+}
+
+static int GetCartesianMeshSize(int order, int prob_size, int nxyz[3]) {
+  // Use the approximate formula:
+  //    prob_size ~ num_elem * order^3
+  CeedInt num_elem = prob_size / CeedIntPow(order, 3);
+  CeedInt s = 0;  // find s: num_elem/2 < 2^s <= num_elem
+  while (num_elem > 1) {
+    num_elem /= 2;
+    s++;
+  }
+  CeedInt r = s%3;
+  for (int d = 0; d < 3; d++) {
+    int sd = s/3;
+    if (r > 0) { sd++; r--; }
+    nxyz[d] = 1 << sd;
+  }
+  return 0;
+}
+
+static int BuildCartesianRestriction(Ceed ceed, int nxyz[3], int order,
+                                     int ncomp, int num_qpts, CeedInt *size,
+                                     CeedElemRestriction *restr,
+                                     CeedElemRestriction *restr_i) {
+  CeedInt p = order, pp1 = p+1;
+  CeedInt nnodes = CeedIntPow(pp1, 3); // number of scal. nodes per element
+  CeedInt elem_qpts = CeedIntPow(num_qpts, 3); // number of qpts per element
+  CeedInt nd[3], num_elem = 1, scalar_size = 1;
+  for (int d = 0; d < 3; d++) {
+    num_elem *= nxyz[d];
+    nd[d] = nxyz[d]*p + 1;
+    scalar_size *= nd[d];
+  }
+  *size = scalar_size*ncomp;
+  if (restr) {
+    CeedInt *el_nodes = malloc(sizeof(CeedInt)*num_elem*nnodes);
+    for (CeedInt e = 0; e < num_elem; e++) {
+      CeedInt exyz[3], re = e;
+      for (int d = 0; d < 3; d++) { exyz[d] = re%nxyz[d]; re /= nxyz[d]; }
+      CeedInt *loc_el_nodes = el_nodes + e*nnodes;
+      for (int lnodes = 0; lnodes < nnodes; lnodes++) {
+        CeedInt gnodes = 0, gnodes_stride = 1, rnodes = lnodes;
+        for (int d = 0; d < 3; d++) {
+          gnodes += (exyz[d]*p + rnodes%pp1) * gnodes_stride;
+          gnodes_stride *= nd[d];
+          rnodes /= pp1;
+        }
+        loc_el_nodes[lnodes] = gnodes;
+      }
+    }
+    CeedElemRestrictionCreate(ceed, num_elem, nnodes, ncomp, scalar_size,
+                              ncomp*scalar_size, CEED_MEM_HOST,
+                              CEED_COPY_VALUES, el_nodes, restr);
+    free(el_nodes);
+  }
+  if (restr_i)
+    CeedElemRestrictionCreateStrided(ceed, num_elem, elem_qpts,
+                                     ncomp, ncomp*elem_qpts*num_elem,
+                                     CEED_STRIDES_BACKEND, restr_i);
+  return 0;
+}
+
+static int SetCartesianMeshCoords(int nxyz[3], CeedVector mesh_coords) {
+  CeedInt nd[3], scalar_size = 1;
+  for (int d = 0; d < 3; d++) {
+    nd[d] = nxyz[d] + 1;
+    scalar_size *= nd[d];
+  }
+  CeedScalar *coords;
+  CeedVectorGetArray(mesh_coords, CEED_MEM_HOST, &coords);
+  for (CeedInt gsnodes = 0; gsnodes < scalar_size; gsnodes++) {
+    CeedInt rnodes = gsnodes;
+    for (int d = 0; d < 3; d++) {
+      coords[gsnodes+scalar_size*d] = (CeedScalar)(rnodes%nd[d]) / nxyz[d];
+      rnodes /= nd[d];
+    }
+  }
+  CeedVectorRestoreArray(mesh_coords, &coords);
+  return 0;
+}
@@ -0,0 +1,272 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+//                 libCEED Tensor Contraction Microbenchmark
+//
+// This driver times CeedTensorContractApply() of each CPU backend directly for
+// the (A, B, C, J) shapes generated by 3D tensor product bases of degree p,
+// with P = p+1 nodes and Q = p+2 quadrature points in 1D, for both transpose
+// modes and with and without accumulation.  For each basis the shapes are the
+// three passes of the interpolation and of the collocated gradient, for one
+// element and for blocks of 8 elements, as used by serial and blocked backends.
+//
+// Throughput is reported in GFLOP/s and as a fraction of the peak of one core,
+// which is either given with -peak or measured with a loop of independent
+// fused multiply-adds, so that tiling regressions stand out.
+//
+// Build and run with:
+//
+//     make bench-tensor BACKENDS="/cpu/self/ref/serial /cpu/self/avx/serial"
+//
+// Sample runs:
+//
+//     ./ceed-tensor -c /cpu/self/avx/blocked -p 1:10
+//     ./ceed-tensor -c "/cpu/self/ref/serial /cpu/self/xsmm/serial" -peak 40
+
+/// @file
+/// Microbenchmark for the CeedTensorContract implementations of CPU backends
+
+#define _POSIX_C_SOURCE 200112
+#include <ceed.h>
+#include <ceed-backend.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAX_LIST 64
+#define PEAK_CHAINS 12
+
+// Auxiliary functions.
+static double WallTime(void);
+static int ParseIntList(const char *str, int list[MAX_LIST]);
+static double MeasurePeak(double min_time);
+static int RunContractions(const char *ceed_spec, int degree, double min_time,
+                           double peak, double *sum_log_ratio, int *num_runs);
+
+int main(int argc, const char *argv[]) {
+  char ceed_specs[4096] = "/cpu/self/ref/serial";
+  const char *degree_list = "1:10";
+  double min_time = 0.02, peak = 0.;
+  int help = 0;
+
+  // Process command line arguments.
+  for (int ia = 1; ia < argc; ia++) {
+    int next_arg = ((ia+1) < argc), parse_error = 0;
+    if (!strcmp(argv[ia],"-h")) {
+      help = 1;
+    } else if (!strcmp(argv[ia],"-c") || !strcmp(argv[ia],"-ceed")) {
+      parse_error = next_arg ? snprintf(ceed_specs, sizeof ceed_specs, "%s",
+                                        argv[++ia]), 0 : 1;
+    } else if (!strcmp(argv[ia],"-p")) {
+      parse_error = next_arg ? degree_list = argv[++ia], 0 : 1;
+    } else if (!strcmp(argv[ia],"-t")) {
+      parse_error = next_arg ? min_time = atof(argv[++ia]), 0 : 1;
+    } else if (!strcmp(argv[ia],"-peak")) {
+      parse_error = next_arg ? peak = atof(argv[++ia]), 0 : 1;
+    } else {
+      parse_error = 1;
+    }
+    if (parse_error) {
+      printf("Error parsing command line options.\n");
+      return 1;
+    }
+  }
+
+  int degrees[MAX_LIST];
+  int num_degrees = ParseIntList(degree_list, degrees);
+  for (int i = 0; i < num_degrees; i++)
+    if (degrees[i] < 1) {
+      printf("Invalid polynomial degree: %d\n", degrees[i]);
+      return 1;
+    }
+
+  // Print the values of all options:
+  printf("Selected options: [command line option] : <current value>\n");
+  printf("  Ceed specifications  [-c] : %s\n", ceed_specs);
+  printf("  Polynomial degrees   [-p] : %s\n", degree_list);
+  printf("  Min. time per shape  [-t] : %g s\n", min_time);
+  if (help) {
+    printf("  Peak GFLOP/s      [-peak] : %s\n", "measured if not given");
+    printf("Lists may be given as ranges \"1:10\" or as \"1,3,5\"\n");
+    return 0;
+  }
+  if (peak <= 0.) {
+    peak = MeasurePeak(10*min_time);
+    printf("  Peak GFLOP/s      [-peak] : %.2f (measured)\n", peak);
+  } else {
+    printf("  Peak GFLOP/s      [-peak] : %.2f\n", peak);
+  }
+  printf("\n");
+
+  // Sweep over backends and degrees.
+  printf("%-24s %3s %5s %5s %5s %5s %-5s %3s %10s %7s\n", "backend", "p", "A",
+         "B", "C", "J", "tmode", "add", "GFLOP/s", "%peak");
+  for (char *ceed_spec = strtok(ceed_specs, ", "); ceed_spec;
+       ceed_spec = strtok(NULL, ", ")) {
+    double sum_log_ratio = 0.;
+    int num_runs = 0;
+    for (int d = 0; d < num_degrees; d++) {
+      int ierr = RunContractions(ceed_spec, degrees[d], min_time, peak,
+                                 &sum_log_ratio, &num_runs);
+      if (ierr) return ierr;
+    }
+    if (num_runs)
+      printf("%-24s geometric mean over %d shapes: %.2f%% of peak\n\n",
+             ceed_spec, num_runs, 100.*exp(sum_log_ratio / num_runs));
+  }
+
+  return 0;
+}
+
+// Time the contractions of one backend for the bases of a given degree.
+static int RunContractions(const char *ceed_spec, int degree, double min_time,
+                           double peak, double *sum_log_ratio, int *num_runs) {
+  int ierr;
+  const int dim = 3, P = degree + 1, Q = degree + 2;
+
+  Ceed ceed;
+  ierr = CeedInit(ceed_spec, &ceed); CeedChk(ierr);
+  CeedBasis basis;
+  ierr = CeedBasisCreateTensorH1Lagrange(ceed, dim, 1, P, Q, CEED_GAUSS,
+                                         &basis); CeedChk(ierr);
+  // Use the contraction the backend attached to its basis
+  CeedTensorContract contract = NULL;
+  ierr = CeedBasisGetTensorContract(basis, &contract); CeedChk(ierr);
+  if (!contract) {
+    printf("%-24s has no CeedTensorContract, skipping\n", ceed_spec);
+    CeedBasisDestroy(&basis);
+    CeedDestroy(&ceed);
+    return 0;
+  }
+
+  // Shapes of the interpolation (B = P, J = Q) and collocated gradient
+  // (B = J = Q) passes, in CEED_NOTRANSPOSE orientation
+  const int Bs[2] = {P, Q}, Js[2] = {Q, Q}, nelems[2] = {1, 8};
+  const int maxsize = 8*CeedIntPow(Q, dim);
+  CeedScalar *t = calloc(Q*Q, sizeof(CeedScalar));
+  CeedScalar *u = calloc(maxsize, sizeof(CeedScalar));
+  CeedScalar *v = calloc(maxsize, sizeof(CeedScalar));
+  for (int i = 0; i < Q*Q; i++)
+    t[i] = 1. / (i + 1);
+  for (int i = 0; i < maxsize; i++)
+    u[i] = 1. / (i + 2);
+
+  for (int n = 0; n < 2; n++)
+    for (int kind = 0; kind < 2; kind++)
+      for (int tmode = 0; tmode < 2; tmode++)
+        for (int add = 0; add < 2; add++) {
+          // In transpose the roles of the input and output dimension swap
+          const int B = tmode ? Js[kind] : Bs[kind];
+          const int J = tmode ? Bs[kind] : Js[kind];
+          int A = CeedIntPow(B, dim-1), C = nelems[n];
+          for (int pass = 0; pass < dim; pass++) {
+            const double flops = 2.*A*B*C*J;
+            int reps = 0;
+            double start = WallTime(), elapsed;
+            do {
+              ierr = CeedTensorContractApply(contract, A, B, C, J, t, tmode,
+                                             add, u, v); CeedChk(ierr);
+              reps++;
+              elapsed = WallTime() - start;
+            } while (elapsed < min_time);
+            const double gflops = 1e-9*flops*reps / elapsed;
+            printf("%-24s %3d %5d %5d %5d %5d %-5s %3d %10.3f %6.2f%%\n",
+                   ceed_spec, degree, A, B, C, J, tmode ? "T" : "N", add,
+                   gflops, 100.*gflops / peak);
+            *sum_log_ratio += log(gflops / peak);
+            (*num_runs)++;
+            A /= B;
+            C *= J;
+          }
+        }
+  fflush(stdout);
+
+  free(t);
+  free(u);
+  free(v);
+  ierr = CeedBasisDestroy(&basis); CeedChk(ierr);
+  ierr = CeedDestroy(&ceed); CeedChk(ierr);
+  return 0;
+}
+
+// Measure the peak floating point throughput of one core, in GFLOP/s, with
+// independent chains of fused multiply-adds on the widest vectors available.
+// The Makefile compiles this driver with floating point contraction enabled.
+#if defined(__GNUC__)
+typedef CeedScalar PeakVec __attribute__((vector_size(8*sizeof(CeedScalar))));
+#else
+typedef CeedScalar PeakVec;
+#endif
+static double MeasurePeak(double min_time) {
+  const int lanes = sizeof(PeakVec) / sizeof(CeedScalar);
+  const PeakVec a = {0}, b = {0};
+  PeakVec acc[PEAK_CHAINS];
+  for (int k = 0; k < PEAK_CHAINS; k++)
+    acc[k] = a + (CeedScalar)k;
+
+  long iters = 0;
+  double start = WallTime(), elapsed;
+  do {
+    // Unrolled so the chains stay in registers
+    PeakVec c0 = acc[0], c1 = acc[1], c2 = acc[2], c3 = acc[3], c4 = acc[4],
+            c5 = acc[5], c6 = acc[6], c7 = acc[7], c8 = acc[8], c9 = acc[9],
+            c10 = acc[10], c11 = acc[11];
+    const PeakVec x = a + (CeedScalar)0.999999, y = b + (CeedScalar)1e-6;
+    for (int it = 0; it < 1024; it++) {
+      c0 = c0*x + y; c1 = c1*x + y; c2 = c2*x + y; c3 = c3*x + y;
+      c4 = c4*x + y; c5 = c5*x + y; c6 = c6*x + y; c7 = c7*x + y;
+      c8 = c8*x + y; c9 = c9*x + y; c10 = c10*x + y; c11 = c11*x + y;
+    }
+    acc[0] = c0; acc[1] = c1; acc[2] = c2; acc[3] = c3; acc[4] = c4;
+    acc[5] = c5; acc[6] = c6; acc[7] = c7; acc[8] = c8; acc[9] = c9;
+    acc[10] = c10; acc[11] = c11;
+    iters += 1024;
+    elapsed = WallTime() - start;
+  } while (elapsed < min_time);
+
+  // Keep the result alive
+  CeedScalar sum = 0.;
+  for (int k = 0; k < PEAK_CHAINS; k++)
+    for (int l = 0; l < lanes; l++)
+      sum += ((CeedScalar *)&acc[k])[l];
+  if (sum == 42.)
+    printf("\n");
+  return 1e-9*2.*lanes*PEAK_CHAINS*iters / elapsed;
+}
+
+static double WallTime(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + 1e-9*ts.tv_nsec;
+}
+
+// Parse a list of integers given as a range "a:b" or as "a,b,c".
+static int ParseIntList(const char *str, int list[MAX_LIST]) {
+  int first, last, n = 0;
+  if (sscanf(str, "%d:%d", &first, &last) == 2) {
+    for (int i = first; i <= last && n < MAX_LIST; i++)
+      list[n++] = i;
+    return n;
+  }
+  while (*str && n < MAX_LIST) {
+    char *end;
+    list[n++] = strtol(str, &end, 10);
+    if (end == str || (*end && *end != ',')) return 0;
+    str = *end ? end + 1 : end;
+  }
+  return n;
+}
@@ -17,6 +17,7 @@
 
 import pandas as pd
 import fileinput
+import json
 import pprint
 
 # Read all input files specified on the command line, or stdin and parse
@@ -41,8 +42,17 @@ def read_logs(files=None):
 
     runs = []
     for line in fileinput.input(files):
+        # JSON record from the standalone ceed-bps driver, one run per line
+        if line.startswith('{'):
+            run = data_default.copy()
+            run.update(json.loads(line))
+            run['file'] = fileinput.filename()
+            # Operator applications take the place of CG iterations
+            run['cg_iteration_dps'] = run['apply_dps']
+            runs.append(run)
+            data = data_default.copy()
         # Legacy header contains number of MPI tasks
-        if 'Running the tests using a total of' in line:
+        elif 'Running the tests using a total of' in line:
             data = data_default.copy()
             data['num_procs'] = int(
                 line.split(
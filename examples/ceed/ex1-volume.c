@@ -284,7 +284,8 @@ int main(int argc, const char *argv[]) {
     printf("Computed mesh volume : % .14g\n", vol);
     printf("Volume error         : % .14g\n", vol-exact_vol);
   } else {
-    CeedScalar tol = (dim==1? 1E-14 : dim==2? 1E-7 : 1E-5);
+    // Quadrature error, but no tighter than the round-off of the sum
+    CeedScalar tol = fmax(dim==1? 0. : dim==2? 1E-7 : 1E-5, 100.*CEED_EPSILON);
     if (fabs(vol-exact_vol)>tol)
       printf("Volume error : % .1e\n", vol-exact_vol);
   }
@@ -307,7 +307,7 @@ int main(int argc, const char *argv[]) {
     printf("Computed mesh surface area : % .14g\n", sa);
     printf("Surface area error         : % .14g\n", sa-exact_sa);
   } else {
-    CeedScalar tol = (dim==1? 1E-12 : dim==2? 1E-1 : 1E-1);
+    CeedScalar tol = (dim==1? 1E4*CEED_EPSILON : dim==2? 1E-1 : 1E-1);
     if (fabs(sa-exact_sa)>tol)
       printf("Surface area error         : % .14g\n", sa-exact_sa);
   }
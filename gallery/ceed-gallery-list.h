@@ -13,6 +13,7 @@ MACRO(CeedQFunctionRegister_Identity)
 MACRO(CeedQFunctionRegister_Mass1DBuild)
 MACRO(CeedQFunctionRegister_Mass2DBuild)
 MACRO(CeedQFunctionRegister_Mass3DBuild)
+MACRO(CeedQFunctionRegister_Mass3DFusedApply)
 MACRO(CeedQFunctionRegister_MassApply)
 MACRO(CeedQFunctionRegister_Poisson1DApply)
 MACRO(CeedQFunctionRegister_Poisson1DBuild)
@@ -20,5 +21,10 @@ MACRO(CeedQFunctionRegister_Poisson2DApply)
 MACRO(CeedQFunctionRegister_Poisson2DBuild)
 MACRO(CeedQFunctionRegister_Poisson3DApply)
 MACRO(CeedQFunctionRegister_Poisson3DBuild)
+MACRO(CeedQFunctionRegister_Poisson3DFusedApply)
 MACRO(CeedQFunctionRegister_Scale)
 MACRO(CeedQFunctionRegister_Template)
+MACRO(CeedQFunctionRegister_Vector3Mass3DFusedApply)
+MACRO(CeedQFunctionRegister_Vector3MassApply)
+MACRO(CeedQFunctionRegister_Vector3Poisson3DApply)
+MACRO(CeedQFunctionRegister_Vector3Poisson3DFusedApply)
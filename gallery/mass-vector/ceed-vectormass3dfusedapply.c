@@ -0,0 +1,62 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#include <string.h>
+#include "ceed-backend.h"
+#include "ceed-vectormass3dfusedapply.h"
+
+/**
+  @brief Set fields for Ceed QFunction applying the 3D mass matrix on a vector
+           system with three components, with the geometric data computed at
+           each application
+**/
+static int CeedQFunctionInit_Vector3Mass3DFusedApply(Ceed ceed,
+    const char *requested, CeedQFunction qf) {
+  int ierr;
+
+  // Check QFunction name
+  const char *name = "Vector3Mass3DFusedApply";
+  if (strcmp(name, requested))
+    // LCOV_EXCL_START
+    return CeedError(ceed, 1, "QFunction '%s' does not match requested name: %s",
+                     name, requested);
+  // LCOV_EXCL_STOP
+
+  // Add QFunction fields
+  const CeedInt dim = 3, ncomp = 3;
+  ierr = CeedQFunctionAddInput(qf, "dx", dim*dim, CEED_EVAL_GRAD);
+  CeedChk(ierr);
+  ierr = CeedQFunctionAddInput(qf, "weights", 1, CEED_EVAL_WEIGHT);
+  CeedChk(ierr);
+  ierr = CeedQFunctionAddInput(qf, "u", ncomp, CEED_EVAL_INTERP);
+  CeedChk(ierr);
+  ierr = CeedQFunctionAddOutput(qf, "v", ncomp, CEED_EVAL_INTERP);
+  CeedChk(ierr);
+
+  return 0;
+}
+
+/**
+  @brief Register Ceed QFunction for applying the 3D mass matrix on a vector
+           system with three components, with the geometric data computed at
+           each application
+**/
+CEED_INTERN int CeedQFunctionRegister_Vector3Mass3DFusedApply(void) {
+  return CeedQFunctionRegister("Vector3Mass3DFusedApply",
+                               Vector3Mass3DFusedApply_loc, 1,
+                               Vector3Mass3DFusedApply,
+                               CeedQFunctionInit_Vector3Mass3DFusedApply);
+}
@@ -0,0 +1,49 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+/**
+  @brief Ceed QFunction for applying the 3D mass matrix with the geometric
+           data computed from the element coordinates at each application
+**/
+
+#ifndef mass3dfusedapply_h
+#define mass3dfusedapply_h
+
+CEED_QFUNCTION(Mass3DFusedApply)(void *ctx, const CeedInt Q,
+                                 const CeedScalar *const *in,
+                                 CeedScalar *const *out) {
+  // in[0] is Jacobians with shape [3, nc=3, Q]
+  // in[1] is quadrature weights, size (Q)
+  // in[2] is u, size (Q)
+  const CeedScalar *J = in[0], *qw = in[1], *u = in[2];
+  // out[0] is v, size (Q)
+  CeedScalar *v = out[0];
+
+  // Quadrature point loop
+  CeedPragmaSIMD
+  for (CeedInt i=0; i<Q; i++) {
+    // Same geometric factor as Mass3DBuild, never stored
+    const CeedScalar qd = (J[i+Q*0]*(J[i+Q*4]*J[i+Q*8] - J[i+Q*5]*J[i+Q*7]) -
+                           J[i+Q*1]*(J[i+Q*3]*J[i+Q*8] - J[i+Q*5]*J[i+Q*6]) +
+                           J[i+Q*2]*(J[i+Q*3]*J[i+Q*7] - J[i+Q*4]*J[i+Q*6])) *
+                          qw[i];
+    v[i] = u[i] * qd;
+  } // End of Quadrature Point Loop
+
+  return 0;
+}
+
+#endif // mass3dfusedapply_h
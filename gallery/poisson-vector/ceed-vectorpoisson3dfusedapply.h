@@ -0,0 +1,76 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+/**
+  @brief Ceed QFunction for applying the 3D Poisson operator on a vector system
+           with three components, with the geometric data computed from the
+           element coordinates at each application
+**/
+
+#ifndef vectorpoisson3dfusedapply_h
+#define vectorpoisson3dfusedapply_h
+
+CEED_QFUNCTION(Vector3Poisson3DFusedApply)(void *ctx, const CeedInt Q,
+                                           const CeedScalar *const *in,
+                                           CeedScalar *const *out) {
+  // in[0] is Jacobians with shape [3, nc=3, Q]
+  // in[1] is quadrature weights, size (Q)
+  // in[2] is gradient u, shape [3, ncomp=3, Q]
+  const CeedScalar *J = in[0], *qw = in[1], *ug = in[2];
+
+  // out[0] is output to multiply against gradient v, shape [3, ncomp=3, Q]
+  CeedScalar *vg = out[0];
+
+  // Quadrature point loop
+  CeedPragmaSIMD
+  for (CeedInt i=0; i<Q; i++) {
+    // Compute the adjoint
+    CeedScalar A[3][3];
+    for (CeedInt j=0; j<3; j++)
+      for (CeedInt k=0; k<3; k++)
+        A[k][j] = J[i+Q*((j+1)%3+3*((k+1)%3))]*J[i+Q*((j+2)%3+3*((k+2)%3))] -
+                  J[i+Q*((j+1)%3+3*((k+2)%3))]*J[i+Q*((j+2)%3+3*((k+1)%3))];
+
+    // Compute quadrature weight / det(J)
+    const CeedScalar w = qw[i] / (J[i+Q*0]*A[0][0] + J[i+Q*1]*A[1][1] +
+                                  J[i+Q*2]*A[2][2]);
+
+    // Compute geometric factors once for all components
+    CeedScalar dXdxdXdxT[3][3];
+    for (CeedInt j=0; j<3; j++)
+      for (CeedInt k=0; k<3; k++)
+        dXdxdXdxT[j][k] = w * (A[j][0]*A[k][0] + A[j][1]*A[k][1] +
+                               A[j][2]*A[k][2]);
+
+    // Apply Poisson Operator to each component
+    for (int c=0; c<3; c++) {
+      // Read spatial derivatives of component c of u
+      const CeedScalar du[3] = {ug[i+(c+0*3)*Q],
+                                ug[i+(c+1*3)*Q],
+                                ug[i+(c+2*3)*Q]
+                               };
+      // j = direction of vg
+      for (int j=0; j<3; j++)
+        vg[i+(c+j*3)*Q] = (du[0] * dXdxdXdxT[0][j] +
+                           du[1] * dXdxdXdxT[1][j] +
+                           du[2] * dXdxdXdxT[2][j]);
+    }
+  } // End of Quadrature Point Loop
+
+  return 0;
+}
+
+#endif // vectorpoisson3dfusedapply_h
@@ -0,0 +1,65 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+/**
+  @brief Ceed QFunction for applying the 3D Poisson operator with the geometric
+           data computed from the element coordinates at each application
+**/
+
+#ifndef poisson3dfusedapply_h
+#define poisson3dfusedapply_h
+
+CEED_QFUNCTION(Poisson3DFusedApply)(void *ctx, const CeedInt Q,
+                                    const CeedScalar *const *in,
+                                    CeedScalar *const *out) {
+  // At every quadrature point, compute qw/det(J).adj(J).adj(J)^T as in
+  // Poisson3DBuild and apply it to the gradient of u without storing it.
+
+  // in[0] is Jacobians with shape [3, nc=3, Q]
+  // in[1] is quadrature weights, size (Q)
+  // in[2] is gradient u, shape [3, Q]
+  const CeedScalar *J = in[0], *qw = in[1], *ug = in[2];
+
+  // out[0] is output to multiply against gradient v, shape [3, Q]
+  CeedScalar *vg = out[0];
+
+  // Quadrature point loop
+  CeedPragmaSIMD
+  for (CeedInt i=0; i<Q; i++) {
+    // Compute the adjoint
+    CeedScalar A[3][3];
+    for (CeedInt j=0; j<3; j++)
+      for (CeedInt k=0; k<3; k++)
+        A[k][j] = J[i+Q*((j+1)%3+3*((k+1)%3))]*J[i+Q*((j+2)%3+3*((k+2)%3))] -
+                  J[i+Q*((j+1)%3+3*((k+2)%3))]*J[i+Q*((j+2)%3+3*((k+1)%3))];
+
+    // Compute quadrature weight / det(J)
+    const CeedScalar w = qw[i] / (J[i+Q*0]*A[0][0] + J[i+Q*1]*A[1][1] +
+                                  J[i+Q*2]*A[2][2]);
+
+    // Apply adj(J)^T, then w adj(J)
+    const CeedScalar du[3] = {ug[i+Q*0], ug[i+Q*1], ug[i+Q*2]};
+    CeedScalar Adu[3];
+    for (CeedInt l=0; l<3; l++)
+      Adu[l] = w * (A[0][l]*du[0] + A[1][l]*du[1] + A[2][l]*du[2]);
+    for (CeedInt j=0; j<3; j++)
+      vg[i+Q*j] = A[j][0]*Adu[0] + A[j][1]*Adu[1] + A[j][2]*Adu[2];
+  } // End of Quadrature Point Loop
+
+  return 0;
+}
+
+#endif // poisson3dfusedapply_h
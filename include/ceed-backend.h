@@ -28,7 +28,6 @@
 #define CEED_MAX_RESOURCE_LEN 1024
 #define CEED_ALIGN 64
 #define CEED_COMPOSITE_MAX 16
-#define CEED_EPSILON 1E-16
 
 /// CEED_DEBUG_COLOR default value, forward CeedDebug* declarations & macros
 #ifndef CEED_DEBUG_COLOR
@@ -45,12 +44,11 @@ CEED_EXTERN void CeedDebugImpl256(const Ceed,const unsigned char,const char *,
 /// @ingroup CeedBasis
 typedef struct CeedTensorContract_private *CeedTensorContract;
 
-/* In the next 3 functions, p has to be the address of a pointer type, i.e. p
-   has to be a pointer to a pointer. */
+/* In the next 3 functions and CeedFree(), p has to be the address of a pointer
+   type, i.e. p has to be a pointer to a pointer. */
 CEED_INTERN int CeedMallocArray(size_t n, size_t unit, void *p);
 CEED_INTERN int CeedCallocArray(size_t n, size_t unit, void *p);
 CEED_INTERN int CeedReallocArray(size_t n, size_t unit, void *p);
-CEED_INTERN int CeedFree(void *p);
 
 #define CeedChk(ierr) do { int ierr_ = ierr; if (ierr_) return ierr_; } while (0)
 /* Note that CeedMalloc and CeedCalloc will, generally, return pointers with
@@ -71,6 +69,11 @@ CEED_EXTERN int CeedRegister(const char *prefix,
                              int (*init)(const char *, Ceed),
                              unsigned int priority);
 CEED_EXTERN int CeedRegisterAll(void);
+CEED_EXTERN int CeedIsRegistered(const char *prefix, bool *isregistered);
+CEED_EXTERN int CeedGetResourceRoot(Ceed ceed, const char *resource,
+                                    char **root);
+CEED_EXTERN int CeedGetResourceQueryInt(Ceed ceed, const char *resource,
+                                        const char *key, CeedInt *value);
 
 CEED_EXTERN int CeedIsDebug(Ceed ceed, bool *isDebug);
 CEED_EXTERN int CeedGetParent(Ceed ceed, Ceed *parent);
@@ -91,6 +94,9 @@ CEED_EXTERN int CeedSetBackendFunction(Ceed ceed,
                                        const char *fname, int (*f)());
 CEED_EXTERN int CeedGetData(Ceed ceed, void *data);
 CEED_EXTERN int CeedSetData(Ceed ceed, void *data);
+CEED_EXTERN int CeedGetWorkArray(Ceed ceed, CeedInt length,
+                                 CeedScalar **array);
+CEED_EXTERN int CeedRestoreWorkArray(Ceed ceed, CeedScalar **array);
 
 CEED_EXTERN int CeedVectorGetCeed(CeedVector vec, Ceed *ceed);
 CEED_EXTERN int CeedVectorGetState(CeedVector vec, uint64_t *state);
@@ -118,6 +124,8 @@ CEED_EXTERN int CeedElemRestrictionGetData(CeedElemRestriction rstr,
     void *data);
 CEED_EXTERN int CeedElemRestrictionSetData(CeedElemRestriction rstr,
     void *data);
+CEED_EXTERN int CeedElemRestrictionGetColoring(CeedElemRestriction rstr,
+    CeedInt *ncolors, const CeedInt **colorptr, const CeedInt **colorblks);
 
 CEED_EXTERN int CeedBasisGetCollocatedGrad(CeedBasis basis,
     CeedScalar *colograd1d);
@@ -126,6 +134,8 @@ CEED_EXTERN int CeedHouseholderApplyQ(CeedScalar *A, const CeedScalar *Q,
                                       CeedInt k, CeedInt row, CeedInt col);
 CEED_EXTERN int CeedBasisGetCeed(CeedBasis basis, Ceed *ceed);
 CEED_EXTERN int CeedBasisIsTensor(CeedBasis basis, bool *istensor);
+CEED_EXTERN int CeedBasisGetFlopsEstimate(CeedBasis basis,
+    CeedTransposeMode tmode, CeedEvalMode emode, CeedInt *flops);
 CEED_EXTERN int CeedBasisGetData(CeedBasis basis, void *data);
 CEED_EXTERN int CeedBasisSetData(CeedBasis basis, void *data);
 
@@ -171,6 +181,9 @@ CEED_EXTERN int CeedQFunctionGetContext(CeedQFunction qf,
 CEED_EXTERN int CeedQFunctionGetInnerContext(CeedQFunction qf,
     CeedQFunctionContext *ctx);
 CEED_EXTERN int CeedQFunctionIsIdentity(CeedQFunction qf, bool *isidentity);
+CEED_EXTERN int CeedQFunctionCreateCopy(CeedQFunction qf,
+                                        CeedQFunctionContext innerctx,
+                                        CeedQFunction *qfcopy);
 CEED_EXTERN int CeedQFunctionGetData(CeedQFunction qf, void *data);
 CEED_EXTERN int CeedQFunctionSetData(CeedQFunction qf, void *data);
 CEED_EXTERN int CeedQFunctionGetFields(CeedQFunction qf,
@@ -202,12 +215,16 @@ CEED_EXTERN int CeedOperatorGetNumArgs(CeedOperator op, CeedInt *numargs);
 CEED_EXTERN int CeedOperatorIsSetupDone(CeedOperator op, bool *issetupdone);
 CEED_EXTERN int CeedOperatorGetQFunction(CeedOperator op, CeedQFunction *qf);
 CEED_EXTERN int CeedOperatorIsComposite(CeedOperator op, bool *iscomposite);
+CEED_EXTERN int CeedOperatorIsProfiling(CeedOperator op, bool *isprofiling);
 CEED_EXTERN int CeedOperatorGetNumSub(CeedOperator op, CeedInt *numsub);
 CEED_EXTERN int CeedOperatorGetSubList(CeedOperator op,
                                        CeedOperator **suboperators);
 CEED_EXTERN int CeedOperatorGetData(CeedOperator op, void *data);
 CEED_EXTERN int CeedOperatorSetData(CeedOperator op, void *data);
 CEED_EXTERN int CeedOperatorSetSetupDone(CeedOperator op);
+CEED_EXTERN int CeedOperatorPhaseBegin(CeedOperator op,
+                                       CeedOperatorPhase phase);
+CEED_EXTERN int CeedOperatorPhaseEnd(CeedOperator op, CeedOperatorPhase phase);
 
 CEED_EXTERN int CeedOperatorGetFields(CeedOperator op,
                                       CeedOperatorField **inputfields,
@@ -218,6 +235,8 @@ CEED_EXTERN int CeedOperatorFieldGetBasis(CeedOperatorField opfield,
     CeedBasis *basis);
 CEED_EXTERN int CeedOperatorFieldGetVector(CeedOperatorField opfield,
     CeedVector *vec);
+CEED_EXTERN int CeedOperatorFieldGetStorage(CeedOperatorField opfield,
+    CeedStorageMode *storage);
 
 CEED_INTERN int CeedMatrixMultiply(Ceed ceed, const CeedScalar *matA,
                                    const CeedScalar *matB, CeedScalar *matC,
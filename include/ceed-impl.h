@@ -90,6 +90,17 @@ typedef struct {
   Ceed delegate;
 } objdelegate;
 
+// Pool entry for work arrays borrowed by backends
+typedef struct {
+  CeedScalar *array;
+  size_t length;
+  bool inuse;
+} workarray;
+
+typedef struct CeedRequestQueue_private *CeedRequestQueue;
+typedef struct CeedThreadPool_private *CeedThreadPool;
+typedef struct CeedCompositeSchedule_private *CeedCompositeSchedule;
+
 struct Ceed_private {
   const char *resource;
   Ceed delegate;
@@ -125,6 +136,10 @@ struct Ceed_private {
   bool debug;
   char errmsg[CEED_MAX_RESOURCE_LEN];
   foffset *foffsets;
+  workarray *workarrays;
+  int workarraycount;
+  CeedRequestQueue requestqueue; /* Worker queue for non-blocking requests */
+  CeedThreadPool threadpool;     /* Workers for concurrent suboperators */
 };
 
 struct CeedVector_private {
@@ -167,6 +182,9 @@ struct CeedElemRestriction_private {
   CeedInt *strides;         /* strides between [nodes, components, elements] */
   CeedInt layout[3];        /* E-vector layout [nodes, components, elements] */
   uint64_t numreaders;      /* number of instances of offset read only access */
+  CeedInt ncolors;          /* number of colors in block coloring */
+  CeedInt *colorptr;        /* block coloring, colors as CSR offsets into */
+  CeedInt *colorblks;       /*   the block numbers sorted by color */
   void *data;               /* place for the backend to store any data */
 };
 
@@ -283,6 +301,7 @@ struct CeedOperatorField_private {
   CeedVector vec;                /* State vector for passive fields or
                                       CEED_VECTOR_NONE for no vector */
   const char *fieldname;         /* matching QFunction field name */
+  CeedStorageMode storage;       /* Storage of passive CEED_EVAL_NONE input */
 };
 
 struct CeedOperator_private {
@@ -298,6 +317,11 @@ struct CeedOperator_private {
                                           CeedRequest *);
   int (*LinearAssembleAddPointBlockDiagonal)(CeedOperator, CeedVector,
       CeedRequest *);
+  int (*LinearAssembleSymbolic)(CeedOperator, CeedInt *, CeedInt **,
+                                CeedInt **);
+  int (*LinearAssemble)(CeedOperator, CeedVector);
+  int (*LinearAssembleElementMatrices)(CeedOperator, CeedVector *,
+                                       CeedRequest *);
   int (*CreateFDMElementInverse)(CeedOperator, CeedOperator *, CeedRequest *);
   int (*Apply)(CeedOperator, CeedVector, CeedVector, CeedRequest *);
   int (*ApplyComposite)(CeedOperator, CeedVector, CeedVector, CeedRequest *);
@@ -320,6 +344,23 @@ struct CeedOperator_private {
   CeedOperator *suboperators;
   CeedInt numsub;
   void *data;
+  bool profile;                              /* collect per-phase statistics */
+  uint64_t phasecount[CEED_PHASE_TOTAL+1];   /* completed phase intervals */
+  double phasetime[CEED_PHASE_TOTAL+1];      /* accumulated phase time (s) */
+  double phasestart[CEED_PHASE_TOTAL+1];     /* start of open phase interval */
+  CeedCompositeSchedule schedule;  /* concurrent suboperator tasks */
 };
 
+CEED_INTERN int CeedRequestSubmit(Ceed ceed,
+                                  int (*apply)(CeedOperator, CeedVector,
+                                      CeedVector, CeedRequest *),
+                                  CeedOperator op, CeedVector in,
+                                  CeedVector out, CeedRequest *request,
+                                  bool *submitted);
+CEED_INTERN int CeedRequestWaitAll(Ceed ceed);
+CEED_INTERN int CeedRequestQueueDestroy(Ceed ceed);
+CEED_INTERN int CeedThreadPoolRun(Ceed ceed, CeedInt numtasks,
+                                  int (*task)(void *, CeedInt), void *ctx);
+CEED_INTERN int CeedThreadPoolDestroy(Ceed ceed);
+
 #endif
@@ -115,9 +115,40 @@
 /// Integer type, used for indexing
 /// @ingroup Ceed
 typedef int32_t CeedInt;
-/// Scalar (floating point) type
+/// Scalar (floating point) type, double unless libCEED is built with
+///   `make SCALAR=float`, which defines CEED_SCALAR_FLOAT
 /// @ingroup Ceed
+#ifdef CEED_SCALAR_FLOAT
+typedef float CeedScalar;
+#else
 typedef double CeedScalar;
+#endif
+
+/// Floating point type of CeedScalar
+/// @ingroup Ceed
+typedef enum {
+  /// Single precision
+  CEED_SCALAR_FP32,
+  /// Double precision
+  CEED_SCALAR_FP64,
+} CeedScalarType;
+
+/// Floating point type of CeedScalar as seen by the including code, to be
+///   compared with the type the library was built with, CeedGetScalarType()
+/// @ingroup Ceed
+#ifdef CEED_SCALAR_FLOAT
+#  define CEED_SCALAR_TYPE CEED_SCALAR_FP32
+#else
+#  define CEED_SCALAR_TYPE CEED_SCALAR_FP64
+#endif
+
+/// Machine epsilon of CeedScalar, used to scale tolerances
+/// @ingroup Ceed
+#ifdef CEED_SCALAR_FLOAT
+#  define CEED_EPSILON 6E-08
+#else
+#  define CEED_EPSILON 1E-16
+#endif
 
 /// Library context created by CeedInit()
 /// @ingroup CeedUser
@@ -155,6 +186,7 @@ CEED_EXTERN int CeedGetResource(Ceed ceed, const char **resource);
 CEED_EXTERN int CeedIsDeterministic(Ceed ceed, bool *isDeterministic);
 CEED_EXTERN int CeedView(Ceed ceed, FILE *stream);
 CEED_EXTERN int CeedDestroy(Ceed *ceed);
+CEED_EXTERN int CeedFree(void *p);
 
 CEED_EXTERN int CeedErrorImpl(Ceed, const char *, int, const char *, int,
                               const char *, ...);
@@ -207,6 +239,7 @@ typedef enum {
 CEED_EXTERN const char *const CeedMemTypes[];
 
 CEED_EXTERN int CeedGetPreferredMemType(Ceed ceed, CeedMemType *type);
+CEED_EXTERN int CeedGetScalarType(CeedScalarType *type);
 
 /// Conveys ownership status of arrays passed to Ceed interfaces.
 /// @ingroup Ceed
@@ -408,6 +441,40 @@ typedef enum {
 
 CEED_EXTERN const char *const CeedElemTopologies[];
 
+/// Storage of a passive CeedOperator input field with eval mode
+///   CEED_EVAL_NONE, such as quadrature data
+///
+/// Modes can be bitwise ORed.
+/// @ingroup CeedOperator
+typedef enum {
+  /// Store all components as CeedScalar
+  CEED_STORAGE_FULL = 0,
+  /// Store only the upper triangle of symmetric n x n matrices
+  CEED_STORAGE_SYMMETRIC = 1,
+  /// Store values in single precision, computing in CeedScalar
+  CEED_STORAGE_SINGLE = 2,
+  /// Store the upper triangle of symmetric matrices in single precision
+  CEED_STORAGE_SYMMETRIC_SINGLE = 3,
+} CeedStorageMode;
+
+CEED_EXTERN const char *const CeedStorageModes[];
+
+/// Phase of CeedOperator application, for statistics collected when the
+///   environment variable CEED_PROFILE is set
+/// @ingroup CeedOperator
+typedef enum {
+  /// Element restriction between L-vectors and E-vectors
+  CEED_PHASE_RESTRICTION = 0,
+  /// Basis action between E-vectors and quadrature points
+  CEED_PHASE_BASIS = 1,
+  /// QFunction evaluation at quadrature points
+  CEED_PHASE_QFUNCTION = 2,
+  /// Entire operator application
+  CEED_PHASE_TOTAL = 3,
+} CeedOperatorPhase;
+
+CEED_EXTERN const char *const CeedOperatorPhases[];
+
 CEED_EXTERN int CeedBasisCreateTensorH1Lagrange(Ceed ceed, CeedInt dim,
     CeedInt ncomp, CeedInt P, CeedInt Q, CeedQuadMode qmode, CeedBasis *basis);
 CEED_EXTERN int CeedBasisCreateTensorH1(Ceed ceed, CeedInt dim, CeedInt ncomp,
@@ -520,6 +587,8 @@ CEED_EXTERN int CeedCompositeOperatorCreate(Ceed ceed, CeedOperator *op);
 CEED_EXTERN int CeedOperatorSetField(CeedOperator op, const char *fieldname,
                                      CeedElemRestriction r, CeedBasis b,
                                      CeedVector v);
+CEED_EXTERN int CeedOperatorSetFieldStorage(CeedOperator op,
+    const char *fieldname, CeedStorageMode storage);
 CEED_EXTERN int CeedCompositeOperatorAddSub(CeedOperator compositeop,
     CeedOperator subop);
 CEED_EXTERN int CeedOperatorLinearAssembleQFunction(CeedOperator op,
@@ -532,6 +601,11 @@ CEED_EXTERN int CeedOperatorLinearAssemblePointBlockDiagonal(CeedOperator op,
     CeedVector assembled, CeedRequest *request);
 CEED_EXTERN int CeedOperatorLinearAssembleAddPointBlockDiagonal(CeedOperator op,
     CeedVector assembled, CeedRequest *request);
+CEED_EXTERN int CeedOperatorLinearAssembleSymbolic(CeedOperator op,
+    CeedInt *nentries, CeedInt **rows, CeedInt **cols);
+CEED_EXTERN int CeedOperatorLinearAssemble(CeedOperator op, CeedVector values);
+CEED_EXTERN int CeedOperatorLinearAssembleElementMatrices(CeedOperator op,
+    CeedVector *assembled, CeedRequest *request);
 CEED_EXTERN int CeedOperatorMultigridLevelCreate(CeedOperator opFine,
     CeedVector PMultFine, CeedElemRestriction rstrCoarse, CeedBasis basisCoarse,
     CeedOperator *opCoarse, CeedOperator *opProlong, CeedOperator *opRestrict);
@@ -546,6 +620,10 @@ CEED_EXTERN int CeedOperatorMultigridLevelCreateH1(CeedOperator opFine,
 CEED_EXTERN int CeedOperatorCreateFDMElementInverse(CeedOperator op,
     CeedOperator *fdminv, CeedRequest *request);
 CEED_EXTERN int CeedOperatorView(CeedOperator op, FILE *stream);
+CEED_EXTERN int CeedOperatorGetStats(CeedOperator op, CeedOperatorPhase phase,
+                                     uint64_t *count, double *time,
+                                     double *bytes, double *flops);
+CEED_EXTERN int CeedOperatorResetStats(CeedOperator op);
 CEED_EXTERN int CeedOperatorApply(CeedOperator op, CeedVector in,
                                   CeedVector out, CeedRequest *request);
 CEED_EXTERN int CeedOperatorApplyAdd(CeedOperator op, CeedVector in,
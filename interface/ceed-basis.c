@@ -262,6 +262,61 @@ int CeedBasisIsTensor(CeedBasis basis, bool *istensor) {
   return 0;
 }
 
+/**
+  @brief Estimate number of floating point operations for a CeedBasis action
+           on a single element
+
+  Tensor product bases are counted as a sequence of 1D contractions, one per
+    dimension for interpolation and one sequence per derivative direction for
+    gradients.
+
+  @param basis       CeedBasis to estimate
+  @param tmode       Apply basis or its transpose
+  @param emode       CeedEvalMode to estimate
+  @param[out] flops  Variable to store number of floating point operations
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedBasisGetFlopsEstimate(CeedBasis basis, CeedTransposeMode tmode,
+                              CeedEvalMode emode, CeedInt *flops) {
+  CeedInt interpflops;
+  if (basis->tensorbasis) {
+    CeedInt pre = basis->ncomp*CeedIntPow(basis->P1d, basis->dim-1), post = 1;
+    interpflops = 0;
+    for (CeedInt d=0; d<basis->dim; d++) {
+      interpflops += 2*pre*basis->P1d*post*basis->Q1d;
+      pre /= basis->P1d;
+      post *= basis->Q1d;
+    }
+  } else {
+    interpflops = 2*basis->ncomp*basis->P*basis->Q;
+  }
+
+  switch (emode) {
+  case CEED_EVAL_INTERP:
+    *flops = interpflops;
+    break;
+  case CEED_EVAL_GRAD:
+    *flops = basis->dim*interpflops;
+    break;
+  case CEED_EVAL_WEIGHT:
+    *flops = basis->tensorbasis ? (basis->dim-1)*basis->Q : 0;
+    break;
+  case CEED_EVAL_NONE:
+  case CEED_EVAL_DIV:
+  case CEED_EVAL_CURL:
+    *flops = 0;
+    break;
+  }
+  // Transpose accumulates into the output
+  if (tmode == CEED_TRANSPOSE && emode == CEED_EVAL_GRAD)
+    *flops += (basis->dim-1)*basis->ncomp*basis->P;
+
+  return 0;
+}
+
 /**
   @brief Get backend data of a CeedBasis
 
@@ -56,6 +56,44 @@ int CeedPermutePadOffsets(const CeedInt *offsets, CeedInt *blkoffsets,
   return 0;
 }
 
+/**
+  @brief Get the L-vector indices touched by one block of a CeedElemRestriction
+
+  Padding elements in the final block are skipped.
+
+  @param rstr         CeedElemRestriction
+  @param offsets      Offsets array from CeedElemRestrictionGetOffsets(), or
+                        NULL for a strided restriction
+  @param block        Block number
+  @param[out] indices Array of size at least blksize*elemsize*ncomp to store
+                        the L-vector indices
+
+  @return Number of indices stored
+
+  @ref Developer
+**/
+static CeedInt CeedElemRestrictionGetBlockIndices(CeedElemRestriction rstr,
+    const CeedInt *offsets, CeedInt block, CeedInt *indices) {
+  const CeedInt blksize = rstr->blksize, elemsize = rstr->elemsize,
+                ncomp = rstr->ncomp;
+  const CeedInt nlanes = CeedIntMin(blksize, rstr->nelem - block*blksize);
+  CeedInt strides[3] = {1, elemsize, elemsize*ncomp}, n = 0;
+  if (rstr->strides && (rstr->strides[0] || rstr->strides[1] ||
+                        rstr->strides[2]))
+    for (CeedInt i = 0; i<3; i++)
+      strides[i] = rstr->strides[i];
+
+  for (CeedInt j = 0; j < nlanes; j++)
+    for (CeedInt k = 0; k < elemsize; k++)
+      for (CeedInt c = 0; c < ncomp; c++)
+        indices[n++] = offsets
+                       ? offsets[block*blksize*elemsize + k*blksize + j] +
+                         c*rstr->compstride
+                       : k*strides[0] + c*strides[1] +
+                         (block*blksize + j)*strides[2];
+  return n;
+}
+
 /// @}
 
 /// ----------------------------------------------------------------------------
@@ -263,6 +301,116 @@ int CeedElemRestrictionSetData(CeedElemRestriction rstr, void *data) {
   return 0;
 }
 
+/**
+  @brief Get a coloring of the element blocks of a CeedElemRestriction
+
+  Blocks of the same color share no L-vector entries, so the transpose
+    restriction of all blocks of one color may be applied concurrently without
+    write conflicts. The coloring is computed greedily from the offsets on the
+    first call and cached for the lifetime of the CeedElemRestriction.
+
+  @param rstr             CeedElemRestriction
+  @param[out] ncolors     Variable to store number of colors
+  @param[out] colorptr    Variable to store array of size @a ncolors + 1;
+                            the blocks of color c are
+                            colorblks[colorptr[c]:colorptr[c+1]]
+  @param[out] colorblks   Variable to store array of block numbers sorted by
+                            color
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedElemRestrictionGetColoring(CeedElemRestriction rstr, CeedInt *ncolors,
+                                   const CeedInt **colorptr,
+                                   const CeedInt **colorblks) {
+  int ierr;
+
+  if (!rstr->colorptr) {
+    const CeedInt nblk = rstr->nblk, lsize = rstr->lsize,
+                  blksize = rstr->blksize, elemsize = rstr->elemsize,
+                  ncomp = rstr->ncomp;
+    const CeedInt *offsets = NULL;
+    CeedInt *indices, *lptr, *lblks, *color, *forbidden, n;
+
+    if (!rstr->strides) {
+      ierr = CeedElemRestrictionGetOffsets(rstr, CEED_MEM_HOST, &offsets);
+      CeedChk(ierr);
+    }
+    ierr = CeedMalloc(blksize*elemsize*ncomp, &indices); CeedChk(ierr);
+
+    // Map from L-vector entries to the blocks touching them
+    ierr = CeedCalloc(lsize + 1, &lptr); CeedChk(ierr);
+    for (CeedInt b = 0; b < nblk; b++) {
+      n = CeedElemRestrictionGetBlockIndices(rstr, offsets, b, indices);
+      for (CeedInt i = 0; i < n; i++)
+        lptr[indices[i] + 1]++;
+    }
+    for (CeedInt i = 0; i < lsize; i++)
+      lptr[i + 1] += lptr[i];
+    ierr = CeedMalloc(lptr[lsize], &lblks); CeedChk(ierr);
+    for (CeedInt b = 0; b < nblk; b++) {
+      n = CeedElemRestrictionGetBlockIndices(rstr, offsets, b, indices);
+      for (CeedInt i = 0; i < n; i++)
+        lblks[lptr[indices[i]]++] = b;
+    }
+    for (CeedInt i = lsize; i > 0; i--)
+      lptr[i] = lptr[i - 1];
+    lptr[0] = 0;
+
+    // Greedy coloring of the block adjacency graph
+    ierr = CeedMalloc(nblk, &color); CeedChk(ierr);
+    ierr = CeedMalloc(nblk + 1, &forbidden); CeedChk(ierr);
+    for (CeedInt b = 0; b < nblk; b++) {
+      color[b] = -1;
+      forbidden[b] = -1;
+    }
+    forbidden[nblk] = -1;
+    rstr->ncolors = 0;
+    for (CeedInt b = 0; b < nblk; b++) {
+      n = CeedElemRestrictionGetBlockIndices(rstr, offsets, b, indices);
+      for (CeedInt i = 0; i < n; i++)
+        for (CeedInt j = lptr[indices[i]]; j < lptr[indices[i] + 1]; j++)
+          if (color[lblks[j]] >= 0)
+            forbidden[color[lblks[j]]] = b;
+      CeedInt c = 0;
+      while (forbidden[c] == b) c++;
+      color[b] = c;
+      rstr->ncolors = CeedIntMax(rstr->ncolors, c + 1);
+    }
+
+    // Sort blocks by color
+    ierr = CeedCalloc(rstr->ncolors + 1, &rstr->colorptr); CeedChk(ierr);
+    ierr = CeedMalloc(nblk, &rstr->colorblks); CeedChk(ierr);
+    for (CeedInt b = 0; b < nblk; b++)
+      rstr->colorptr[color[b] + 1]++;
+    for (CeedInt c = 0; c < rstr->ncolors; c++)
+      rstr->colorptr[c + 1] += rstr->colorptr[c];
+    for (CeedInt b = 0, c; b < nblk; b++) {
+      c = color[b];
+      rstr->colorblks[rstr->colorptr[c]++] = b;
+    }
+    for (CeedInt c = rstr->ncolors; c > 0; c--)
+      rstr->colorptr[c] = rstr->colorptr[c - 1];
+    rstr->colorptr[0] = 0;
+
+    // Cleanup
+    if (offsets) {
+      ierr = CeedElemRestrictionRestoreOffsets(rstr, &offsets); CeedChk(ierr);
+    }
+    ierr = CeedFree(&indices); CeedChk(ierr);
+    ierr = CeedFree(&lptr); CeedChk(ierr);
+    ierr = CeedFree(&lblks); CeedChk(ierr);
+    ierr = CeedFree(&color); CeedChk(ierr);
+    ierr = CeedFree(&forbidden); CeedChk(ierr);
+  }
+
+  *ncolors = rstr->ncolors;
+  *colorptr = rstr->colorptr;
+  *colorblks = rstr->colorblks;
+  return 0;
+}
+
 /// @}
 
 /// @cond DOXYGEN_SKIP
@@ -877,6 +1025,8 @@ int CeedElemRestrictionDestroy(CeedElemRestriction *rstr) {
     ierr = (*rstr)->Destroy(*rstr); CeedChk(ierr);
   }
   ierr = CeedFree(&(*rstr)->strides); CeedChk(ierr);
+  ierr = CeedFree(&(*rstr)->colorptr); CeedChk(ierr);
+  ierr = CeedFree(&(*rstr)->colorblks); CeedChk(ierr);
   ierr = CeedDestroy(&(*rstr)->ceed); CeedChk(ierr);
   ierr = CeedFree(rstr); CeedChk(ierr);
   return 0;
@@ -72,6 +72,14 @@ typedef int fortran_charlen_t;
 void fCeedInit(const char *resource, int *ceed, int *err,
                fortran_charlen_t resource_len) {
   FIX_STRING(resource);
+#ifdef CEED_SCALAR_FLOAT
+  // The Fortran interface passes real*8 arrays as CeedScalar
+  // LCOV_EXCL_START
+  *err = CeedError(NULL, 1, "The Fortran interface requires libCEED built "
+                   "with SCALAR=double");
+  return;
+  // LCOV_EXCL_STOP
+#endif
   if (Ceed_count == Ceed_count_max) {
     Ceed_count_max += Ceed_count_max/2 + 1;
     CeedRealloc(Ceed_count_max, &Ceed_dict);
@@ -435,8 +443,7 @@ void fCeedElemRestrictionView(int *elemr, int *err) {
 
 #define fCeedRequestWait FORTRAN_NAME(ceedrequestwait, CEEDREQUESTWAIT)
 void fCeedRequestWait(int *rqst, int *err) {
-  // TODO Uncomment this once CeedRequestWait is implemented
-  //*err = CeedRequestWait(&CeedRequest_dict[*rqst]);
+  *err = CeedRequestWait(&CeedRequest_dict[*rqst]);
 
   if (*err == 0) {
     CeedRequest_n--;
@@ -14,10 +14,31 @@
 // software, applications, hardware, advanced system engineering and early
 // testbed platforms, in support of the nation's exascale computing imperative.
 
+#define _POSIX_C_SOURCE 200112
 #include <ceed-impl.h>
 #include <ceed-backend.h>
-#include <string.h>
+#include <inttypes.h>
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/// @cond DOXYGEN_SKIP
+struct CeedCompositeSchedule_private {
+  CeedInt numsub;              /* suboperator count the schedule was built for */
+  CeedInt numtasks;            /* number of concurrent tasks */
+  CeedInt *task;               /* task applying each suboperator */
+  CeedVector *in, *out;        /* input views and output buffers of tasks > 0 */
+  const CeedScalar **outarray; /* output buffer arrays during reduction */
+};
+
+typedef struct {
+  CeedOperator op;
+  CeedVector in, out;
+  CeedScalar *outarray;
+  CeedInt length;
+} CeedCompositeApply;
+/// @endcond
 
 /// @file
 /// Implementation of CeedOperator interfaces
@@ -85,6 +106,110 @@ int CeedOperatorCreateFallback(CeedOperator op) {
   return 0;
 }
 
+/**
+  @brief Check if per-phase statistics should be collected for new operators
+
+  Statistics are enabled by setting the environment variable CEED_PROFILE to
+    any value other than "0".
+
+  @return Boolean flag indicating if statistics are enabled
+
+  @ref Developer
+**/
+static bool CeedOperatorProfileEnabled(void) {
+  const char *profile = getenv("CEED_PROFILE");
+  return profile && strcmp(profile, "") && strcmp(profile, "0");
+}
+
+/**
+  @brief Get monotonic wall clock time in seconds
+
+  @ref Developer
+**/
+static double CeedOperatorWallTime(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + 1e-9*ts.tv_nsec;
+}
+
+/**
+  @brief Estimate bytes moved and floating point operations for one phase of
+           a single application of a non-composite CeedOperator
+
+  Restrictions count E-vector and L-vector traffic and offsets, bases count
+    E-vector and quadrature point traffic and the flops from
+    CeedBasisGetFlopsEstimate(), and QFunctions count quadrature point
+    traffic only, as their flops are not known to the library.
+
+  @param op          CeedOperator to estimate
+  @param phase       CeedOperatorPhase to estimate
+  @param[out] bytes  Variable to store estimated bytes moved
+  @param[out] flops  Variable to store estimated floating point operations
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+static int CeedOperatorGetPhaseEstimate(CeedOperator op,
+                                        CeedOperatorPhase phase,
+                                        double *bytes, double *flops) {
+  int ierr;
+  const CeedInt nelem = op->numelements, Q = op->numqpoints;
+
+  *bytes = 0;
+  *flops = 0;
+  for (CeedInt i=0; i<op->qf->numinputfields+op->qf->numoutputfields; i++) {
+    const bool isinput = i < op->qf->numinputfields;
+    const CeedInt j = isinput ? i : i - op->qf->numinputfields;
+    CeedOperatorField opfield = isinput ? op->inputfields[j] :
+                                op->outputfields[j];
+    CeedQFunctionField qffield = isinput ? op->qf->inputfields[j] :
+                                 op->qf->outputfields[j];
+    const CeedEvalMode emode = qffield->emode;
+    const CeedInt size = qffield->size;
+
+    if ((phase == CEED_PHASE_RESTRICTION || phase == CEED_PHASE_TOTAL) &&
+        opfield->Erestrict != CEED_ELEMRESTRICTION_NONE &&
+        emode != CEED_EVAL_WEIGHT) {
+      CeedElemRestriction rstr = opfield->Erestrict;
+      bool isstrided;
+      ierr = CeedElemRestrictionIsStrided(rstr, &isstrided); CeedChk(ierr);
+      const double esize = (double)nelem*rstr->elemsize*rstr->ncomp;
+      *bytes += 2*esize*sizeof(CeedScalar);
+      if (!isstrided)
+        *bytes += (double)nelem*rstr->elemsize*sizeof(CeedInt);
+      if (!isinput)
+        *flops += esize;
+    }
+    if ((phase == CEED_PHASE_BASIS || phase == CEED_PHASE_TOTAL) &&
+        opfield->basis != CEED_BASIS_COLLOCATED && emode != CEED_EVAL_NONE) {
+      CeedBasis basis = opfield->basis;
+      CeedInt basisflops;
+      ierr = CeedBasisGetFlopsEstimate(basis, isinput ? CEED_NOTRANSPOSE :
+                                       CEED_TRANSPOSE, emode, &basisflops);
+      CeedChk(ierr);
+      *flops += (double)nelem*basisflops;
+      *bytes += (double)nelem*Q*size*sizeof(CeedScalar);
+      if (emode != CEED_EVAL_WEIGHT)
+        *bytes += (double)nelem*basis->P*basis->ncomp*sizeof(CeedScalar);
+    }
+    if ((phase == CEED_PHASE_BASIS || phase == CEED_PHASE_TOTAL) &&
+        isinput && opfield->storage != CEED_STORAGE_FULL) {
+      // Expansion of compressed storage to the quadrature points
+      CeedInt n = 0, csize = size;
+      while (n*n < size) n++;
+      if (opfield->storage & CEED_STORAGE_SYMMETRIC) csize = n*(n+1)/2;
+      *bytes += (double)nelem*Q*csize*(opfield->storage & CEED_STORAGE_SINGLE ?
+                                       sizeof(float) : sizeof(CeedScalar));
+      *bytes += (double)nelem*Q*size*sizeof(CeedScalar);
+    }
+    if (phase == CEED_PHASE_QFUNCTION || phase == CEED_PHASE_TOTAL)
+      *bytes += (double)nelem*Q*size*sizeof(CeedScalar);
+  }
+
+  return 0;
+}
+
 /**
   @brief Check if a CeedOperator is ready to be used.
 
@@ -125,6 +250,347 @@ static int CeedOperatorCheckReady(Ceed ceed, CeedOperator op) {
   return 0;
 }
 
+/**
+  @brief Check if two suboperators share state that prevents applying them
+           concurrently
+
+  Suboperators sharing a QFunction, a QFunction context, a passive vector, an
+    element restriction, or a basis must be applied by the same task, as
+    backends may keep scratch space or build data lazily in these objects.
+
+  @param a  First CeedOperator
+  @param b  Second CeedOperator
+
+  @return True if @a a and @a b must be applied by the same task
+
+  @ref Developer
+**/
+static bool CeedCompositeShareState(CeedOperator a, CeedOperator b) {
+  if (a == b || a->qf == b->qf || (a->qf->ctx && a->qf->ctx == b->qf->ctx))
+    return true;
+
+  for (CeedInt i=0; i<a->qf->numinputfields+a->qf->numoutputfields; i++) {
+    CeedOperatorField fa = i < a->qf->numinputfields ? a->inputfields[i] :
+                           a->outputfields[i-a->qf->numinputfields];
+    bool passive = fa->vec != CEED_VECTOR_ACTIVE && fa->vec != CEED_VECTOR_NONE;
+    for (CeedInt j=0; j<b->qf->numinputfields+b->qf->numoutputfields; j++) {
+      CeedOperatorField fb = j < b->qf->numinputfields ? b->inputfields[j] :
+                             b->outputfields[j-b->qf->numinputfields];
+      if ((passive && fa->vec == fb->vec) ||
+          (fa->Erestrict != CEED_ELEMRESTRICTION_NONE &&
+           fa->Erestrict == fb->Erestrict) ||
+          (fa->basis != CEED_BASIS_COLLOCATED && fa->basis == fb->basis))
+        return true;
+    }
+  }
+  return false;
+}
+
+/**
+  @brief Find the representative suboperator of a group of suboperators
+           sharing state
+
+  @param group  Array linking each suboperator to another of its group
+  @param i      Suboperator to find the representative of
+
+  @return Index of the representative suboperator
+
+  @ref Developer
+**/
+static CeedInt CeedCompositeGroupFind(CeedInt *group, CeedInt i) {
+  while (group[i] != i)
+    i = group[i] = group[group[i]];
+  return i;
+}
+
+/**
+  @brief Partition the suboperators of a composite CeedOperator into tasks
+           that can be applied concurrently
+
+  Groups of suboperators sharing state are assigned, largest first, to the
+    task with the least quadrature points.  The number of tasks is limited by
+    the environment variable `CEED_COMPOSITE_THREADS`; without it, or on
+    non-host backends, the schedule has a single task and suboperators are
+    applied in order.
+
+  @param op  Composite CeedOperator to schedule
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+static int CeedCompositeScheduleCreate(CeedOperator op) {
+  int ierr;
+  CeedInt numsub = op->numsub, numthreads = 1;
+  CeedCompositeSchedule schedule;
+
+  const char *env = getenv("CEED_COMPOSITE_THREADS");
+  if (env && op->ceed->resource && !strncmp(op->ceed->resource, "/cpu/", 5))
+    numthreads = atoi(env);
+
+  ierr = CeedCalloc(1, &schedule); CeedChk(ierr);
+  ierr = CeedCalloc(numsub, &schedule->task); CeedChk(ierr);
+  schedule->numsub = numsub;
+  schedule->numtasks = 1;
+  op->schedule = schedule;
+  if (numthreads < 2 || numsub < 2)
+    return 0;
+
+  // Group suboperators sharing state
+  CeedInt *group, *order, numgroups = 0;
+  CeedScalar *weight, *load;
+  ierr = CeedMalloc(numsub, &group); CeedChk(ierr);
+  ierr = CeedMalloc(numsub, &order); CeedChk(ierr);
+  ierr = CeedCalloc(numsub, &weight); CeedChk(ierr);
+  for (CeedInt i=0; i<numsub; i++)
+    group[i] = i;
+  for (CeedInt i=0; i<numsub; i++)
+    for (CeedInt j=0; j<i; j++)
+      if (CeedCompositeShareState(op->suboperators[i], op->suboperators[j]))
+        group[CeedCompositeGroupFind(group, i)] = CeedCompositeGroupFind(group, j);
+  for (CeedInt i=0; i<numsub; i++) {
+    CeedInt g = CeedCompositeGroupFind(group, i);
+    if (g == i)
+      order[numgroups++] = i;
+    weight[g] += op->suboperators[i]->numqpoints;
+  }
+
+  // Assign groups, largest first, to the least loaded task
+  schedule->numtasks = CeedIntMin(numgroups, numthreads);
+  ierr = CeedCalloc(schedule->numtasks, &load); CeedChk(ierr);
+  for (CeedInt i=1; i<numgroups; i++)
+    for (CeedInt j=i; j>0 && weight[order[j]] > weight[order[j-1]]; j--) {
+      CeedInt tmp = order[j]; order[j] = order[j-1]; order[j-1] = tmp;
+    }
+  for (CeedInt i=0; i<numgroups; i++) {
+    CeedInt t = 0;
+    for (CeedInt j=1; j<schedule->numtasks; j++)
+      if (load[j] < load[t])
+        t = j;
+    load[t] += weight[order[i]];
+    group[order[i]] = -1 - t;
+  }
+  for (CeedInt i=0; i<numsub; i++) {
+    CeedInt g = i;
+    while (group[g] >= 0)
+      g = group[g];
+    schedule->task[i] = -1 - group[g];
+  }
+  ierr = CeedFree(&load); CeedChk(ierr);
+  ierr = CeedFree(&weight); CeedChk(ierr);
+  ierr = CeedFree(&order); CeedChk(ierr);
+  ierr = CeedFree(&group); CeedChk(ierr);
+
+  if (schedule->numtasks > 1) {
+    ierr = CeedCalloc(schedule->numtasks, &schedule->in); CeedChk(ierr);
+    ierr = CeedCalloc(schedule->numtasks, &schedule->out); CeedChk(ierr);
+    ierr = CeedCalloc(schedule->numtasks, &schedule->outarray); CeedChk(ierr);
+  }
+
+  return 0;
+}
+
+/**
+  @brief Destroy the concurrent schedule of a composite CeedOperator
+
+  @param schedule  Address of CeedCompositeSchedule to destroy
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+static int CeedCompositeScheduleDestroy(CeedCompositeSchedule *schedule) {
+  int ierr;
+
+  if (!*schedule)
+    return 0;
+  for (CeedInt t=1; t<(*schedule)->numtasks; t++) {
+    ierr = CeedVectorDestroy(&(*schedule)->in[t]); CeedChk(ierr);
+    ierr = CeedVectorDestroy(&(*schedule)->out[t]); CeedChk(ierr);
+  }
+  ierr = CeedFree(&(*schedule)->in); CeedChk(ierr);
+  ierr = CeedFree(&(*schedule)->out); CeedChk(ierr);
+  ierr = CeedFree(&(*schedule)->outarray); CeedChk(ierr);
+  ierr = CeedFree(&(*schedule)->task); CeedChk(ierr);
+  ierr = CeedFree(schedule); CeedChk(ierr);
+
+  return 0;
+}
+
+/**
+  @brief Apply the suboperators assigned to one task of a composite
+           CeedOperator
+
+  Task 0 sums directly into the output vector; other tasks read the input
+    through a view of its array and sum into a private output buffer.
+
+  @param ptr  CeedCompositeApply context
+  @param t    Index of the task
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+static int CeedCompositeTaskApply(void *ptr, CeedInt t) {
+  int ierr;
+  CeedCompositeApply *apply = ptr;
+  CeedOperator op = apply->op;
+  CeedCompositeSchedule schedule = op->schedule;
+  CeedVector in = apply->in, out = apply->out;
+
+  if (t && in != CEED_VECTOR_NONE)
+    in = schedule->in[t];
+  if (t && out != CEED_VECTOR_NONE) {
+    out = schedule->out[t];
+    ierr = CeedVectorSetValue(out, 0.0); CeedChk(ierr);
+  }
+  for (CeedInt i=0; i<op->numsub; i++)
+    if (schedule->task[i] == t) {
+      ierr = CeedOperatorApplyAdd(op->suboperators[i], in, out,
+                                  CEED_REQUEST_IMMEDIATE); CeedChk(ierr);
+    }
+
+  return 0;
+}
+
+/**
+  @brief Sum the private output buffers of a composite CeedOperator into one
+           slice of its output array
+
+  @param ptr  CeedCompositeApply context
+  @param t    Index of the slice
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+static int CeedCompositeTaskReduce(void *ptr, CeedInt t) {
+  CeedCompositeApply *apply = ptr;
+  CeedCompositeSchedule schedule = apply->op->schedule;
+  CeedInt numtasks = schedule->numtasks;
+  CeedInt start = (int64_t)apply->length*t/numtasks,
+          stop = (int64_t)apply->length*(t+1)/numtasks;
+
+  for (CeedInt s=1; s<numtasks; s++) {
+    const CeedScalar *restrict buffer = schedule->outarray[s];
+    CeedScalar *restrict outarray = apply->outarray;
+    for (CeedInt i=start; i<stop; i++)
+      outarray[i] += buffer[i];
+  }
+
+  return 0;
+}
+
+/**
+  @brief Apply the suboperators of a composite CeedOperator and add the
+           results to the output vector
+
+  The first application runs the suboperators in order, completing any lazy
+    backend setup, and then schedules them.  Later applications on host
+    backends with `CEED_COMPOSITE_THREADS` set run independent suboperators
+    concurrently on the Ceed thread pool, each task summing into a private
+    output buffer, and then reduce the buffers into @a out in parallel.
+
+  @param op        Composite CeedOperator to apply
+  @param in        CeedVector containing input state
+  @param out       CeedVector to sum in result of applying operator
+  @param request   Address of CeedRequest for non-blocking completion, else
+                     @ref CEED_REQUEST_IMMEDIATE
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+static int CeedCompositeOperatorApplyAdd(CeedOperator op, CeedVector in,
+    CeedVector out, CeedRequest *request) {
+  int ierr;
+
+  if (op->schedule && op->schedule->numsub != op->numsub) {
+    ierr = CeedCompositeScheduleDestroy(&op->schedule); CeedChk(ierr);
+  }
+  if (!op->schedule || op->schedule->numtasks < 2) {
+    for (CeedInt i=0; i<op->numsub; i++) {
+      ierr = CeedOperatorApplyAdd(op->suboperators[i], in, out, request);
+      CeedChk(ierr);
+    }
+    if (!op->schedule) {
+      ierr = CeedCompositeScheduleCreate(op); CeedChk(ierr);
+    }
+    return 0;
+  }
+
+  CeedCompositeSchedule schedule = op->schedule;
+  CeedCompositeApply apply = {.op = op,
+                              .in = in ? in : CEED_VECTOR_NONE,
+                              .out = out ? out : CEED_VECTOR_NONE
+                             };
+  CeedInt numtasks = schedule->numtasks;
+
+  // Views of the input array for tasks > 0
+  const CeedScalar *inarray = NULL;
+  if (apply.in != CEED_VECTOR_NONE) {
+    CeedInt length;
+    ierr = CeedVectorGetLength(in, &length); CeedChk(ierr);
+    ierr = CeedVectorGetArrayRead(in, CEED_MEM_HOST, &inarray); CeedChk(ierr);
+    for (CeedInt t=1; t<numtasks; t++) {
+      if (schedule->in[t] && schedule->in[t]->length != length) {
+        ierr = CeedVectorDestroy(&schedule->in[t]); CeedChk(ierr);
+      }
+      if (!schedule->in[t]) {
+        ierr = CeedVectorCreate(op->ceed, length, &schedule->in[t]);
+        CeedChk(ierr);
+      }
+      ierr = CeedVectorSetArray(schedule->in[t], CEED_MEM_HOST,
+                                CEED_USE_POINTER, (CeedScalar *)inarray);
+      CeedChk(ierr);
+    }
+  }
+  // Private output buffers for tasks > 0
+  if (apply.out != CEED_VECTOR_NONE) {
+    ierr = CeedVectorGetLength(out, &apply.length); CeedChk(ierr);
+    for (CeedInt t=1; t<numtasks; t++) {
+      if (schedule->out[t] && schedule->out[t]->length != apply.length) {
+        ierr = CeedVectorDestroy(&schedule->out[t]); CeedChk(ierr);
+      }
+      if (!schedule->out[t]) {
+        ierr = CeedVectorCreate(op->ceed, apply.length, &schedule->out[t]);
+        CeedChk(ierr);
+      }
+    }
+  }
+
+  // Apply suboperators concurrently
+  ierr = CeedThreadPoolRun(op->ceed, numtasks, CeedCompositeTaskApply, &apply);
+  CeedChk(ierr);
+  if (apply.in != CEED_VECTOR_NONE) {
+    for (CeedInt t=1; t<numtasks; t++) {
+      CeedScalar *view;
+      ierr = CeedVectorTakeArray(schedule->in[t], CEED_MEM_HOST, &view);
+      CeedChk(ierr);
+    }
+    ierr = CeedVectorRestoreArrayRead(in, &inarray); CeedChk(ierr);
+  }
+
+  // Reduce private output buffers
+  if (apply.out != CEED_VECTOR_NONE) {
+    ierr = CeedVectorGetArray(out, CEED_MEM_HOST, &apply.outarray);
+    CeedChk(ierr);
+    for (CeedInt t=1; t<numtasks; t++) {
+      ierr = CeedVectorGetArrayRead(schedule->out[t], CEED_MEM_HOST,
+                                    &schedule->outarray[t]); CeedChk(ierr);
+    }
+    ierr = CeedThreadPoolRun(op->ceed, numtasks, CeedCompositeTaskReduce,
+                             &apply); CeedChk(ierr);
+    for (CeedInt t=1; t<numtasks; t++) {
+      ierr = CeedVectorRestoreArrayRead(schedule->out[t],
+                                        &schedule->outarray[t]); CeedChk(ierr);
+    }
+    ierr = CeedVectorRestoreArray(out, &apply.outarray); CeedChk(ierr);
+  }
+
+  return 0;
+}
+
 /**
   @brief View a field of a CeedOperator
 
@@ -158,6 +624,39 @@ static int CeedOperatorFieldView(CeedOperatorField field,
   else if (field->vec == CEED_VECTOR_NONE)
     fprintf(stream, "%s      No vector\n", pre);
 
+  if (field->storage != CEED_STORAGE_FULL)
+    fprintf(stream, "%s      Storage: %s\n", pre,
+            CeedStorageModes[field->storage]);
+
+  return 0;
+}
+
+/**
+  @brief View statistics collected for a CeedOperator
+
+  @param[in] op     CeedOperator to view statistics for
+  @param[in] pre    Prefix for each line of output
+  @param[in] stream Stream to write; typically stdout/stderr or a file
+
+  @return Error code: 0 - success, otherwise - failure
+
+  @ref Utility
+**/
+static int CeedOperatorStatsView(CeedOperator op, const char *pre,
+                                 FILE *stream) {
+  int ierr;
+
+  fprintf(stream, "%s  Statistics:\n", pre);
+  for (CeedInt phase=0; phase<=CEED_PHASE_TOTAL; phase++) {
+    uint64_t count;
+    double time, bytes, flops;
+    ierr = CeedOperatorGetStats(op, phase, &count, &time, &bytes, &flops);
+    CeedChk(ierr);
+    fprintf(stream, "%s    %-11s %8" PRIu64 " calls  %12.6e s  %12.6e B/s  "
+            "%12.6e flop/s\n", pre, CeedOperatorPhases[phase], count, time,
+            time > 0 ? bytes/time : 0., time > 0 ? flops/time : 0.);
+  }
+
   return 0;
 }
 
@@ -194,6 +693,9 @@ int CeedOperatorSingleView(CeedOperator op, bool sub, FILE *stream) {
     ierr = CeedOperatorFieldView(op->outputfields[i], op->qf->outputfields[i],
                                  i, sub, 0, stream); CeedChk(ierr);
   }
+  if (op->profile) {
+    ierr = CeedOperatorStatsView(op, pre, stream); CeedChk(ierr);
+  }
 
   return 0;
 }
@@ -280,6 +782,7 @@ static int CeedOperatorMultigridLevel_Core(CeedOperator opFine,
                                   opFine->inputfields[i]->Erestrict,
                                   opFine->inputfields[i]->basis,
                                   opFine->inputfields[i]->vec); CeedChk(ierr);
+      (*opCoarse)->inputfields[i]->storage = opFine->inputfields[i]->storage;
     }
   }
   // -- Clone output fields
@@ -526,6 +1029,26 @@ int CeedOperatorIsComposite(CeedOperator op, bool *iscomposite) {
   return 0;
 }
 
+/**
+  @brief Get a boolean value indicating if CEED_PROFILE statistics are
+           collected for a CeedOperator
+
+  Backends check this once per apply to skip the per-element calls to
+    CeedOperatorPhaseBegin() and CeedOperatorPhaseEnd() when profiling is off.
+
+  @param op                CeedOperator
+  @param[out] isprofiling  Variable to store profiling status
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+
+int CeedOperatorIsProfiling(CeedOperator op, bool *isprofiling) {
+  *isprofiling = op->profile;
+  return 0;
+}
+
 /**
   @brief Get the number of suboperators associated with a CeedOperator
 
@@ -615,6 +1138,43 @@ int CeedOperatorSetSetupDone(CeedOperator op) {
   return 0;
 }
 
+/**
+  @brief Begin timing a phase of CeedOperator application
+
+  This is a no-op unless statistics are enabled with CEED_PROFILE. Phases of
+    the same kind must not be nested.
+
+  @param op     CeedOperator being applied
+  @param phase  CeedOperatorPhase to begin
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedOperatorPhaseBegin(CeedOperator op, CeedOperatorPhase phase) {
+  if (op->profile)
+    op->phasestart[phase] = CeedOperatorWallTime();
+  return 0;
+}
+
+/**
+  @brief End timing a phase of CeedOperator application
+
+  @param op     CeedOperator being applied
+  @param phase  CeedOperatorPhase to end
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedOperatorPhaseEnd(CeedOperator op, CeedOperatorPhase phase) {
+  if (op->profile) {
+    op->phasetime[phase] += CeedOperatorWallTime() - op->phasestart[phase];
+    op->phasecount[phase]++;
+  }
+  return 0;
+}
+
 /**
   @brief Get the CeedOperatorFields of a CeedOperator
 
@@ -688,6 +1248,26 @@ int CeedOperatorFieldGetVector(CeedOperatorField opfield, CeedVector *vec) {
   return 0;
 }
 
+/**
+  @brief Get the CeedStorageMode of a CeedOperatorField
+
+  Backends that do not support compressed storage may ignore this and store
+    the field as given.
+
+  @param opfield         CeedOperatorField
+  @param[out] storage    Variable to store CeedStorageMode
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+
+int CeedOperatorFieldGetStorage(CeedOperatorField opfield,
+                                CeedStorageMode *storage) {
+  *storage = opfield->storage;
+  return 0;
+}
+
 /// @}
 
 /// ----------------------------------------------------------------------------
@@ -751,6 +1331,7 @@ int CeedOperatorCreate(Ceed ceed, CeedQFunction qf, CeedQFunction dqf,
   }
   ierr = CeedCalloc(16, &(*op)->inputfields); CeedChk(ierr);
   ierr = CeedCalloc(16, &(*op)->outputfields); CeedChk(ierr);
+  (*op)->profile = CeedOperatorProfileEnabled();
   ierr = ceed->OperatorCreate(*op); CeedChk(ierr);
   return 0;
 }
@@ -784,6 +1365,7 @@ int CeedCompositeOperatorCreate(Ceed ceed, CeedOperator *op) {
   ceed->refcount++;
   (*op)->composite = true;
   ierr = CeedCalloc(16, &(*op)->suboperators); CeedChk(ierr);
+  (*op)->profile = CeedOperatorProfileEnabled();
 
   if (ceed->CompositeOperatorCreate) {
     ierr = ceed->CompositeOperatorCreate(*op); CeedChk(ierr);
@@ -910,6 +1492,78 @@ found:
   return 0;
 }
 
+/**
+  @brief Set the storage of a passive input field of a CeedOperator
+
+  Quadrature data is often a symmetric tensor or tolerates single precision.
+    For a passive input field with eval mode @ref CEED_EVAL_NONE, backends may
+    keep the restricted field in compressed form and expand it at the
+    quadrature points of each element as the operator is applied, reducing the
+    memory footprint and the bytes moved per application.  The CeedQFunction
+    always sees the full field in CeedScalar.
+
+  With @ref CEED_STORAGE_SYMMETRIC the field must have size n*n, holding
+    symmetric n x n matrices at each quadrature point, and only the upper
+    triangle is kept.  With @ref CEED_STORAGE_SINGLE values are rounded to
+    single precision.  Backends that do not support compressed storage keep
+    the field as given.
+
+  @param op         CeedOperator with the field
+  @param fieldname  Name of the field, which must already be set with
+                      CeedOperatorSetField()
+  @param storage    CeedStorageMode for the field
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref User
+**/
+int CeedOperatorSetFieldStorage(CeedOperator op, const char *fieldname,
+                                CeedStorageMode storage) {
+  if (op->composite)
+    // LCOV_EXCL_START
+    return CeedError(op->ceed, 1, "Cannot set field storage of composite "
+                     "operator.");
+  // LCOV_EXCL_STOP
+  if (op->setupdone)
+    // LCOV_EXCL_START
+    return CeedError(op->ceed, 1, "Cannot set field storage after the "
+                     "operator has been applied.");
+  // LCOV_EXCL_STOP
+
+  for (CeedInt i=0; i<op->qf->numinputfields; i++) {
+    CeedQFunctionField qfield = op->qf->inputfields[i];
+    CeedOperatorField ofield = op->inputfields[i];
+    if (strcmp(fieldname, qfield->fieldname))
+      continue;
+    if (!ofield)
+      // LCOV_EXCL_START
+      return CeedError(op->ceed, 1, "Field '%s' must be set before its "
+                       "storage", fieldname);
+    // LCOV_EXCL_STOP
+    if (storage != CEED_STORAGE_FULL && (qfield->emode != CEED_EVAL_NONE ||
+                                         ofield->vec == CEED_VECTOR_ACTIVE))
+      // LCOV_EXCL_START
+      return CeedError(op->ceed, 1, "Compressed storage requires a passive "
+                       "field with eval mode CEED_EVAL_NONE");
+    // LCOV_EXCL_STOP
+    if (storage & CEED_STORAGE_SYMMETRIC) {
+      CeedInt n = 0;
+      while (n*n < qfield->size) n++;
+      if (n*n != qfield->size)
+        // LCOV_EXCL_START
+        return CeedError(op->ceed, 1, "Symmetric storage requires a field of "
+                         "size n*n, not %d", qfield->size);
+      // LCOV_EXCL_STOP
+    }
+    ofield->storage = storage;
+    return 0;
+  }
+  // LCOV_EXCL_START
+  return CeedError(op->ceed, 1, "QFunction has no input field '%s'",
+                   fieldname);
+  // LCOV_EXCL_STOP
+}
+
 /**
   @brief Add a sub-operator to a composite CeedOperator
 
@@ -1177,6 +1831,155 @@ int CeedOperatorLinearAssembleAddPointBlockDiagonal(CeedOperator op,
   return 0;
 }
 
+/**
+  @brief Determine the sparsity pattern of a linear CeedOperator
+
+  This returns the row and column indices, in the L-vector numbering of the
+    active output and input fields, of every entry in the COO (coordinate)
+    representation of the assembled operator. Entries with repeated indices
+    are not combined and must be summed by the caller, as is done by
+    `MatSetValuesCOO` in PETSc. The values are computed separately by
+    CeedOperatorLinearAssemble(), so the pattern only needs to be computed
+    once and the values may be refilled cheaply whenever the operator changes.
+
+  Entries are ordered by element, then by row, then by column, where each
+    element contributes a dense block of
+    (@a ncomp * @a elemsize) x (@a ncomp * @a elemsize) entries with rows and
+    columns ordered as [component, node]. Sub-operators of a composite
+    CeedOperator contribute consecutive ranges of entries in the order they
+    were added.
+
+  Note: Currently only CeedOperators with a single active field and
+          composite CeedOperators with single active field sub-operators are
+          supported.
+
+  @param op             CeedOperator to assemble
+  @param[out] nentries  Number of entries in the COO representation
+  @param[out] rows      Row index of each entry; the caller is responsible for
+                          freeing this array with CeedFree()
+  @param[out] cols      Column index of each entry; the caller is responsible
+                          for freeing this array with CeedFree()
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref User
+**/
+int CeedOperatorLinearAssembleSymbolic(CeedOperator op, CeedInt *nentries,
+                                       CeedInt **rows, CeedInt **cols) {
+  int ierr;
+  Ceed ceed = op->ceed;
+  ierr = CeedOperatorCheckReady(ceed, op); CeedChk(ierr);
+
+  // Use backend version, if available
+  if (op->LinearAssembleSymbolic) {
+    ierr = op->LinearAssembleSymbolic(op, nentries, rows, cols); CeedChk(ierr);
+  } else {
+    // Fallback to reference Ceed
+    if (!op->opfallback) {
+      ierr = CeedOperatorCreateFallback(op); CeedChk(ierr);
+    }
+    // Assemble
+    ierr = op->opfallback->LinearAssembleSymbolic(op->opfallback, nentries,
+           rows, cols); CeedChk(ierr);
+  }
+
+  return 0;
+}
+
+/**
+  @brief Compute the values of a linear CeedOperator in COO format
+
+  This overwrites a CeedVector with the value of each entry in the COO
+    representation of the operator, in the order given by
+    CeedOperatorLinearAssembleSymbolic().
+
+  Note: Currently only CeedOperators with a single active field and
+          composite CeedOperators with single active field sub-operators are
+          supported.
+
+  @param op          CeedOperator to assemble
+  @param[out] values CeedVector of length @a nentries to store the values of
+                       the COO entries
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref User
+**/
+int CeedOperatorLinearAssemble(CeedOperator op, CeedVector values) {
+  int ierr;
+  Ceed ceed = op->ceed;
+  ierr = CeedOperatorCheckReady(ceed, op); CeedChk(ierr);
+
+  // Use backend version, if available
+  if (op->LinearAssemble) {
+    ierr = op->LinearAssemble(op, values); CeedChk(ierr);
+  } else {
+    // Fallback to reference Ceed
+    if (!op->opfallback) {
+      ierr = CeedOperatorCreateFallback(op); CeedChk(ierr);
+    }
+    // Assemble
+    ierr = op->opfallback->LinearAssemble(op->opfallback, values);
+    CeedChk(ierr);
+  }
+
+  return 0;
+}
+
+/**
+  @brief Assemble the dense element matrices of a linear CeedOperator
+
+  This returns a CeedVector containing the matrix of the operator on each
+    element, before the element contributions are summed by the transpose
+    CeedElemRestriction. The vector 'assembled' is of shape
+      [num_elements, ncomp * elemsize (out), ncomp * elemsize (in)]
+    and contains row-major matrices, with rows and columns ordered as
+    [component, node] following the E-vector layout of the active output and
+    input CeedElemRestrictions. Each element matrix is contiguous, so the
+    batch can be passed directly to dense factorizations for element-by-element
+    preconditioners. The matrices are the same as the blocks produced by
+    CeedOperatorLinearAssemble().
+
+  Note: Currently only non-composite CeedOperators with a single active field
+          are supported.
+
+  @param op             CeedOperator to assemble
+  @param[out] assembled CeedVector to store assembled element matrices
+  @param request        Address of CeedRequest for non-blocking completion, else
+                          @ref CEED_REQUEST_IMMEDIATE
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref User
+**/
+int CeedOperatorLinearAssembleElementMatrices(CeedOperator op,
+    CeedVector *assembled, CeedRequest *request) {
+  int ierr;
+  Ceed ceed = op->ceed;
+  ierr = CeedOperatorCheckReady(ceed, op); CeedChk(ierr);
+  if (op->composite)
+    // LCOV_EXCL_START
+    return CeedError(ceed, 1, "Element matrix assembly not supported for "
+                     "composite operators");
+  // LCOV_EXCL_STOP
+
+  // Use backend version, if available
+  if (op->LinearAssembleElementMatrices) {
+    ierr = op->LinearAssembleElementMatrices(op, assembled, request);
+    CeedChk(ierr);
+  } else {
+    // Fallback to reference Ceed
+    if (!op->opfallback) {
+      ierr = CeedOperatorCreateFallback(op); CeedChk(ierr);
+    }
+    // Assemble
+    ierr = op->opfallback->LinearAssembleElementMatrices(op->opfallback,
+           assembled, request); CeedChk(ierr);
+  }
+
+  return 0;
+}
+
 /**
   @brief Create a multigrid coarse operator and level transfer operators
            for a CeedOperator, creating the prolongation basis from the
@@ -1481,6 +2284,9 @@ int CeedOperatorView(CeedOperator op, FILE *stream) {
       ierr = CeedOperatorSingleView(op->suboperators[i], 1, stream);
       CeedChk(ierr);
     }
+    if (op->profile) {
+      ierr = CeedOperatorStatsView(op, "", stream); CeedChk(ierr);
+    }
   } else {
     fprintf(stream, "CeedOperator\n");
     ierr = CeedOperatorSingleView(op, 0, stream); CeedChk(ierr);
@@ -1489,6 +2295,101 @@ int CeedOperatorView(CeedOperator op, FILE *stream) {
   return 0;
 }
 
+/**
+  @brief Get statistics collected for one phase of CeedOperator application
+
+  Statistics are only collected for operators created while the environment
+    variable CEED_PROFILE is set to a value other than "0"; otherwise all
+    values are zero.  Times are wall clock seconds spent in the phase, summed
+    over all applications.  Bytes moved and floating point operations are
+    model estimates per application multiplied by the number of applications,
+    so dividing by @a time gives the achieved bandwidth and throughput.
+    QFunction flops are not known to the library and are reported as zero.
+    Backends may time the restriction, basis, and QFunction phases once per
+    element or element block, so @a count for these phases is the number of
+    timed intervals rather than the number of operator applications.
+
+  For composite operators, the restriction, basis, and QFunction phases are
+    summed over the sub-operators.
+
+  @param op          CeedOperator to get statistics for
+  @param phase       CeedOperatorPhase to get statistics for
+  @param[out] count  Variable to store number of times phase was executed
+  @param[out] time   Variable to store total time spent in phase, in seconds
+  @param[out] bytes  Variable to store estimated bytes moved in phase
+  @param[out] flops  Variable to store estimated floating point operations
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref User
+**/
+int CeedOperatorGetStats(CeedOperator op, CeedOperatorPhase phase,
+                         uint64_t *count, double *time, double *bytes,
+                         double *flops) {
+  int ierr;
+
+  if (phase < CEED_PHASE_RESTRICTION || phase > CEED_PHASE_TOTAL)
+    // LCOV_EXCL_START
+    return CeedError(op->ceed, 1, "Invalid CeedOperatorPhase %d", phase);
+  // LCOV_EXCL_STOP
+
+  *count = 0;
+  *time = 0;
+  *bytes = 0;
+  *flops = 0;
+  if (op->composite) {
+    for (CeedInt i=0; i<op->numsub; i++) {
+      uint64_t subcount;
+      double subtime, subbytes, subflops;
+      ierr = CeedOperatorGetStats(op->suboperators[i], phase, &subcount,
+                                  &subtime, &subbytes, &subflops);
+      CeedChk(ierr);
+      *count += subcount;
+      *time += subtime;
+      *bytes += subbytes;
+      *flops += subflops;
+    }
+    if (phase == CEED_PHASE_TOTAL) {
+      *count = op->phasecount[phase];
+      *time = op->phasetime[phase];
+    }
+  } else {
+    *count = op->phasecount[phase];
+    *time = op->phasetime[phase];
+    if (op->numelements) {
+      ierr = CeedOperatorGetPhaseEstimate(op, phase, bytes, flops);
+      CeedChk(ierr);
+      *bytes *= op->phasecount[CEED_PHASE_TOTAL];
+      *flops *= op->phasecount[CEED_PHASE_TOTAL];
+    }
+  }
+
+  return 0;
+}
+
+/**
+  @brief Reset statistics collected for a CeedOperator
+
+  @param op  CeedOperator to reset statistics for
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref User
+**/
+int CeedOperatorResetStats(CeedOperator op) {
+  int ierr;
+
+  for (CeedInt phase=0; phase<=CEED_PHASE_TOTAL; phase++) {
+    op->phasecount[phase] = 0;
+    op->phasetime[phase] = 0;
+  }
+  for (CeedInt i=0; i<op->numsub; i++) {
+    ierr = CeedOperatorResetStats(op->suboperators[i]); CeedChk(ierr);
+  }
+
+  return 0;
+}
+
 /**
   @brief Apply CeedOperator to a vector
 
@@ -1505,6 +2406,11 @@ int CeedOperatorView(CeedOperator op, FILE *stream) {
   @param request   Address of CeedRequest for non-blocking completion, else
                      @ref CEED_REQUEST_IMMEDIATE
 
+  With a non-blocking request on a host (`/cpu`) backend the application is
+    queued on a worker thread owned by the Ceed and this function returns
+    immediately.  The operator and vectors must not be accessed until
+    CeedRequestWait() has been called on the request.
+
   @return An error code: 0 - success, otherwise - failure
 
   @ref User
@@ -1515,6 +2421,17 @@ int CeedOperatorApply(CeedOperator op, CeedVector in, CeedVector out,
   Ceed ceed = op->ceed;
   ierr = CeedOperatorCheckReady(ceed, op); CeedChk(ierr);
 
+  // Non-blocking application on host worker thread
+  if (request != CEED_REQUEST_IMMEDIATE && request != CEED_REQUEST_ORDERED) {
+    bool submitted;
+    ierr = CeedRequestSubmit(ceed, CeedOperatorApply, op, in, out, request, &submitted);
+    CeedChk(ierr);
+    if (submitted) return 0;
+  } else {
+    ierr = CeedRequestWaitAll(ceed); CeedChk(ierr);
+  }
+  ierr = CeedOperatorPhaseBegin(op, CEED_PHASE_TOTAL); CeedChk(ierr);
+
   if (op->numelements)  {
     // Standard Operator
     if (op->Apply) {
@@ -1556,12 +2473,10 @@ int CeedOperatorApply(CeedOperator op, CeedVector in, CeedVector out,
         }
       }
       // Apply
-      for (CeedInt i=0; i<op->numsub; i++) {
-        ierr = CeedOperatorApplyAdd(op->suboperators[i], in, out, request);
-        CeedChk(ierr);
-      }
+      ierr = CeedCompositeOperatorApplyAdd(op, in, out, request); CeedChk(ierr);
     }
   }
+  ierr = CeedOperatorPhaseEnd(op, CEED_PHASE_TOTAL); CeedChk(ierr);
 
   return 0;
 }
@@ -1591,6 +2506,17 @@ int CeedOperatorApplyAdd(CeedOperator op, CeedVector in, CeedVector out,
   Ceed ceed = op->ceed;
   ierr = CeedOperatorCheckReady(ceed, op); CeedChk(ierr);
 
+  // Non-blocking application on host worker thread
+  if (request != CEED_REQUEST_IMMEDIATE && request != CEED_REQUEST_ORDERED) {
+    bool submitted;
+    ierr = CeedRequestSubmit(ceed, CeedOperatorApplyAdd, op, in, out, request, &submitted);
+    CeedChk(ierr);
+    if (submitted) return 0;
+  } else {
+    ierr = CeedRequestWaitAll(ceed); CeedChk(ierr);
+  }
+  ierr = CeedOperatorPhaseBegin(op, CEED_PHASE_TOTAL); CeedChk(ierr);
+
   if (op->numelements)  {
     // Standard Operator
     ierr = op->ApplyAdd(op, in, out, request); CeedChk(ierr);
@@ -1599,17 +2525,10 @@ int CeedOperatorApplyAdd(CeedOperator op, CeedVector in, CeedVector out,
     if (op->ApplyAddComposite) {
       ierr = op->ApplyAddComposite(op, in, out, request); CeedChk(ierr);
     } else {
-      CeedInt numsub;
-      ierr = CeedOperatorGetNumSub(op, &numsub); CeedChk(ierr);
-      CeedOperator *suboperators;
-      ierr = CeedOperatorGetSubList(op, &suboperators); CeedChk(ierr);
-
-      for (CeedInt i=0; i<numsub; i++) {
-        ierr = CeedOperatorApplyAdd(suboperators[i], in, out, request);
-        CeedChk(ierr);
-      }
+      ierr = CeedCompositeOperatorApplyAdd(op, in, out, request); CeedChk(ierr);
     }
   }
+  ierr = CeedOperatorPhaseEnd(op, CEED_PHASE_TOTAL); CeedChk(ierr);
 
   return 0;
 }
@@ -1617,6 +2536,9 @@ int CeedOperatorApplyAdd(CeedOperator op, CeedVector in, CeedVector out,
 /**
   @brief Destroy a CeedOperator
 
+  Outstanding non-blocking requests on the Ceed of the operator are completed
+    before it is destroyed.
+
   @param op CeedOperator to destroy
 
   @return An error code: 0 - success, otherwise - failure
@@ -1627,6 +2549,7 @@ int CeedOperatorDestroy(CeedOperator *op) {
   int ierr;
 
   if (!*op || --(*op)->refcount > 0) return 0;
+  ierr = CeedRequestWaitAll((*op)->ceed); CeedChk(ierr);
   if ((*op)->Destroy) {
     ierr = (*op)->Destroy(*op); CeedChk(ierr);
   }
@@ -1663,6 +2586,7 @@ int CeedOperatorDestroy(CeedOperator *op) {
       ierr = CeedFree(&(*op)->outputfields[i]); CeedChk(ierr);
     }
   // Destroy suboperators
+  ierr = CeedCompositeScheduleDestroy(&(*op)->schedule); CeedChk(ierr);
   for (int i=0; i<(*op)->numsub; i++)
     if ((*op)->suboperators[i]) {
       ierr = CeedOperatorDestroy(&(*op)->suboperators[i]); CeedChk(ierr);
@@ -306,6 +306,65 @@ int CeedQFunctionIsIdentity(CeedQFunction qf, bool *isidentity) {
   return 0;
 }
 
+/**
+  @brief Create a copy of a CeedQFunction with the same user function and
+           fields but its own context
+
+  Backends applying a CeedQFunction from several threads use one copy per
+    thread, since applying a CeedQFunction and accessing its context are not
+    thread safe.  For Fortran QFunctions, @a innerctx replaces the user
+    context wrapped by the Fortran stub.
+
+  @param qf             CeedQFunction to copy
+  @param innerctx       User CeedQFunctionContext for the copy, or NULL
+  @param[out] qfcopy    Address of the variable where the copy will be stored
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedQFunctionCreateCopy(CeedQFunction qf, CeedQFunctionContext innerctx,
+                            CeedQFunction *qfcopy) {
+  int ierr;
+
+  ierr = CeedQFunctionCreateInterior(qf->ceed, qf->vlength, qf->function,
+                                     qf->sourcepath, qfcopy); CeedChk(ierr);
+  for (CeedInt i=0; i<qf->numinputfields; i++) {
+    ierr = CeedQFunctionAddInput(*qfcopy, qf->inputfields[i]->fieldname,
+                                 qf->inputfields[i]->size,
+                                 qf->inputfields[i]->emode); CeedChk(ierr);
+  }
+  for (CeedInt i=0; i<qf->numoutputfields; i++) {
+    ierr = CeedQFunctionAddOutput(*qfcopy, qf->outputfields[i]->fieldname,
+                                  qf->outputfields[i]->size,
+                                  qf->outputfields[i]->emode); CeedChk(ierr);
+  }
+  (*qfcopy)->identity = qf->identity;
+
+  if (qf->fortranstatus) {
+    // Wrap the new user context for the Fortran stub
+    CeedFortranContext fctx, fctxcopy;
+    ierr = CeedCalloc(1, &fctxcopy); CeedChk(ierr);
+    ierr = CeedQFunctionContextGetData(qf->ctx, CEED_MEM_HOST, &fctx);
+    CeedChk(ierr);
+    fctxcopy->f = fctx->f;
+    fctxcopy->innerctx = innerctx;
+    ierr = CeedQFunctionContextRestoreData(qf->ctx, &fctx); CeedChk(ierr);
+    CeedQFunctionContext ctx;
+    ierr = CeedQFunctionContextCreate(qf->ceed, &ctx); CeedChk(ierr);
+    ierr = CeedQFunctionContextSetData(ctx, CEED_MEM_HOST, CEED_OWN_POINTER,
+                                       sizeof(*fctxcopy), fctxcopy);
+    CeedChk(ierr);
+    ierr = CeedQFunctionSetContext(*qfcopy, ctx); CeedChk(ierr);
+    ierr = CeedQFunctionContextDestroy(&ctx); CeedChk(ierr);
+    (*qfcopy)->fortranstatus = true;
+  } else if (innerctx) {
+    ierr = CeedQFunctionSetContext(*qfcopy, innerctx); CeedChk(ierr);
+  }
+
+  return 0;
+}
+
 /**
   @brief Get backend data of a CeedQFunction
 
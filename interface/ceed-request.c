@@ -0,0 +1,472 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#define _POSIX_C_SOURCE 200112
+#include <ceed-impl.h>
+#include <ceed-backend.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <string.h>
+
+/// @cond DOXYGEN_SKIP
+struct CeedRequest_private {
+  int (*Apply)(CeedOperator, CeedVector, CeedVector, CeedRequest *);
+  CeedOperator op;
+  CeedVector in, out;
+  CeedRequest next, prevlive, nextlive;
+  bool done;
+  int ierr;
+};
+
+struct CeedRequestQueue_private {
+  pthread_t worker;
+  pthread_mutex_t lock;
+  pthread_cond_t submitted, completed;
+  CeedRequest head, tail, live;
+  CeedInt numpending;
+  bool shutdown;
+};
+
+struct CeedThreadPool_private {
+  pthread_t *workers;
+  CeedInt numworkers;
+  pthread_mutex_t lock;
+  pthread_cond_t started, finished;
+  int (*task)(void *, CeedInt);
+  void *ctx;
+  CeedInt numtasks, nexttask, numbusy;
+  int ierr;
+  bool running, shutdown;
+};
+
+static pthread_key_t CeedThreadPoolKey;
+static pthread_once_t CeedThreadPoolKeyOnce = PTHREAD_ONCE_INIT;
+/// @endcond
+
+/// @file
+/// Implementation of non-blocking CeedRequest handling and host thread pool
+
+/// ----------------------------------------------------------------------------
+/// CeedRequest Library Internal Functions
+/// ----------------------------------------------------------------------------
+/// @addtogroup CeedDeveloper
+/// @{
+
+/**
+  @brief Worker thread main loop, executing queued requests in submission order
+
+  @param ptr  CeedRequestQueue to service
+
+  @ref Developer
+**/
+static void *CeedRequestWorker(void *ptr) {
+  CeedRequestQueue queue = ptr;
+
+  pthread_mutex_lock(&queue->lock);
+  while (true) {
+    while (!queue->head && !queue->shutdown)
+      pthread_cond_wait(&queue->submitted, &queue->lock);
+    if (!queue->head)
+      break;
+    CeedRequest req = queue->head;
+    pthread_mutex_unlock(&queue->lock);
+
+    int ierr = req->Apply(req->op, req->in, req->out, CEED_REQUEST_IMMEDIATE);
+
+    pthread_mutex_lock(&queue->lock);
+    queue->head = req->next;
+    if (!queue->head)
+      queue->tail = NULL;
+    queue->numpending--;
+    req->ierr = ierr;
+    req->done = true;
+    pthread_cond_broadcast(&queue->completed);
+  }
+  pthread_mutex_unlock(&queue->lock);
+
+  return NULL;
+}
+
+/**
+  @brief Create the thread-specific key marking thread pool workers
+
+  @ref Developer
+**/
+static void CeedThreadPoolKeyCreate(void) {
+  pthread_key_create(&CeedThreadPoolKey, NULL);
+}
+
+/**
+  @brief Create the request queue and start its worker thread
+
+  @param ceed  Ceed to create request queue for
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+static int CeedRequestQueueCreate(Ceed ceed) {
+  int ierr;
+  CeedRequestQueue queue;
+
+  ierr = CeedCalloc(1, &queue); CeedChk(ierr);
+  pthread_mutex_init(&queue->lock, NULL);
+  pthread_cond_init(&queue->submitted, NULL);
+  pthread_cond_init(&queue->completed, NULL);
+  if (pthread_create(&queue->worker, NULL, CeedRequestWorker, queue)) {
+    // LCOV_EXCL_START
+    pthread_cond_destroy(&queue->completed);
+    pthread_cond_destroy(&queue->submitted);
+    pthread_mutex_destroy(&queue->lock);
+    ierr = CeedFree(&queue); CeedChk(ierr);
+    return CeedError(ceed, 1, "Unable to start request worker thread");
+    // LCOV_EXCL_STOP
+  }
+  ceed->requestqueue = queue;
+
+  return 0;
+}
+
+/**
+  @brief Submit a CeedOperator application for non-blocking completion
+
+  Requests are executed by a single worker thread owned by the Ceed, in the
+    order they are submitted.  Only host (`/cpu`) backends execute requests
+    asynchronously; for other backends @a submitted is set to false and
+    `*request` to NULL, and the caller should apply the operator itself.
+
+  @param ceed            Ceed owning the operator
+  @param apply           Function to apply the operator, called with
+                           @ref CEED_REQUEST_IMMEDIATE by the worker
+  @param op              CeedOperator to apply
+  @param in              CeedVector containing input state
+  @param out             CeedVector to store or sum result in
+  @param request         Address of CeedRequest for non-blocking completion
+  @param[out] submitted  Boolean flag indicating if the request was queued
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+int CeedRequestSubmit(Ceed ceed,
+                      int (*apply)(CeedOperator, CeedVector, CeedVector,
+                                   CeedRequest *),
+                      CeedOperator op, CeedVector in, CeedVector out,
+                      CeedRequest *request, bool *submitted) {
+  int ierr;
+
+  *submitted = false;
+  *request = NULL;
+  if (!ceed->resource || strncmp(ceed->resource, "/cpu/", 5))
+    return 0;
+  if (!ceed->requestqueue) {
+    ierr = CeedRequestQueueCreate(ceed); CeedChk(ierr);
+  }
+  CeedRequestQueue queue = ceed->requestqueue;
+  // Nested submissions from the worker complete immediately
+  if (pthread_equal(pthread_self(), queue->worker))
+    return 0;
+
+  CeedRequest req;
+  ierr = CeedCalloc(1, &req); CeedChk(ierr);
+  req->Apply = apply;
+  req->op = op;
+  req->in = in;
+  req->out = out;
+
+  // The queue owns the request until it is waited on
+  pthread_mutex_lock(&queue->lock);
+  req->nextlive = queue->live;
+  if (queue->live)
+    queue->live->prevlive = req;
+  queue->live = req;
+  if (queue->tail)
+    queue->tail->next = req;
+  else
+    queue->head = req;
+  queue->tail = req;
+  queue->numpending++;
+  pthread_cond_signal(&queue->submitted);
+  pthread_mutex_unlock(&queue->lock);
+
+  *request = req;
+  *submitted = true;
+  return 0;
+}
+
+/**
+  @brief Wait for all requests submitted to a Ceed to complete
+
+  This is a no-op when called from the worker thread itself, or from a
+    thread pool worker, so that operations executed by either may use the
+    blocking interfaces.
+
+  @param ceed  Ceed to wait for
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+int CeedRequestWaitAll(Ceed ceed) {
+  CeedRequestQueue queue = ceed->requestqueue;
+
+  if (!queue || pthread_equal(pthread_self(), queue->worker))
+    return 0;
+  // Thread pool tasks run on behalf of a caller that already waited
+  pthread_once(&CeedThreadPoolKeyOnce, CeedThreadPoolKeyCreate);
+  if (pthread_getspecific(CeedThreadPoolKey))
+    return 0;
+  pthread_mutex_lock(&queue->lock);
+  while (queue->numpending)
+    pthread_cond_wait(&queue->completed, &queue->lock);
+  pthread_mutex_unlock(&queue->lock);
+
+  return 0;
+}
+
+/**
+  @brief Wait for outstanding requests, stop the worker thread, and free
+           requests that were never waited on
+
+  @param ceed  Ceed to destroy request queue for
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+int CeedRequestQueueDestroy(Ceed ceed) {
+  int ierr;
+  CeedRequestQueue queue = ceed->requestqueue;
+
+  if (!queue)
+    return 0;
+  pthread_mutex_lock(&queue->lock);
+  queue->shutdown = true;
+  pthread_cond_signal(&queue->submitted);
+  pthread_mutex_unlock(&queue->lock);
+  pthread_join(queue->worker, NULL);
+
+  while (queue->live) {
+    CeedRequest req = queue->live;
+    queue->live = req->nextlive;
+    ierr = CeedFree(&req); CeedChk(ierr);
+  }
+  pthread_cond_destroy(&queue->completed);
+  pthread_cond_destroy(&queue->submitted);
+  pthread_mutex_destroy(&queue->lock);
+  ierr = CeedFree(&ceed->requestqueue); CeedChk(ierr);
+
+  return 0;
+}
+
+/**
+  @brief Thread pool worker main loop, claiming tasks of the current run
+
+  @param ptr  CeedThreadPool to serve
+
+  @ref Developer
+**/
+static void *CeedThreadPoolWorker(void *ptr) {
+  CeedThreadPool pool = ptr;
+
+  pthread_setspecific(CeedThreadPoolKey, pool);
+  pthread_mutex_lock(&pool->lock);
+  while (true) {
+    while (pool->nexttask >= pool->numtasks && !pool->shutdown)
+      pthread_cond_wait(&pool->started, &pool->lock);
+    if (pool->shutdown)
+      break;
+    CeedInt i = pool->nexttask++;
+    pthread_mutex_unlock(&pool->lock);
+
+    int ierr = pool->task(pool->ctx, i);
+
+    pthread_mutex_lock(&pool->lock);
+    if (ierr && !pool->ierr)
+      pool->ierr = ierr;
+    if (--pool->numbusy == 0)
+      pthread_cond_signal(&pool->finished);
+  }
+  pthread_mutex_unlock(&pool->lock);
+
+  return NULL;
+}
+
+/**
+  @brief Run tasks concurrently on the host thread pool of a Ceed
+
+  Calls `task(ctx, i)` once for each `0 <= i < numtasks` and returns when all
+    tasks have completed.  The calling thread executes tasks alongside the
+    pool workers, which are started on first use and kept for later runs.
+    Runs that are nested in a task, or that overlap a run from another
+    thread, execute their tasks sequentially on the calling thread.
+
+  @param ceed      Ceed owning the thread pool
+  @param numtasks  Number of tasks to run
+  @param task      Function executing a single task
+  @param ctx       User context passed to @a task
+
+  @return The first nonzero error code returned by a task, otherwise 0
+
+  @ref Developer
+**/
+int CeedThreadPoolRun(Ceed ceed, CeedInt numtasks,
+                      int (*task)(void *, CeedInt), void *ctx) {
+  int ierr;
+
+  if (!ceed->threadpool && numtasks > 1) {
+    CeedThreadPool pool;
+    ierr = CeedCalloc(1, &pool); CeedChk(ierr);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->started, NULL);
+    pthread_cond_init(&pool->finished, NULL);
+    pthread_once(&CeedThreadPoolKeyOnce, CeedThreadPoolKeyCreate);
+    ceed->threadpool = pool;
+  }
+  CeedThreadPool pool = ceed->threadpool;
+  if (pool)
+    pthread_mutex_lock(&pool->lock);
+  if (!pool || pool->running) {
+    if (pool)
+      pthread_mutex_unlock(&pool->lock);
+    for (CeedInt i=0; i<numtasks; i++) {
+      ierr = task(ctx, i); CeedChk(ierr);
+    }
+    return 0;
+  }
+
+  // Start workers as needed; the calling thread runs tasks too
+  if (pool->numworkers < numtasks - 1) {
+    ierr = CeedRealloc(numtasks - 1, &pool->workers);
+    if (ierr) {
+      // LCOV_EXCL_START
+      pthread_mutex_unlock(&pool->lock);
+      return ierr;
+      // LCOV_EXCL_STOP
+    }
+    while (pool->numworkers < numtasks - 1 &&
+           !pthread_create(&pool->workers[pool->numworkers], NULL,
+                           CeedThreadPoolWorker, pool))
+      pool->numworkers++;
+  }
+
+  pool->running = true;
+  pool->task = task;
+  pool->ctx = ctx;
+  pool->numtasks = numtasks;
+  pool->nexttask = 0;
+  pool->numbusy = numtasks;
+  pool->ierr = 0;
+  pthread_cond_broadcast(&pool->started);
+  while (pool->nexttask < pool->numtasks) {
+    CeedInt i = pool->nexttask++;
+    pthread_mutex_unlock(&pool->lock);
+
+    ierr = task(ctx, i);
+
+    pthread_mutex_lock(&pool->lock);
+    if (ierr && !pool->ierr)
+      pool->ierr = ierr;
+    pool->numbusy--;
+  }
+  while (pool->numbusy)
+    pthread_cond_wait(&pool->finished, &pool->lock);
+  pool->running = false;
+  ierr = pool->ierr;
+  pthread_mutex_unlock(&pool->lock);
+
+  return ierr;
+}
+
+/**
+  @brief Stop the thread pool workers
+
+  @param ceed  Ceed to destroy thread pool for
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+int CeedThreadPoolDestroy(Ceed ceed) {
+  int ierr;
+  CeedThreadPool pool = ceed->threadpool;
+
+  if (!pool)
+    return 0;
+  pthread_mutex_lock(&pool->lock);
+  pool->shutdown = true;
+  pthread_cond_broadcast(&pool->started);
+  pthread_mutex_unlock(&pool->lock);
+  for (CeedInt i=0; i<pool->numworkers; i++)
+    pthread_join(pool->workers[i], NULL);
+
+  pthread_cond_destroy(&pool->finished);
+  pthread_cond_destroy(&pool->started);
+  pthread_mutex_destroy(&pool->lock);
+  ierr = CeedFree(&pool->workers); CeedChk(ierr);
+  ierr = CeedFree(&ceed->threadpool); CeedChk(ierr);
+
+  return 0;
+}
+
+/// @}
+
+/// ----------------------------------------------------------------------------
+/// CeedRequest Public API
+/// ----------------------------------------------------------------------------
+/// @addtogroup CeedUser
+/// @{
+
+/**
+  @brief Wait for a CeedRequest to complete.
+
+  Calling CeedRequestWait on a NULL request is a no-op.  Objects used by the
+    request, such as the CeedOperator and its input and output CeedVectors,
+    must not be accessed or destroyed until the request has completed.
+    Requests that are never waited on are freed by CeedDestroy(), after which
+    they must not be waited on.
+
+  @param req Address of CeedRequest to wait for; zeroed on completion.
+
+  @return The error code of the completed operation: 0 - success,
+            otherwise - failure
+
+  @ref User
+**/
+int CeedRequestWait(CeedRequest *req) {
+  int ierr;
+
+  if (!*req)
+    return 0;
+  CeedRequestQueue queue = (*req)->op->ceed->requestqueue;
+  pthread_mutex_lock(&queue->lock);
+  while (!(*req)->done)
+    pthread_cond_wait(&queue->completed, &queue->lock);
+  if ((*req)->prevlive)
+    (*req)->prevlive->nextlive = (*req)->nextlive;
+  else
+    queue->live = (*req)->nextlive;
+  if ((*req)->nextlive)
+    (*req)->nextlive->prevlive = (*req)->prevlive;
+  pthread_mutex_unlock(&queue->lock);
+
+  int reqierr = (*req)->ierr;
+  ierr = CeedFree(req); CeedChk(ierr);
+
+  return reqierr;
+}
+
+/// @}
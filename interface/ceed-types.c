@@ -55,3 +55,17 @@ const char *const CeedElemTopologies[] = {
   [CEED_PRISM] = "prism",
   [CEED_HEX] = "hexahedron",
 };
+
+const char *const CeedStorageModes[] = {
+  [CEED_STORAGE_FULL] = "full",
+  [CEED_STORAGE_SYMMETRIC] = "symmetric",
+  [CEED_STORAGE_SINGLE] = "single",
+  [CEED_STORAGE_SYMMETRIC_SINGLE] = "symmetric single",
+};
+
+const char *const CeedOperatorPhases[] = {
+  [CEED_PHASE_RESTRICTION] = "restriction",
+  [CEED_PHASE_BASIS] = "basis",
+  [CEED_PHASE_QFUNCTION] = "qfunction",
+  [CEED_PHASE_TOTAL] = "total",
+};
@@ -18,6 +18,7 @@
 #include <ceed-impl.h>
 #include <ceed-backend.h>
 #include <limits.h>
+#include <pthread.h>
 #include <stdarg.h>
 #include <stddef.h>
 #include <stdio.h>
@@ -35,6 +36,9 @@ static struct {
 } backends[32];
 static size_t num_backends;
 
+// Guards the workspace pools of all Ceed contexts
+static pthread_mutex_t CeedWorkArrayLock = PTHREAD_MUTEX_INITIALIZER;
+
 #define CEED_FTABLE_ENTRY(class, method) \
   {#class #method, offsetof(struct class ##_private, method)}
 /// @endcond
@@ -88,29 +92,13 @@ CeedRequest *const CEED_REQUEST_IMMEDIATE = &ceed_request_immediate;
   `op2` until `op1` has completed.
 
   @todo The current implementation is overly strict, offering equivalent
-  semantics to @ref CEED_REQUEST_IMMEDIATE.
+  semantics to @ref CEED_REQUEST_IMMEDIATE once previously submitted
+  non-blocking requests have completed.
 
   @sa CEED_REQUEST_IMMEDIATE
  */
 CeedRequest *const CEED_REQUEST_ORDERED = &ceed_request_ordered;
 
-/**
-  @brief Wait for a CeedRequest to complete.
-
-  Calling CeedRequestWait on a NULL request is a no-op.
-
-  @param req Address of CeedRequest to wait for; zeroed on completion.
-
-  @return An error code: 0 - success, otherwise - failure
-
-  @ref User
-**/
-int CeedRequestWait(CeedRequest *req) {
-  if (!*req)
-    return 0;
-  return CeedError(NULL, 2, "CeedRequestWait not implemented");
-}
-
 /// @}
 
 /// ----------------------------------------------------------------------------
@@ -255,9 +243,16 @@ int CeedReallocArray(size_t n, size_t unit, void *p) {
 
 /** Free memory allocated using CeedMalloc() or CeedCalloc()
 
+  This is also used to free arrays returned to the user by libCEED, such as
+    the COO indices from CeedOperatorLinearAssembleSymbolic().
+
   @param p address of pointer to memory.  This argument is of type void* to
              avoid needing a cast, but is the address of the pointer (which is
              zeroed) rather than the pointer.
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref User
 **/
 int CeedFree(void *p) {
   free(*(void **)p);
@@ -295,6 +290,88 @@ int CeedRegister(const char *prefix, int (*init)(const char *, Ceed),
   return 0;
 }
 
+/**
+  @brief Check if a backend is registered with the given prefix
+
+  Unlike CeedInit(), which picks the best partial match, the prefix must match
+    the prefix of a registered backend exactly.
+
+  @param prefix             Prefix of the backend, as in "/cpu/self/avx/blocked"
+  @param[out] isregistered  Variable to store registration status
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedIsRegistered(const char *prefix, bool *isregistered) {
+  int ierr;
+  ierr = CeedRegisterAll(); CeedChk(ierr);
+
+  *isregistered = false;
+  for (size_t i=0; i<num_backends; i++)
+    if (!strcmp(prefix, backends[i].prefix))
+      *isregistered = true;
+  return 0;
+}
+
+/**
+  @brief Get the root of a resource, without its query arguments
+
+  Query arguments follow the root after ':' and are separated by ',', as in
+    "/cpu/self/opt/blocked:blksize=16".
+
+  @param ceed        Ceed context for error handling
+  @param resource    Full resource, as passed to the backend init function
+  @param[out] root   Variable to store the root, free with CeedFree()
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedGetResourceRoot(Ceed ceed, const char *resource, char **root) {
+  int ierr;
+  size_t len = strcspn(resource, ":");
+
+  ierr = CeedCalloc(len+1, root); CeedChk(ierr);
+  memcpy(*root, resource, len);
+  return 0;
+}
+
+/**
+  @brief Get an integer query argument of a resource
+
+  @param ceed        Ceed context for error handling
+  @param resource    Full resource, as passed to the backend init function
+  @param key         Name of the query argument, as in "blksize"
+  @param[out] value  Variable to store the value; left unchanged if the
+                       resource has no such query argument
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedGetResourceQueryInt(Ceed ceed, const char *resource, const char *key,
+                            CeedInt *value) {
+  const size_t keylen = strlen(key);
+  const char *query = strchr(resource, ':');
+
+  while (query) {
+    query++;
+    if (!strncmp(query, key, keylen) && query[keylen] == '=') {
+      char *end;
+      long val = strtol(&query[keylen+1], &end, 10);
+      if (end == &query[keylen+1] || (*end && *end != ','))
+        // LCOV_EXCL_START
+        return CeedError(ceed, 1, "Invalid value of %s in resource: %s", key,
+                         resource);
+      // LCOV_EXCL_STOP
+      *value = val;
+    }
+    query = strchr(query, ',');
+  }
+  return 0;
+}
+
 /**
   @brief Return debugging status flag
 
@@ -586,6 +663,100 @@ int CeedSetData(Ceed ceed, void *data) {
   return 0;
 }
 
+/**
+  @brief Borrow a work array from the workspace pool of a Ceed context
+
+  The pool is shared by the Ceed context and all of its delegates, so
+    operators can borrow scratch storage, such as E-vector data, for the
+    duration of an apply instead of holding it for their whole lifetime.
+    The smallest free array that is large enough is reused, otherwise the
+    largest free array is grown, so the pool only grows to the largest set
+    of arrays borrowed at the same time. Return the array with
+    @ref CeedRestoreWorkArray().  Borrowing and returning arrays is safe
+    from concurrent threads.
+
+  @param ceed        Ceed context to borrow from
+  @param length      Minimum number of CeedScalar entries in the work array
+  @param[out] array  Address to save the work array to; the contents are
+                       undefined
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedGetWorkArray(Ceed ceed, CeedInt length, CeedScalar **array) {
+  int ierr = 0;
+  Ceed parent;
+  ierr = CeedGetParent(ceed, &parent); CeedChk(ierr);
+
+  pthread_mutex_lock(&CeedWorkArrayLock);
+  // Find the best free array
+  int best = -1, largest = -1;
+  for (int i=0; i<parent->workarraycount; i++) {
+    workarray *work = &parent->workarrays[i];
+    if (work->inuse)
+      continue;
+    if (work->length >= (size_t)length &&
+        (best < 0 || work->length < parent->workarrays[best].length))
+      best = i;
+    if (largest < 0 || work->length > parent->workarrays[largest].length)
+      largest = i;
+  }
+
+  // Grow the largest free array, or add a new one
+  if (best < 0) {
+    if (largest >= 0) {
+      best = largest;
+      ierr = CeedFree(&parent->workarrays[best].array);
+    } else {
+      best = parent->workarraycount;
+      ierr = CeedRealloc(best+1, &parent->workarrays);
+      if (!ierr) {
+        parent->workarrays[best].array = NULL;
+        parent->workarraycount++;
+      }
+    }
+    if (!ierr)
+      ierr = CeedMalloc(length, &parent->workarrays[best].array);
+    parent->workarrays[best].length = ierr ? 0 : length;
+  }
+  if (!ierr) {
+    parent->workarrays[best].inuse = true;
+    *array = parent->workarrays[best].array;
+  }
+  pthread_mutex_unlock(&CeedWorkArrayLock);
+  return ierr;
+}
+
+/**
+  @brief Return a work array borrowed with @ref CeedGetWorkArray()
+
+  @param ceed         Ceed context the array was borrowed from
+  @param[out] array   Address of the work array; set to NULL on return
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedRestoreWorkArray(Ceed ceed, CeedScalar **array) {
+  int ierr;
+  Ceed parent;
+  ierr = CeedGetParent(ceed, &parent); CeedChk(ierr);
+
+  pthread_mutex_lock(&CeedWorkArrayLock);
+  for (int i=0; i<parent->workarraycount; i++)
+    if (parent->workarrays[i].inuse && parent->workarrays[i].array == *array) {
+      parent->workarrays[i].inuse = false;
+      pthread_mutex_unlock(&CeedWorkArrayLock);
+      *array = NULL;
+      return 0;
+    }
+  pthread_mutex_unlock(&CeedWorkArrayLock);
+  // LCOV_EXCL_START
+  return CeedError(ceed, 1, "Array was not borrowed from the workspace pool");
+  // LCOV_EXCL_STOP
+}
+
 /// @}
 
 /// ----------------------------------------------------------------------------
@@ -693,6 +864,9 @@ int CeedInit(const char *resource, Ceed *ceed) {
     CEED_FTABLE_ENTRY(CeedOperator, LinearAssembleAddDiagonal),
     CEED_FTABLE_ENTRY(CeedOperator, LinearAssemblePointBlockDiagonal),
     CEED_FTABLE_ENTRY(CeedOperator, LinearAssembleAddPointBlockDiagonal),
+    CEED_FTABLE_ENTRY(CeedOperator, LinearAssembleSymbolic),
+    CEED_FTABLE_ENTRY(CeedOperator, LinearAssemble),
+    CEED_FTABLE_ENTRY(CeedOperator, LinearAssembleElementMatrices),
     CEED_FTABLE_ENTRY(CeedOperator, CreateFDMElementInverse),
     CEED_FTABLE_ENTRY(CeedOperator, Apply),
     CEED_FTABLE_ENTRY(CeedOperator, ApplyComposite),
@@ -772,6 +946,23 @@ int CeedGetPreferredMemType(Ceed ceed, CeedMemType *type) {
   return 0;
 }
 
+/**
+  @brief Get the floating point type of CeedScalar the library was built with
+
+  Applications can compare this with CEED_SCALAR_TYPE to detect a mismatch
+    between the installed header and library.
+
+  @param[out] type  Variable to store the scalar type
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref User
+**/
+int CeedGetScalarType(CeedScalarType *type) {
+  *type = CEED_SCALAR_TYPE;
+  return 0;
+}
+
 /**
   @brief Get deterministic status of Ceed
 
@@ -823,6 +1014,8 @@ int CeedView(Ceed ceed, FILE *stream) {
 int CeedDestroy(Ceed *ceed) {
   int ierr;
   if (!*ceed || --(*ceed)->refcount > 0) return 0;
+  ierr = CeedRequestQueueDestroy(*ceed); CeedChk(ierr);
+  ierr = CeedThreadPoolDestroy(*ceed); CeedChk(ierr);
   if ((*ceed)->delegate) {
     ierr = CeedDestroy(&(*ceed)->delegate); CeedChk(ierr);
   }
@@ -839,6 +1032,10 @@ int CeedDestroy(Ceed *ceed) {
     ierr = (*ceed)->Destroy(*ceed); CeedChk(ierr);
   }
 
+  for (int i=0; i<(*ceed)->workarraycount; i++) {
+    ierr = CeedFree(&(*ceed)->workarrays[i].array); CeedChk(ierr);
+  }
+  ierr = CeedFree(&(*ceed)->workarrays); CeedChk(ierr);
   ierr = CeedFree(&(*ceed)->foffsets); CeedChk(ierr);
   ierr = CeedFree(&(*ceed)->resource); CeedChk(ierr);
   ierr = CeedDestroy(&(*ceed)->opfallbackceed); CeedChk(ierr);
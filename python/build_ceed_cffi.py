@@ -32,6 +32,9 @@ with open(os.path.abspath("include/ceed.h")) as f:
     lines = [line.replace("CEED_EXTERN", "extern") for line in lines]
     header = '\n'.join(lines)
     header = header.split("static inline CeedInt CeedIntPow", 1)[0]
+    # Note: the Python interface uses double precision CeedScalar; Ceed()
+    #   refuses a library built with SCALAR=float
+    header = header.replace("typedef float CeedScalar;\n", "")
     header += '\nextern int CeedVectorGetState(CeedVector, uint64_t*);'
     # Note: cffi cannot handle vargs
     header = re.sub("va_list", "const char *", header)
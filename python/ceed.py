@@ -39,6 +39,13 @@ class Ceed():
         # libCEED object
         self._pointer = ffi.new("Ceed *")
 
+        # The Python interface passes float64 arrays as CeedScalar
+        scalar_type = ffi.new("CeedScalarType *")
+        lib.CeedGetScalarType(scalar_type)
+        if scalar_type[0] != lib.CEED_SCALAR_FP64:
+            raise Exception("The Python interface requires libCEED built "
+                            "with SCALAR=double")
+
         # libCEED call
         resourceAscii = ffi.new("char[]", resource.encode("ascii"))
         os.environ["CEED_ERROR_HANDLER"] = "return"
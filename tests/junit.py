@@ -86,6 +86,11 @@ def run(test, backends):
                                 stdout=proc.stdout,
                                 stderr=proc.stderr)
                 ref_stdout = os.path.join('tests/output', test + '.out')
+                # Single precision builds have their own reference output where
+                # printed values differ in the trailing digits
+                ref_stdout_fp32 = os.path.join('tests/output/fp32', test + '.out')
+                if os.environ.get('SCALAR') == 'float' and os.path.isfile(ref_stdout_fp32):
+                    ref_stdout = ref_stdout_fp32
 
             if not case.is_skipped() and proc.stderr:
                 if 'OCCA backend failed to use' in proc.stderr:
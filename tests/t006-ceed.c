@@ -0,0 +1,26 @@
+/// @file
+/// Test scalar type of the library matches the header
+/// \test Test scalar type of the library matches the header
+#include <ceed.h>
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  CeedScalarType type;
+
+  CeedInit(argv[1], &ceed);
+
+  CeedGetScalarType(&type);
+  if (type != CEED_SCALAR_TYPE)
+    // LCOV_EXCL_START
+    return CeedError(ceed, 1, "Scalar type of library %d != header %d", type,
+                     CEED_SCALAR_TYPE);
+  // LCOV_EXCL_STOP
+  if (sizeof(CeedScalar) != (type == CEED_SCALAR_FP32 ? 4 : 8))
+    // LCOV_EXCL_START
+    return CeedError(ceed, 1, "Size of CeedScalar %zu does not match type",
+                     sizeof(CeedScalar));
+  // LCOV_EXCL_STOP
+
+  CeedDestroy(&ceed);
+  return 0;
+}
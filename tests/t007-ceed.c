@@ -0,0 +1,58 @@
+/// @file
+/// Test reuse of work arrays from the workspace pool
+/// \test Test reuse of work arrays from the workspace pool
+#include <ceed.h>
+#include <ceed-backend.h>
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  CeedScalar *a, *b, *c, *big;
+
+  CeedInit(argv[1], &ceed);
+
+  // Two arrays in use at the same time are distinct
+  CeedGetWorkArray(ceed, 10, &a);
+  CeedGetWorkArray(ceed, 100, &b);
+  if (a == b)
+    // LCOV_EXCL_START
+    printf("Work arrays in use at the same time must be distinct\n");
+  // LCOV_EXCL_STOP
+  for (CeedInt i=0; i<10; i++)
+    a[i] = i;
+  for (CeedInt i=0; i<100; i++)
+    b[i] = -i;
+  big = b;
+  CeedRestoreWorkArray(ceed, &a);
+  CeedRestoreWorkArray(ceed, &b);
+  if (a || b)
+    // LCOV_EXCL_START
+    printf("Restored work arrays must be set to NULL\n");
+  // LCOV_EXCL_STOP
+
+  // The smallest free array that is large enough is reused
+  CeedGetWorkArray(ceed, 50, &c);
+  if (c != big)
+    // LCOV_EXCL_START
+    printf("Work array of length 100 was not reused for length 50\n");
+  // LCOV_EXCL_STOP
+  for (CeedInt i=0; i<50; i++)
+    c[i] = i;
+  CeedRestoreWorkArray(ceed, &c);
+
+  // Growing the pool keeps every entry usable
+  CeedGetWorkArray(ceed, 200, &a);
+  CeedGetWorkArray(ceed, 300, &b);
+  CeedGetWorkArray(ceed, 5, &c);
+  for (CeedInt i=0; i<200; i++)
+    a[i] = i;
+  for (CeedInt i=0; i<300; i++)
+    b[i] = i;
+  for (CeedInt i=0; i<5; i++)
+    c[i] = i;
+  CeedRestoreWorkArray(ceed, &c);
+  CeedRestoreWorkArray(ceed, &a);
+  CeedRestoreWorkArray(ceed, &b);
+
+  CeedDestroy(&ceed);
+  return 0;
+}
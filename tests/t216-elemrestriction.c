@@ -0,0 +1,119 @@
+/// @file
+/// Test element restriction block coloring
+/// \test Test element restriction block coloring
+#include <ceed-backend.h>
+
+// Check that each block has exactly one color and that blocks of the same
+//   color touch disjoint L-vector entries, including all components. The
+//   entries touched by a block are found by applying its transpose.
+static void CheckColoring(Ceed ceed, CeedElemRestriction r, const char *name) {
+  CeedInt ncolors, nblk, blksize, elemsize, ncomp, lsize;
+  const CeedInt *colorptr, *colorblks;
+  const CeedScalar *ll;
+  CeedVector e, l;
+
+  CeedElemRestrictionGetNumBlocks(r, &nblk);
+  CeedElemRestrictionGetBlockSize(r, &blksize);
+  CeedElemRestrictionGetElementSize(r, &elemsize);
+  CeedElemRestrictionGetNumComponents(r, &ncomp);
+  CeedElemRestrictionGetLVectorSize(r, &lsize);
+  CeedInt count[nblk], owner[lsize];
+  CeedVectorCreate(ceed, blksize*elemsize*ncomp, &e);
+  CeedVectorSetValue(e, 1.0);
+  CeedVectorCreate(ceed, lsize, &l);
+
+  CeedElemRestrictionGetColoring(r, &ncolors, &colorptr, &colorblks);
+  if (ncolors < 1 || ncolors > nblk || colorptr[ncolors] != nblk)
+    // LCOV_EXCL_START
+    printf("%s: Invalid number of colors %d for %d blocks\n", name, ncolors,
+           nblk);
+  // LCOV_EXCL_STOP
+  for (CeedInt b=0; b<nblk; b++)
+    count[b] = 0;
+  for (CeedInt c=0; c<ncolors; c++) {
+    for (CeedInt i=0; i<lsize; i++)
+      owner[i] = -1;
+    for (CeedInt i=colorptr[c]; i<colorptr[c+1]; i++) {
+      CeedInt b = colorblks[i];
+      count[b]++;
+      CeedVectorSetValue(l, 0.0);
+      CeedElemRestrictionApplyBlock(r, b, CEED_TRANSPOSE, e, l,
+                                    CEED_REQUEST_IMMEDIATE);
+      CeedVectorGetArrayRead(l, CEED_MEM_HOST, &ll);
+      for (CeedInt n=0; n<lsize; n++) {
+        if (ll[n] == 0.0)
+          continue;
+        if (owner[n] >= 0)
+          // LCOV_EXCL_START
+          printf("%s: Blocks %d and %d of color %d share entry %d\n", name,
+                 owner[n], b, c, n);
+        // LCOV_EXCL_STOP
+        owner[n] = b;
+      }
+      CeedVectorRestoreArrayRead(l, &ll);
+    }
+  }
+  for (CeedInt b=0; b<nblk; b++)
+    if (count[b] != 1)
+      // LCOV_EXCL_START
+      printf("%s: Block %d appears %d times in coloring\n", name, b, count[b]);
+  // LCOV_EXCL_STOP
+
+  CeedVectorDestroy(&e);
+  CeedVectorDestroy(&l);
+}
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  const CeedInt nx = 5, ny = 4, ne = nx*ny, blksize = 4, ncomp = 2;
+  const CeedInt lsize = (nx+1)*(ny+1);
+  const CeedInt strides[3] = {1, 4, 4*ncomp};
+  CeedInt ind[4*ne], indring[2*ne];
+  CeedElemRestriction r;
+
+  CeedInit(argv[1], &ceed);
+
+  // 2D mesh of bilinear quadrilaterals
+  for (CeedInt i=0; i<nx; i++)
+    for (CeedInt j=0; j<ny; j++) {
+      CeedInt e = i*ny + j;
+      ind[4*e+0] = i*(ny+1) + j;
+      ind[4*e+1] = i*(ny+1) + j + 1;
+      ind[4*e+2] = (i+1)*(ny+1) + j;
+      ind[4*e+3] = (i+1)*(ny+1) + j + 1;
+    }
+
+  // Periodic 1D mesh, where an odd number of elements needs three colors
+  for (CeedInt e=0; e<ne-1; e++) {
+    indring[2*e+0] = e;
+    indring[2*e+1] = (e+1) % (ne-1);
+  }
+
+  CeedElemRestrictionCreate(ceed, ne, 4, 1, 1, lsize, CEED_MEM_HOST,
+                            CEED_USE_POINTER, ind, &r);
+  CheckColoring(ceed, r, "offsets");
+  CeedElemRestrictionDestroy(&r);
+
+  CeedElemRestrictionCreate(ceed, ne, 4, ncomp, lsize, ncomp*lsize,
+                            CEED_MEM_HOST, CEED_USE_POINTER, ind, &r);
+  CheckColoring(ceed, r, "components");
+  CeedElemRestrictionDestroy(&r);
+
+  CeedElemRestrictionCreateBlocked(ceed, ne, 4, blksize, 1, 1, lsize,
+                                   CEED_MEM_HOST, CEED_USE_POINTER, ind, &r);
+  CheckColoring(ceed, r, "blocked");
+  CeedElemRestrictionDestroy(&r);
+
+  CeedElemRestrictionCreate(ceed, ne-1, 2, 1, 1, ne-1, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indring, &r);
+  CheckColoring(ceed, r, "periodic");
+  CeedElemRestrictionDestroy(&r);
+
+  CeedElemRestrictionCreateStrided(ceed, ne, 4, ncomp, ncomp*4*ne, strides,
+                                   &r);
+  CheckColoring(ceed, r, "strided");
+  CeedElemRestrictionDestroy(&r);
+
+  CeedDestroy(&ceed);
+  return 0;
+}
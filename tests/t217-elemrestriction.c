@@ -0,0 +1,108 @@
+/// @file
+/// Test transpose element restriction with and without the transpose map
+/// \test Test transpose element restriction with and without the transpose map
+#define _POSIX_C_SOURCE 200112L
+#include <ceed.h>
+#include <stdlib.h>
+
+// Apply the transpose of a restriction to a non-zero E-vector, summing into a
+//   non-zero L-vector
+static void ApplyTranspose(CeedElemRestriction r, CeedInt lsize,
+                           CeedScalar *out) {
+  CeedVector e, l;
+  CeedInt esize;
+  CeedScalar *ee;
+  const CeedScalar *ll;
+
+  CeedElemRestrictionCreateVector(r, &l, &e);
+  CeedVectorGetLength(e, &esize);
+  CeedVectorGetArray(e, CEED_MEM_HOST, &ee);
+  for (CeedInt i=0; i<esize; i++)
+    ee[i] = 1.0/(i+1);
+  CeedVectorRestoreArray(e, &ee);
+  CeedVectorSetValue(l, 0.5);
+  CeedElemRestrictionApply(r, CEED_TRANSPOSE, e, l, CEED_REQUEST_IMMEDIATE);
+  CeedVectorGetArrayRead(l, CEED_MEM_HOST, &ll);
+  for (CeedInt i=0; i<lsize; i++)
+    out[i] = ll[i];
+  CeedVectorRestoreArrayRead(l, &ll);
+  CeedVectorDestroy(&e);
+  CeedVectorDestroy(&l);
+}
+
+// The gather over the transpose map sums contributions in the same order as
+//   the scatter, so the results agree exactly
+static void Compare(const char *name, CeedInt lsize, const CeedScalar *u,
+                    const CeedScalar *v) {
+  for (CeedInt i=0; i<lsize; i++)
+    if (u[i] != v[i])
+      // LCOV_EXCL_START
+      printf("%s [%d] %f != %f\n", name, i, v[i], u[i]);
+  // LCOV_EXCL_STOP
+}
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  const CeedInt nx = 5, ny = 3, ne = nx*ny, ncomp = 2, blksize = 4;
+  const CeedInt nnodes = (nx+1)*(ny+1), lsize = ncomp*nnodes;
+  const CeedInt strides[3] = {1, 4, 4*ncomp};
+  CeedInt ind[4*ne], indi[4*ne];
+  CeedScalar u[3*lsize + 2*ncomp*4*ne], v[3*lsize + 2*ncomp*4*ne];
+  CeedElemRestriction r;
+
+  // 2D mesh of bilinear quadrilaterals, with a partial last block
+  for (CeedInt i=0; i<nx; i++)
+    for (CeedInt j=0; j<ny; j++) {
+      CeedInt e = i*ny + j;
+      ind[4*e+0] = i*(ny+1) + j;
+      ind[4*e+1] = i*(ny+1) + j + 1;
+      ind[4*e+2] = (i+1)*(ny+1) + j;
+      ind[4*e+3] = (i+1)*(ny+1) + j + 1;
+    }
+  for (CeedInt i=0; i<4*ne; i++)
+    indi[i] = ncomp*ind[i];
+
+  for (CeedInt map=0; map<2; map++) {
+    if (map)
+      setenv("CEED_TRANSPOSE_MAP", "1", 1);
+    CeedScalar *out = map ? v : u;
+    CeedInit(argv[1], &ceed);
+
+    CeedElemRestrictionCreate(ceed, ne, 4, ncomp, nnodes, lsize,
+                              CEED_MEM_HOST, CEED_USE_POINTER, ind, &r);
+    ApplyTranspose(r, lsize, &out[0]);
+    CeedElemRestrictionDestroy(&r);
+
+    CeedElemRestrictionCreate(ceed, ne, 4, ncomp, 1, lsize,
+                              CEED_MEM_HOST, CEED_USE_POINTER, indi, &r);
+    ApplyTranspose(r, lsize, &out[lsize]);
+    CeedElemRestrictionDestroy(&r);
+
+    CeedElemRestrictionCreateBlocked(ceed, ne, 4, blksize, ncomp, nnodes,
+                                     lsize, CEED_MEM_HOST, CEED_USE_POINTER,
+                                     ind, &r);
+    ApplyTranspose(r, lsize, &out[2*lsize]);
+    CeedElemRestrictionDestroy(&r);
+
+    CeedElemRestrictionCreateStrided(ceed, ne, 4, ncomp, ncomp*4*ne, strides,
+                                     &r);
+    ApplyTranspose(r, ncomp*4*ne, &out[3*lsize]);
+    CeedElemRestrictionDestroy(&r);
+
+    CeedElemRestrictionCreateBlockedStrided(ceed, ne, 4, blksize, ncomp,
+                                            ncomp*4*ne, strides, &r);
+    ApplyTranspose(r, ncomp*4*ne, &out[3*lsize + ncomp*4*ne]);
+    CeedElemRestrictionDestroy(&r);
+
+    CeedDestroy(&ceed);
+    unsetenv("CEED_TRANSPOSE_MAP");
+  }
+
+  Compare("offsets", lsize, &u[0], &v[0]);
+  Compare("interlaced offsets", lsize, &u[lsize], &v[lsize]);
+  Compare("blocked offsets", lsize, &u[2*lsize], &v[2*lsize]);
+  Compare("strided", ncomp*4*ne, &u[3*lsize], &v[3*lsize]);
+  Compare("blocked strided", ncomp*4*ne, &u[3*lsize + ncomp*4*ne],
+          &v[3*lsize + ncomp*4*ne]);
+  return 0;
+}
@@ -20,7 +20,7 @@ int main(int argc, char **argv) {
   for (int i=0; i<Q; i++) {
     fprintf(stdout, "%12s[%d]:", "collograd1d", i);
     for (int j=0; j<Q; j++) {
-      if (fabs(collograd1d[j+Q*i]) <= 1E-14) collograd1d[j+Q*i] = 0;
+      if (fabs(collograd1d[j+Q*i]) <= 100.*CEED_EPSILON) collograd1d[j+Q*i] = 0;
       fprintf(stdout, "\t% 12.8f", collograd1d[j+Q*i]);
     }
     fprintf(stdout, "\n");
@@ -34,7 +34,7 @@ int main(int argc, char **argv) {
   for (int i=0; i<Q; i++) {
     fprintf(stdout, "%12s[%d]:", "collograd1d", i);
     for (int j=0; j<Q; j++) {
-      if (fabs(collograd1d[j+Q*i]) <= 1E-14) collograd1d[j+Q*i] = 0;
+      if (fabs(collograd1d[j+Q*i]) <= 100.*CEED_EPSILON) collograd1d[j+Q*i] = 0;
       fprintf(stdout, "\t% 12.8f", collograd1d[j+Q*i]);
     }
     fprintf(stdout, "\n");
@@ -48,7 +48,8 @@ int main(int argc, char **argv) {
   for (int i=0; i<P+2; i++) {
     fprintf(stdout, "%12s[%d]:", "collograd1d", i);
     for (int j=0; j<P+2; j++) {
-      if (fabs(collograd1d2[j+(P+2)*i]) <= 1E-14) collograd1d2[j+(P+2)*i] = 0;
+      if (fabs(collograd1d2[j+(P+2)*i]) <= 100.*CEED_EPSILON)
+        collograd1d2[j+(P+2)*i] = 0;
       fprintf(stdout, "\t% 12.8f", collograd1d2[j+(P+2)*i]);
     }
     fprintf(stdout, "\n");
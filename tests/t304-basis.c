@@ -2,6 +2,7 @@
 /// Test Symmetric Schur Decomposition
 /// \test Test Symmetric Schur Decomposition
 #include <ceed.h>
+#include <math.h>
 
 int main(int argc, char **argv) {
   Ceed ceed;
@@ -18,14 +19,14 @@ int main(int argc, char **argv) {
   fprintf(stdout, "Q:\n");
   for (int i=0; i<4; i++) {
     for (int j=0; j<4; j++) {
-      if (A[j+4*i] <= 1E-14 && A[j+4*i] >= -1E-14) A[j+4*i] = 0;
+      if (fabs(A[j+4*i]) <= 100.*CEED_EPSILON) A[j+4*i] = 0;
       fprintf(stdout, "%12.8f\t", A[j+4*i]);
     }
     fprintf(stdout, "\n");
   }
   fprintf(stdout, "lambda:\n");
   for (int i=0; i<4; i++) {
-    if (lambda[i] <= 1E-14 && lambda[i] >= -1E-14) lambda[i] = 0;
+    if (fabs(lambda[i]) <= 100.*CEED_EPSILON) lambda[i] = 0;
     fprintf(stdout, "%12.8f\n", lambda[i]);
   }
   CeedDestroy(&ceed);
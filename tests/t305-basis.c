@@ -2,6 +2,7 @@
 /// Test Simultaneous Diagonalization
 /// \test Simultaneous Diagonalization
 #include <ceed.h>
+#include <math.h>
 
 int main(int argc, char **argv) {
   Ceed ceed;
@@ -31,14 +32,14 @@ int main(int argc, char **argv) {
   fprintf(stdout, "x x^T:\n");
   for (int i=0; i<4; i++) {
     for (int j=0; j<4; j++) {
-      if (xxt[j+4*i] <= 1E-14 && xxt[j+4*i] >= -1E-14) xxt[j+4*i] = 0;
+      if (fabs(xxt[j+4*i]) <= 100.*CEED_EPSILON) xxt[j+4*i] = 0;
       fprintf(stdout, "%12.8f\t", xxt[j+4*i]);
     }
     fprintf(stdout, "\n");
   }
   fprintf(stdout, "lambda:\n");
   for (int i=0; i<4; i++) {
-    if (lambda[i] <= 1E-14 && lambda[i] >= -1E-14) lambda[i] = 0;
+    if (fabs(lambda[i]) <= 100.*CEED_EPSILON) lambda[i] = 0;
     fprintf(stdout, "%12.8f\n", lambda[i]);
   }
   CeedDestroy(&ceed);
@@ -0,0 +1,78 @@
+/// @file
+/// Test basis application to a batch of elements against each element
+/// \test Test basis application to a batch of elements against each element
+#include <ceed.h>
+#include <math.h>
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  CeedBasis basis;
+  CeedVector U, V, Ue, Ve;
+  const CeedInt dim = 3, ncomp = 3, nelem = 1024;
+  const CeedEvalMode emodes[2] = {CEED_EVAL_INTERP, CEED_EVAL_GRAD};
+  const CeedTransposeMode tmodes[2] = {CEED_NOTRANSPOSE, CEED_TRANSPOSE};
+
+  CeedInit(argv[1], &ceed);
+
+  // Collocated gradient (P < Q) and underintegration (P > Q)
+  for (CeedInt k=0; k<2; k++) {
+    const CeedInt P = k ? 5 : 4, Q = k ? 4 : 5;
+    const CeedInt Pdim = CeedIntPow(P, dim), Qdim = CeedIntPow(Q, dim);
+    CeedBasisCreateTensorH1Lagrange(ceed, dim, ncomp, P, Q, CEED_GAUSS,
+                                    &basis);
+
+    for (CeedInt m=0; m<2; m++)
+      for (CeedInt t=0; t<2; t++) {
+        const CeedInt qcomp = emodes[m] == CEED_EVAL_GRAD ? dim*ncomp : ncomp;
+        const CeedInt insize = t ? qcomp*Qdim : ncomp*Pdim;
+        const CeedInt outsize = t ? ncomp*Pdim : qcomp*Qdim;
+        const CeedScalar *u, *v, *ve;
+        CeedScalar *ue;
+
+        CeedVectorCreate(ceed, insize*nelem, &U);
+        CeedVectorCreate(ceed, outsize*nelem, &V);
+        CeedVectorCreate(ceed, insize, &Ue);
+        CeedVectorCreate(ceed, outsize, &Ve);
+        {
+          CeedScalar *uu;
+          CeedVectorGetArray(U, CEED_MEM_HOST, &uu);
+          for (CeedInt i=0; i<insize*nelem; i++)
+            uu[i] = sin(0.1*i);
+          CeedVectorRestoreArray(U, &uu);
+        }
+
+        // Whole batch at once
+        CeedBasisApply(basis, nelem, tmodes[t], emodes[m], U, V);
+
+        // One element at a time; element e is the fastest index
+        CeedVectorGetArrayRead(U, CEED_MEM_HOST, &u);
+        CeedVectorGetArrayRead(V, CEED_MEM_HOST, &v);
+        for (CeedInt e=0; e<nelem; e++) {
+          CeedVectorGetArray(Ue, CEED_MEM_HOST, &ue);
+          for (CeedInt i=0; i<insize; i++)
+            ue[i] = u[i*nelem + e];
+          CeedVectorRestoreArray(Ue, &ue);
+          CeedBasisApply(basis, 1, tmodes[t], emodes[m], Ue, Ve);
+          CeedVectorGetArrayRead(Ve, CEED_MEM_HOST, &ve);
+          for (CeedInt i=0; i<outsize; i++)
+            if (fabs(ve[i] - v[i*nelem + e]) > fmax(1e-10, 200.*CEED_EPSILON))
+              // LCOV_EXCL_START
+              printf("P %d Q %d emode %d tmode %d elem %d [%d]: %f != %f\n",
+                     P, Q, emodes[m], tmodes[t], e, i, v[i*nelem + e], ve[i]);
+          // LCOV_EXCL_STOP
+          CeedVectorRestoreArrayRead(Ve, &ve);
+        }
+        CeedVectorRestoreArrayRead(U, &u);
+        CeedVectorRestoreArrayRead(V, &v);
+
+        CeedVectorDestroy(&U);
+        CeedVectorDestroy(&V);
+        CeedVectorDestroy(&Ue);
+        CeedVectorDestroy(&Ve);
+      }
+    CeedBasisDestroy(&basis);
+  }
+
+  CeedDestroy(&ceed);
+  return 0;
+}
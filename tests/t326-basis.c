@@ -0,0 +1,115 @@
+/// @file
+/// Test interp and grad of large 2D tensor H1 bases against direct sums
+/// \test Test interp and grad of large 2D tensor H1 bases against direct sums
+#include <ceed.h>
+#include <math.h>
+
+// Compare the tensor contraction of a 2D basis with explicit sums over its 1D
+//   matrices, in both transpose modes.  Bases with P or Q larger than the
+//   fixed size contractions use the even-odd decomposition when the 1D
+//   matrices are symmetric.
+static int CheckBasis(Ceed ceed, CeedBasis b, CeedInt P, CeedInt Q,
+                      const char *name) {
+  const CeedInt dim = 2, ncomp = 2;
+  const CeedScalar *interp1d, *grad1d, *out;
+  CeedVector In, Out;
+
+  CeedBasisGetInterp1D(b, &interp1d);
+  CeedBasisGetGrad1D(b, &grad1d);
+
+  for (CeedInt tmode=0; tmode<2; tmode++)
+    for (CeedInt grad=0; grad<2; grad++) {
+      CeedTransposeMode tm = tmode ? CEED_TRANSPOSE : CEED_NOTRANSPOSE;
+      CeedEvalMode emode = grad ? CEED_EVAL_GRAD : CEED_EVAL_INTERP;
+      CeedInt ndir = grad ? dim : 1;
+      CeedInt nin = tmode ? Q : P, nout = tmode ? P : Q;
+      CeedInt insize = (tmode ? ndir : 1)*ncomp*nin*nin;
+      CeedInt outsize = (tmode ? 1 : ndir)*ncomp*nout*nout;
+      CeedScalar u[insize], v[outsize], vabs[outsize];
+
+      for (CeedInt i=0; i<insize; i++)
+        u[i] = sin(0.7*i + 0.3) + 0.1*(i % 5);
+      for (CeedInt i=0; i<outsize; i++)
+        v[i] = vabs[i] = 0.;
+
+      // Direct sums; the first direction is the fastest index
+      for (CeedInt d=0; d<ndir; d++)
+        for (CeedInt c=0; c<ncomp; c++)
+          for (CeedInt q1=0; q1<Q; q1++)
+            for (CeedInt q0=0; q0<Q; q0++)
+              for (CeedInt p1=0; p1<P; p1++)
+                for (CeedInt p0=0; p0<P; p0++) {
+                  const CeedScalar *B0 = (grad && d == 0) ? grad1d : interp1d;
+                  const CeedScalar *B1 = (grad && d == 1) ? grad1d : interp1d;
+                  CeedScalar B = B0[q0*P+p0]*B1[q1*P+p1];
+                  CeedInt iq = ((d*ncomp + c)*Q + q1)*Q + q0;
+                  CeedInt ip = (c*P + p1)*P + p0;
+                  CeedInt iin = tmode ? iq : ip, iout = tmode ? ip : iq;
+                  v[iout] += B*u[iin];
+                  vabs[iout] += fabs(B*u[iin]);
+                }
+
+      CeedVectorCreate(ceed, insize, &In);
+      CeedVectorSetArray(In, CEED_MEM_HOST, CEED_COPY_VALUES, u);
+      CeedVectorCreate(ceed, outsize, &Out);
+      CeedVectorSetValue(Out, 0);
+      CeedBasisApply(b, 1, tm, emode, In, Out);
+
+      CeedVectorGetArrayRead(Out, CEED_MEM_HOST, &out);
+      for (CeedInt i=0; i<outsize; i++)
+        if (fabs(out[i] - v[i]) > 100.*CEED_EPSILON*vabs[i])
+          // LCOV_EXCL_START
+          printf("%s %s %s [%d] %f != %f\n", name,
+                 tmode ? "transpose" : "notranspose",
+                 grad ? "grad" : "interp", i, out[i], v[i]);
+      // LCOV_EXCL_STOP
+      CeedVectorRestoreArrayRead(Out, &out);
+      CeedVectorDestroy(&In);
+      CeedVectorDestroy(&Out);
+    }
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  CeedBasis b;
+  const CeedInt dim = 2, ncomp = 2, P = 13, Q = 14;
+  CeedScalar interp1d[Q*P], grad1d[Q*P], qref1d[Q], qweight1d[Q];
+
+  CeedInit(argv[1], &ceed);
+
+  // Odd P, even Q Lagrange basis with symmetric 1D matrices
+  CeedBasisCreateTensorH1Lagrange(ceed, dim, ncomp, P, Q, CEED_GAUSS, &b);
+  CheckBasis(ceed, b, P, Q, "symmetric");
+  CeedBasisDestroy(&b);
+
+  // Lagrange basis on skewed, non-symmetric nodes and quadrature points
+  CeedScalar xnode[P], pi = 4.*atan(1.);
+  for (CeedInt p=0; p<P; p++) {
+    xnode[p] = -cos(pi*p/(P-1));
+    xnode[p] += 0.1*(1. - xnode[p]*xnode[p]);
+  }
+  for (CeedInt q=0; q<Q; q++) {
+    CeedScalar x = -cos(pi*(q+0.5)/Q);
+    qref1d[q] = x + 0.1*(1. - x*x);
+    qweight1d[q] = 2./Q;
+    for (CeedInt p=0; p<P; p++) {
+      CeedScalar L = 1., dL = 0.;
+      for (CeedInt k=0; k<P; k++) {
+        if (k == p) continue;
+        CeedScalar h = 1./(xnode[p] - xnode[k]);
+        dL = dL*(qref1d[q] - xnode[k])*h + L*h;
+        L *= (qref1d[q] - xnode[k])*h;
+      }
+      interp1d[q*P+p] = L;
+      grad1d[q*P+p] = dL;
+    }
+  }
+  CeedBasisCreateTensorH1(ceed, dim, ncomp, P, Q, interp1d, grad1d, qref1d,
+                          qweight1d, &b);
+  CheckBasis(ceed, b, P, Q, "non-symmetric");
+  CeedBasisDestroy(&b);
+
+  CeedDestroy(&ceed);
+  return 0;
+}
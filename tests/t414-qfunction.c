@@ -0,0 +1,88 @@
+/// @file
+/// Test creation, evaluation, and destruction for vector qfunctions by name
+/// \test Test creation, evaluation, and destruction for vector qfunctions by name
+#include <ceed.h>
+#include <math.h>
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  CeedVector in[16], out[16];
+  CeedVector Qdata, QdataPoisson, U, V, dU, dV;
+  CeedQFunction qf_mass, qf_diff;
+  const CeedInt Q = 8, ncomp = 3, dim = 3;
+  const CeedScalar *vv;
+  CeedScalar qd[Q], qdp[6*Q], u[ncomp*Q], du[dim*ncomp*Q];
+
+  CeedInit(argv[1], &ceed);
+
+  CeedQFunctionCreateInteriorByName(ceed, "Vector3MassApply", &qf_mass);
+  CeedQFunctionCreateInteriorByName(ceed, "Vector3Poisson3DApply", &qf_diff);
+
+  for (CeedInt i=0; i<Q; i++) {
+    CeedScalar x = 2.*i/(Q-1) - 1;
+    qd[i] = 1 - x*x;
+    // Diagonal geometric factors diag(1, 2, 3) in Voigt notation
+    for (CeedInt k=0; k<6; k++)
+      qdp[i+k*Q] = k < 3 ? k + 1 : 0;
+    for (CeedInt c=0; c<ncomp; c++)
+      u[i+c*Q] = 2 + 3*x + 5*x*x + c;
+    for (CeedInt k=0; k<dim*ncomp; k++)
+      du[i+k*Q] = x + k;
+  }
+
+  CeedVectorCreate(ceed, Q, &Qdata);
+  CeedVectorSetArray(Qdata, CEED_MEM_HOST, CEED_USE_POINTER, qd);
+  CeedVectorCreate(ceed, 6*Q, &QdataPoisson);
+  CeedVectorSetArray(QdataPoisson, CEED_MEM_HOST, CEED_USE_POINTER, qdp);
+  CeedVectorCreate(ceed, ncomp*Q, &U);
+  CeedVectorSetArray(U, CEED_MEM_HOST, CEED_USE_POINTER, u);
+  CeedVectorCreate(ceed, ncomp*Q, &V);
+  CeedVectorSetValue(V, 0);
+  CeedVectorCreate(ceed, dim*ncomp*Q, &dU);
+  CeedVectorSetArray(dU, CEED_MEM_HOST, CEED_USE_POINTER, du);
+  CeedVectorCreate(ceed, dim*ncomp*Q, &dV);
+  CeedVectorSetValue(dV, 0);
+
+  {
+    in[0] = U;
+    in[1] = Qdata;
+    out[0] = V;
+    CeedQFunctionApply(qf_mass, Q, in, out);
+  }
+  {
+    in[0] = dU;
+    in[1] = QdataPoisson;
+    out[0] = dV;
+    CeedQFunctionApply(qf_diff, Q, in, out);
+  }
+
+  CeedVectorGetArrayRead(V, CEED_MEM_HOST, &vv);
+  for (CeedInt i=0; i<ncomp*Q; i++)
+    if (fabs(u[i]*qd[i%Q] - vv[i]) > 100.*CEED_EPSILON)
+      // LCOV_EXCL_START
+      printf("[%d] v %f != vv %f\n", i, u[i]*qd[i%Q], vv[i]);
+  // LCOV_EXCL_STOP
+  CeedVectorRestoreArrayRead(V, &vv);
+
+  CeedVectorGetArrayRead(dV, CEED_MEM_HOST, &vv);
+  for (CeedInt i=0; i<dim*ncomp*Q; i++) {
+    // du is stored as [dim][ncomp][Q]
+    CeedScalar dv = du[i] * (i/(ncomp*Q) + 1);
+    if (fabs(dv - vv[i]) > 100.*CEED_EPSILON)
+      // LCOV_EXCL_START
+      printf("[%d] dv %f != dvv %f\n", i, dv, vv[i]);
+    // LCOV_EXCL_STOP
+  }
+  CeedVectorRestoreArrayRead(dV, &vv);
+
+  CeedVectorDestroy(&Qdata);
+  CeedVectorDestroy(&QdataPoisson);
+  CeedVectorDestroy(&U);
+  CeedVectorDestroy(&V);
+  CeedVectorDestroy(&dU);
+  CeedVectorDestroy(&dV);
+  CeedQFunctionDestroy(&qf_mass);
+  CeedQFunctionDestroy(&qf_diff);
+  CeedDestroy(&ceed);
+  return 0;
+}
@@ -0,0 +1,139 @@
+/// @file
+/// Test fused geometric factor qfunctions by name against build and apply
+/// \test Test fused geometric factor qfunctions by name against build and apply
+#include <ceed.h>
+#include <math.h>
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  CeedVector in[16], out[16];
+  CeedVector J, W, Qdata, QdataPoisson, U, V, Vfused, dU, dV, dVfused;
+  CeedQFunction qf_build_mass, qf_build_diff, qf_mass, qf_diff, qf_mass_fused,
+                qf_diff_fused;
+  const CeedInt Q = 8, dim = 3;
+  const CeedScalar *vv, *vvfused;
+  CeedScalar j[dim*dim*Q], w[Q], u[3*Q], du[dim*3*Q];
+
+  CeedInit(argv[1], &ceed);
+
+  for (CeedInt i=0; i<Q; i++) {
+    CeedScalar x = 2.*i/(Q-1) - 1;
+    // Jacobians of an affine map away from the identity
+    for (CeedInt k=0; k<dim*dim; k++)
+      j[i+k*Q] = (k%(dim+1) == 0 ? 2 + x : 0) + 0.1*(k+1)*x*x;
+    w[i] = 1 - x*x;
+    for (CeedInt c=0; c<3; c++)
+      u[i+c*Q] = 2 + 3*x + 5*x*x + c;
+    for (CeedInt k=0; k<dim*3; k++)
+      du[i+k*Q] = x + k;
+  }
+
+  CeedVectorCreate(ceed, dim*dim*Q, &J);
+  CeedVectorSetArray(J, CEED_MEM_HOST, CEED_USE_POINTER, j);
+  CeedVectorCreate(ceed, Q, &W);
+  CeedVectorSetArray(W, CEED_MEM_HOST, CEED_USE_POINTER, w);
+  CeedVectorCreate(ceed, Q, &Qdata);
+  CeedVectorCreate(ceed, 6*Q, &QdataPoisson);
+  CeedVectorCreate(ceed, 3*Q, &U);
+  CeedVectorSetArray(U, CEED_MEM_HOST, CEED_USE_POINTER, u);
+  CeedVectorCreate(ceed, 3*Q, &V);
+  CeedVectorCreate(ceed, 3*Q, &Vfused);
+  CeedVectorCreate(ceed, dim*3*Q, &dU);
+  CeedVectorSetArray(dU, CEED_MEM_HOST, CEED_USE_POINTER, du);
+  CeedVectorCreate(ceed, dim*3*Q, &dV);
+  CeedVectorCreate(ceed, dim*3*Q, &dVfused);
+
+  CeedQFunctionCreateInteriorByName(ceed, "Mass3DBuild", &qf_build_mass);
+  CeedQFunctionCreateInteriorByName(ceed, "Poisson3DBuild", &qf_build_diff);
+  {
+    in[0] = J;
+    in[1] = W;
+    out[0] = Qdata;
+    CeedQFunctionApply(qf_build_mass, Q, in, out);
+    out[0] = QdataPoisson;
+    CeedQFunctionApply(qf_build_diff, Q, in, out);
+  }
+
+  // Scalar and vector variants must match build followed by apply
+  for (CeedInt ncomp=1; ncomp<=3; ncomp+=2) {
+    const char *prefix = ncomp > 1 ? "Vector3" : "";
+    char name[64];
+    snprintf(name, sizeof name, "%sMassApply", prefix);
+    CeedQFunctionCreateInteriorByName(ceed, name, &qf_mass);
+    snprintf(name, sizeof name, "%sMass3DFusedApply", prefix);
+    CeedQFunctionCreateInteriorByName(ceed, name, &qf_mass_fused);
+    snprintf(name, sizeof name, "%sPoisson3DApply", prefix);
+    CeedQFunctionCreateInteriorByName(ceed, name, &qf_diff);
+    snprintf(name, sizeof name, "%sPoisson3DFusedApply", prefix);
+    CeedQFunctionCreateInteriorByName(ceed, name, &qf_diff_fused);
+
+    CeedVectorSetValue(V, 0);
+    CeedVectorSetValue(Vfused, 0);
+    CeedVectorSetValue(dV, 0);
+    CeedVectorSetValue(dVfused, 0);
+    {
+      in[0] = U;
+      in[1] = Qdata;
+      out[0] = V;
+      CeedQFunctionApply(qf_mass, Q, in, out);
+      in[0] = J;
+      in[1] = W;
+      in[2] = U;
+      out[0] = Vfused;
+      CeedQFunctionApply(qf_mass_fused, Q, in, out);
+    }
+    {
+      in[0] = dU;
+      in[1] = QdataPoisson;
+      out[0] = dV;
+      CeedQFunctionApply(qf_diff, Q, in, out);
+      in[0] = J;
+      in[1] = W;
+      in[2] = dU;
+      out[0] = dVfused;
+      CeedQFunctionApply(qf_diff_fused, Q, in, out);
+    }
+
+    CeedVectorGetArrayRead(V, CEED_MEM_HOST, &vv);
+    CeedVectorGetArrayRead(Vfused, CEED_MEM_HOST, &vvfused);
+    for (CeedInt i=0; i<ncomp*Q; i++)
+      if (fabs(vv[i] - vvfused[i]) > 100.*CEED_EPSILON*(1. + fabs(vv[i])))
+        // LCOV_EXCL_START
+        printf("[%d] ncomp %d v %f != fused v %f\n", i, ncomp, vv[i],
+               vvfused[i]);
+    // LCOV_EXCL_STOP
+    CeedVectorRestoreArrayRead(V, &vv);
+    CeedVectorRestoreArrayRead(Vfused, &vvfused);
+
+    CeedVectorGetArrayRead(dV, CEED_MEM_HOST, &vv);
+    CeedVectorGetArrayRead(dVfused, CEED_MEM_HOST, &vvfused);
+    for (CeedInt i=0; i<dim*ncomp*Q; i++)
+      if (fabs(vv[i] - vvfused[i]) > 100.*CEED_EPSILON*(1. + fabs(vv[i])))
+        // LCOV_EXCL_START
+        printf("[%d] ncomp %d dv %f != fused dv %f\n", i, ncomp, vv[i],
+               vvfused[i]);
+    // LCOV_EXCL_STOP
+    CeedVectorRestoreArrayRead(dV, &vv);
+    CeedVectorRestoreArrayRead(dVfused, &vvfused);
+
+    CeedQFunctionDestroy(&qf_mass);
+    CeedQFunctionDestroy(&qf_mass_fused);
+    CeedQFunctionDestroy(&qf_diff);
+    CeedQFunctionDestroy(&qf_diff_fused);
+  }
+
+  CeedVectorDestroy(&J);
+  CeedVectorDestroy(&W);
+  CeedVectorDestroy(&Qdata);
+  CeedVectorDestroy(&QdataPoisson);
+  CeedVectorDestroy(&U);
+  CeedVectorDestroy(&V);
+  CeedVectorDestroy(&Vfused);
+  CeedVectorDestroy(&dU);
+  CeedVectorDestroy(&dV);
+  CeedVectorDestroy(&dVfused);
+  CeedQFunctionDestroy(&qf_build_mass);
+  CeedQFunctionDestroy(&qf_build_diff);
+  CeedDestroy(&ceed);
+  return 0;
+}
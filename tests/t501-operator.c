@@ -93,7 +93,8 @@ int main(int argc, char **argv) {
   sum = 0.;
   for (CeedInt i=0; i<Nu; i++)
     sum += hv[i];
-  if (fabs(sum-1.)>1e-10) printf("Computed Area: %f != True Area: 1.0\n", sum);
+  if (fabs(sum-1.)>fmax(1e-10, 200.*CEED_EPSILON))
+    printf("Computed Area: %f != True Area: 1.0\n", sum);
   CeedVectorRestoreArrayRead(V, &hv);
 
   CeedQFunctionDestroy(&qf_setup);
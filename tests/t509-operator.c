@@ -0,0 +1,147 @@
+/// @file
+/// Test collection of operator statistics with CEED_PROFILE
+/// \test Test collection of operator statistics with CEED_PROFILE
+#define _POSIX_C_SOURCE 200112
+#include <ceed.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "t500-operator.h"
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  CeedElemRestriction Erestrictx, Erestrictu, Erestrictui;
+  CeedBasis bx, bu;
+  CeedQFunction qf_setup, qf_mass;
+  CeedOperator op_setup, op_mass;
+  CeedVector qdata, X, U, V;
+  CeedInt nelem = 15, P = 5, Q = 8;
+  CeedInt Nx = nelem+1, Nu = nelem*(P-1)+1;
+  CeedInt indx[nelem*2], indu[nelem*P];
+  CeedScalar x[Nx];
+  uint64_t count;
+  double time, bytes, flops;
+
+  CeedInit(argv[1], &ceed);
+
+  for (CeedInt i=0; i<Nx; i++)
+    x[i] = (CeedScalar) i / (Nx - 1);
+  for (CeedInt i=0; i<nelem; i++) {
+    indx[2*i+0] = i;
+    indx[2*i+1] = i+1;
+  }
+  // Restrictions
+  CeedElemRestrictionCreate(ceed, nelem, 2, 1, 1, Nx, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indx, &Erestrictx);
+
+  for (CeedInt i=0; i<nelem; i++) {
+    for (CeedInt j=0; j<P; j++) {
+      indu[P*i+j] = i*(P-1) + j;
+    }
+  }
+  CeedElemRestrictionCreate(ceed, nelem, P, 1, 1, Nu, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indu, &Erestrictu);
+  CeedInt stridesu[3] = {1, Q, Q};
+  CeedElemRestrictionCreateStrided(ceed, nelem, Q, 1, Q*nelem, stridesu,
+                                   &Erestrictui);
+
+  // Bases
+  CeedBasisCreateTensorH1Lagrange(ceed, 1, 1, 2, Q, CEED_GAUSS, &bx);
+  CeedBasisCreateTensorH1Lagrange(ceed, 1, 1, P, Q, CEED_GAUSS, &bu);
+
+  // QFunctions
+  CeedQFunctionCreateInterior(ceed, 1, setup, setup_loc, &qf_setup);
+  CeedQFunctionAddInput(qf_setup, "_weight", 1, CEED_EVAL_WEIGHT);
+  CeedQFunctionAddInput(qf_setup, "dx", 1, CEED_EVAL_GRAD);
+  CeedQFunctionAddOutput(qf_setup, "rho", 1, CEED_EVAL_NONE);
+
+  CeedQFunctionCreateInterior(ceed, 1, mass, mass_loc, &qf_mass);
+  CeedQFunctionAddInput(qf_mass, "rho", 1, CEED_EVAL_NONE);
+  CeedQFunctionAddInput(qf_mass, "u", 1, CEED_EVAL_INTERP);
+  CeedQFunctionAddOutput(qf_mass, "v", 1, CEED_EVAL_INTERP);
+
+  // Operators, only the mass operator collects statistics
+  CeedOperatorCreate(ceed, qf_setup, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_setup);
+
+  setenv("CEED_PROFILE", "1", 1);
+  CeedOperatorCreate(ceed, qf_mass, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_mass);
+  unsetenv("CEED_PROFILE");
+
+  CeedVectorCreate(ceed, Nx, &X);
+  CeedVectorSetArray(X, CEED_MEM_HOST, CEED_USE_POINTER, x);
+  CeedVectorCreate(ceed, nelem*Q, &qdata);
+
+  CeedOperatorSetField(op_setup, "_weight", CEED_ELEMRESTRICTION_NONE, bx,
+                       CEED_VECTOR_NONE);
+  CeedOperatorSetField(op_setup, "dx", Erestrictx, bx, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_setup, "rho", Erestrictui, CEED_BASIS_COLLOCATED,
+                       CEED_VECTOR_ACTIVE);
+
+  CeedOperatorSetField(op_mass, "rho", Erestrictui, CEED_BASIS_COLLOCATED,
+                       qdata);
+  CeedOperatorSetField(op_mass, "u", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_mass, "v", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+
+  CeedVectorCreate(ceed, Nu, &U);
+  CeedVectorSetValue(U, 1.0);
+  CeedVectorCreate(ceed, Nu, &V);
+
+  CeedOperatorApply(op_setup, X, qdata, CEED_REQUEST_IMMEDIATE);
+  for (CeedInt i=0; i<3; i++)
+    CeedOperatorApply(op_mass, U, V, CEED_REQUEST_IMMEDIATE);
+
+  // Check statistics
+  CeedOperatorGetStats(op_setup, CEED_PHASE_TOTAL, &count, &time, &bytes,
+                       &flops);
+  if (count || time || bytes || flops)
+    // LCOV_EXCL_START
+    printf("Statistics collected without CEED_PROFILE\n");
+  // LCOV_EXCL_STOP
+
+  CeedOperatorGetStats(op_mass, CEED_PHASE_TOTAL, &count, &time, &bytes,
+                       &flops);
+  if (count != 3)
+    // LCOV_EXCL_START
+    printf("Incorrect number of applications: %d != 3\n", (int)count);
+  // LCOV_EXCL_STOP
+  if (time < 0. || bytes <= 0. || flops <= 0.)
+    // LCOV_EXCL_START
+    printf("Invalid statistics: %e s, %e B, %e flop\n", time, bytes, flops);
+  // LCOV_EXCL_STOP
+
+  // Estimates scale with the number of applications
+  double basisbytes, basisflops;
+  CeedOperatorGetStats(op_mass, CEED_PHASE_BASIS, &count, &time, &basisbytes,
+                       &basisflops);
+  const double interpflops = 2.*nelem*P*Q;
+  if (fabs(basisflops - 3*2*interpflops) > 1e-10)
+    // LCOV_EXCL_START
+    printf("Incorrect basis flops: %e != %e\n", basisflops, 3*2*interpflops);
+  // LCOV_EXCL_STOP
+
+  CeedOperatorResetStats(op_mass);
+  CeedOperatorGetStats(op_mass, CEED_PHASE_TOTAL, &count, &time, &bytes,
+                       &flops);
+  if (count || time || bytes || flops)
+    // LCOV_EXCL_START
+    printf("Statistics not reset\n");
+  // LCOV_EXCL_STOP
+
+  CeedQFunctionDestroy(&qf_setup);
+  CeedQFunctionDestroy(&qf_mass);
+  CeedOperatorDestroy(&op_setup);
+  CeedOperatorDestroy(&op_mass);
+  CeedElemRestrictionDestroy(&Erestrictu);
+  CeedElemRestrictionDestroy(&Erestrictx);
+  CeedElemRestrictionDestroy(&Erestrictui);
+  CeedBasisDestroy(&bu);
+  CeedBasisDestroy(&bx);
+  CeedVectorDestroy(&X);
+  CeedVectorDestroy(&U);
+  CeedVectorDestroy(&V);
+  CeedVectorDestroy(&qdata);
+  CeedDestroy(&ceed);
+  return 0;
+}
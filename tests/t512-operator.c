@@ -0,0 +1,158 @@
+/// @file
+/// Test compressed storage of passive quadrature data for Poisson operator
+/// \test Test compressed storage of passive quadrature data for Poisson operator
+#include <ceed.h>
+#include <stdlib.h>
+#include <math.h>
+#include "t512-operator.h"
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  CeedElemRestriction Erestrictx, Erestrictu, Erestrictqi;
+  CeedBasis bx, bu;
+  CeedQFunction qf_setup, qf_diff;
+  CeedOperator op_setup, op_diff, op_diff_compressed;
+  CeedVector qdata, X, U, V, Vcompressed;
+  CeedInt nelem = 10, P = 3, Q = 4, dim = 2;
+  CeedInt nx = 5, ny = 2;
+  CeedInt ndofs = (nx*2+1)*(ny*2+1), nqpts = nelem*Q*Q;
+  CeedInt indx[nelem*P*P];
+  CeedScalar x[dim*ndofs], u[ndofs];
+  const CeedScalar *v, *vc;
+
+  CeedInit(argv[1], &ceed);
+
+  // DoF Coordinates, distorted so the quadrature data varies in space
+  for (CeedInt i=0; i<nx*2+1; i++)
+    for (CeedInt j=0; j<ny*2+1; j++) {
+      CeedScalar xi = (CeedScalar) i / (2*nx), eta = (CeedScalar) j / (2*ny);
+      x[i+j*(nx*2+1)+0*ndofs] = xi + 0.1*xi*(1-xi)*eta;
+      x[i+j*(nx*2+1)+1*ndofs] = eta + 0.1*eta*(1-eta)*xi*xi;
+      u[i+j*(nx*2+1)] = 1 + xi*xi + 2*eta;
+    }
+  CeedVectorCreate(ceed, dim*ndofs, &X);
+  CeedVectorSetArray(X, CEED_MEM_HOST, CEED_USE_POINTER, x);
+  CeedVectorCreate(ceed, ndofs, &U);
+  CeedVectorSetArray(U, CEED_MEM_HOST, CEED_USE_POINTER, u);
+  CeedVectorCreate(ceed, ndofs, &V);
+  CeedVectorCreate(ceed, ndofs, &Vcompressed);
+
+  // Qdata Vector
+  CeedVectorCreate(ceed, nqpts*dim*dim, &qdata);
+
+  // Element Setup
+  for (CeedInt i=0; i<nelem; i++) {
+    CeedInt col, row, offset;
+    col = i % nx;
+    row = i / nx;
+    offset = col*(P-1) + row*(nx*2+1)*(P-1);
+    for (CeedInt j=0; j<P; j++)
+      for (CeedInt k=0; k<P; k++)
+        indx[P*(P*i+k)+j] = offset + k*(nx*2+1) + j;
+  }
+
+  // Restrictions
+  CeedElemRestrictionCreate(ceed, nelem, P*P, dim, ndofs, dim*ndofs,
+                            CEED_MEM_HOST, CEED_USE_POINTER, indx, &Erestrictx);
+  CeedElemRestrictionCreate(ceed, nelem, P*P, 1, 1, ndofs, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indx, &Erestrictu);
+  CeedInt stridesqd[3] = {1, Q*Q, Q*Q*dim*dim};
+  CeedElemRestrictionCreateStrided(ceed, nelem, Q*Q, dim*dim, dim*dim*nqpts,
+                                   stridesqd, &Erestrictqi);
+
+  // Bases
+  CeedBasisCreateTensorH1Lagrange(ceed, dim, dim, P, Q, CEED_GAUSS, &bx);
+  CeedBasisCreateTensorH1Lagrange(ceed, dim, 1, P, Q, CEED_GAUSS, &bu);
+
+  // QFunction - setup
+  CeedQFunctionCreateInterior(ceed, 1, setup, setup_loc, &qf_setup);
+  CeedQFunctionAddInput(qf_setup, "dx", dim*dim, CEED_EVAL_GRAD);
+  CeedQFunctionAddInput(qf_setup, "_weight", 1, CEED_EVAL_WEIGHT);
+  CeedQFunctionAddOutput(qf_setup, "qdata", dim*dim, CEED_EVAL_NONE);
+
+  // Operator - setup
+  CeedOperatorCreate(ceed, qf_setup, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_setup);
+  CeedOperatorSetField(op_setup, "dx", Erestrictx, bx, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_setup, "_weight", CEED_ELEMRESTRICTION_NONE, bx,
+                       CEED_VECTOR_NONE);
+  CeedOperatorSetField(op_setup, "qdata", Erestrictqi, CEED_BASIS_COLLOCATED,
+                       CEED_VECTOR_ACTIVE);
+
+  // QFunction - apply
+  CeedQFunctionCreateInterior(ceed, 1, diff, diff_loc, &qf_diff);
+  CeedQFunctionAddInput(qf_diff, "du", dim, CEED_EVAL_GRAD);
+  CeedQFunctionAddInput(qf_diff, "qdata", dim*dim, CEED_EVAL_NONE);
+  CeedQFunctionAddOutput(qf_diff, "dv", dim, CEED_EVAL_GRAD);
+
+  for (CeedInt s=CEED_STORAGE_SYMMETRIC; s<=CEED_STORAGE_SYMMETRIC_SINGLE;
+       s++) {
+    // Single precision storage rounds the quadrature data
+    const CeedScalar tol = fmax((s & CEED_STORAGE_SINGLE) ? 1e-6 : 0.,
+                                1000.*CEED_EPSILON);
+
+    // Operators - apply, with full and compressed quadrature data
+    CeedOperatorCreate(ceed, qf_diff, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                       &op_diff);
+    CeedOperatorSetField(op_diff, "du", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+    CeedOperatorSetField(op_diff, "qdata", Erestrictqi, CEED_BASIS_COLLOCATED,
+                         qdata);
+    CeedOperatorSetField(op_diff, "dv", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+    CeedOperatorCreate(ceed, qf_diff, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                       &op_diff_compressed);
+    CeedOperatorSetField(op_diff_compressed, "du", Erestrictu, bu,
+                         CEED_VECTOR_ACTIVE);
+    CeedOperatorSetField(op_diff_compressed, "qdata", Erestrictqi,
+                         CEED_BASIS_COLLOCATED, qdata);
+    CeedOperatorSetField(op_diff_compressed, "dv", Erestrictu, bu,
+                         CEED_VECTOR_ACTIVE);
+    CeedOperatorSetFieldStorage(op_diff_compressed, "qdata", s);
+
+    // Apply twice, updating the quadrature data in between
+    for (CeedInt pass=0; pass<2; pass++) {
+      if (pass)
+        for (CeedInt i=0; i<ndofs; i++)
+          x[i+1*ndofs] *= 3;
+      CeedVectorSetArray(X, CEED_MEM_HOST, CEED_USE_POINTER, x);
+      CeedOperatorApply(op_setup, X, qdata, CEED_REQUEST_IMMEDIATE);
+
+      CeedOperatorApply(op_diff, U, V, CEED_REQUEST_IMMEDIATE);
+      CeedOperatorApply(op_diff_compressed, U, Vcompressed,
+                        CEED_REQUEST_IMMEDIATE);
+
+      // Check output
+      CeedVectorGetArrayRead(V, CEED_MEM_HOST, &v);
+      CeedVectorGetArrayRead(Vcompressed, CEED_MEM_HOST, &vc);
+      for (CeedInt i=0; i<ndofs; i++)
+        if (fabs(v[i] - vc[i]) > tol*(1 + fabs(v[i])))
+          // LCOV_EXCL_START
+          printf("[%d] %s storage, pass %d: %f != %f\n", i,
+                 CeedStorageModes[s], pass, vc[i], v[i]);
+      // LCOV_EXCL_STOP
+      CeedVectorRestoreArrayRead(V, &v);
+      CeedVectorRestoreArrayRead(Vcompressed, &vc);
+    }
+    for (CeedInt i=0; i<ndofs; i++)
+      x[i+1*ndofs] /= 3;
+
+    CeedOperatorDestroy(&op_diff);
+    CeedOperatorDestroy(&op_diff_compressed);
+  }
+
+  // Cleanup
+  CeedQFunctionDestroy(&qf_setup);
+  CeedQFunctionDestroy(&qf_diff);
+  CeedOperatorDestroy(&op_setup);
+  CeedElemRestrictionDestroy(&Erestrictu);
+  CeedElemRestrictionDestroy(&Erestrictx);
+  CeedElemRestrictionDestroy(&Erestrictqi);
+  CeedBasisDestroy(&bu);
+  CeedBasisDestroy(&bx);
+  CeedVectorDestroy(&X);
+  CeedVectorDestroy(&qdata);
+  CeedVectorDestroy(&U);
+  CeedVectorDestroy(&V);
+  CeedVectorDestroy(&Vcompressed);
+  CeedDestroy(&ceed);
+  return 0;
+}
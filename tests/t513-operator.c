@@ -0,0 +1,117 @@
+/// @file
+/// Test mass matrix operator with element block sizes given in the resource
+/// \test Test mass matrix operator with element block sizes given in the resource
+#include <ceed.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "t500-operator.h"
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  CeedElemRestriction Erestrictx, Erestrictu, Erestrictui;
+  CeedBasis bx, bu;
+  CeedQFunction qf_setup, qf_mass;
+  CeedOperator op_setup, op_mass;
+  CeedVector qdata, X, U, V;
+  const CeedScalar *hv;
+  // Block sizes that divide neither the number of elements nor each other
+  const char *resources[3] = {"", "/cpu/self/opt/blocked:blksize=3",
+                              "/cpu/self/opt/blocked:blksize=16"
+                             };
+  CeedInt nelem = 17, P = 5, Q = 8;
+  CeedInt Nx = nelem+1, Nu = nelem*(P-1)+1;
+  CeedInt indx[nelem*2], indu[nelem*P];
+  CeedScalar x[Nx], u[Nu], v[Nu];
+
+  resources[0] = argv[1];
+  for (CeedInt i=0; i<Nx; i++)
+    x[i] = (CeedScalar) i / (Nx - 1);
+  for (CeedInt i=0; i<nelem; i++) {
+    indx[2*i+0] = i;
+    indx[2*i+1] = i+1;
+  }
+  for (CeedInt i=0; i<nelem; i++)
+    for (CeedInt j=0; j<P; j++)
+      indu[P*i+j] = i*(P-1) + j;
+  for (CeedInt i=0; i<Nu; i++)
+    u[i] = 1 + sin(i);
+
+  for (CeedInt r=0; r<3; r++) {
+    CeedInit(resources[r], &ceed);
+
+    CeedElemRestrictionCreate(ceed, nelem, 2, 1, 1, Nx, CEED_MEM_HOST,
+                              CEED_USE_POINTER, indx, &Erestrictx);
+    CeedElemRestrictionCreate(ceed, nelem, P, 1, 1, Nu, CEED_MEM_HOST,
+                              CEED_USE_POINTER, indu, &Erestrictu);
+    CeedInt stridesu[3] = {1, Q, Q};
+    CeedElemRestrictionCreateStrided(ceed, nelem, Q, 1, Q*nelem, stridesu,
+                                     &Erestrictui);
+
+    CeedBasisCreateTensorH1Lagrange(ceed, 1, 1, 2, Q, CEED_GAUSS, &bx);
+    CeedBasisCreateTensorH1Lagrange(ceed, 1, 1, P, Q, CEED_GAUSS, &bu);
+
+    CeedQFunctionCreateInterior(ceed, 1, setup, setup_loc, &qf_setup);
+    CeedQFunctionAddInput(qf_setup, "_weight", 1, CEED_EVAL_WEIGHT);
+    CeedQFunctionAddInput(qf_setup, "dx", 1, CEED_EVAL_GRAD);
+    CeedQFunctionAddOutput(qf_setup, "rho", 1, CEED_EVAL_NONE);
+
+    CeedQFunctionCreateInterior(ceed, 1, mass, mass_loc, &qf_mass);
+    CeedQFunctionAddInput(qf_mass, "rho", 1, CEED_EVAL_NONE);
+    CeedQFunctionAddInput(qf_mass, "u", 1, CEED_EVAL_INTERP);
+    CeedQFunctionAddOutput(qf_mass, "v", 1, CEED_EVAL_INTERP);
+
+    CeedOperatorCreate(ceed, qf_setup, CEED_QFUNCTION_NONE,
+                       CEED_QFUNCTION_NONE, &op_setup);
+    CeedOperatorCreate(ceed, qf_mass, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                       &op_mass);
+
+    CeedVectorCreate(ceed, Nx, &X);
+    CeedVectorSetArray(X, CEED_MEM_HOST, CEED_USE_POINTER, x);
+    CeedVectorCreate(ceed, nelem*Q, &qdata);
+
+    CeedOperatorSetField(op_setup, "_weight", CEED_ELEMRESTRICTION_NONE, bx,
+                         CEED_VECTOR_NONE);
+    CeedOperatorSetField(op_setup, "dx", Erestrictx, bx, CEED_VECTOR_ACTIVE);
+    CeedOperatorSetField(op_setup, "rho", Erestrictui, CEED_BASIS_COLLOCATED,
+                         CEED_VECTOR_ACTIVE);
+    CeedOperatorSetField(op_mass, "rho", Erestrictui, CEED_BASIS_COLLOCATED,
+                         qdata);
+    CeedOperatorSetField(op_mass, "u", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+    CeedOperatorSetField(op_mass, "v", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+
+    CeedOperatorApply(op_setup, X, qdata, CEED_REQUEST_IMMEDIATE);
+
+    CeedVectorCreate(ceed, Nu, &U);
+    CeedVectorSetArray(U, CEED_MEM_HOST, CEED_USE_POINTER, u);
+    CeedVectorCreate(ceed, Nu, &V);
+    CeedOperatorApply(op_mass, U, V, CEED_REQUEST_IMMEDIATE);
+
+    // Check output against the first resource
+    CeedVectorGetArrayRead(V, CEED_MEM_HOST, &hv);
+    for (CeedInt i=0; i<Nu; i++)
+      if (r == 0)
+        v[i] = hv[i];
+      else if (fabs(hv[i] - v[i]) > 100.*CEED_EPSILON)
+        // LCOV_EXCL_START
+        printf("%s [%d] v %g != %g\n", resources[r], i, hv[i], v[i]);
+    // LCOV_EXCL_STOP
+    CeedVectorRestoreArrayRead(V, &hv);
+
+    CeedQFunctionDestroy(&qf_setup);
+    CeedQFunctionDestroy(&qf_mass);
+    CeedOperatorDestroy(&op_setup);
+    CeedOperatorDestroy(&op_mass);
+    CeedElemRestrictionDestroy(&Erestrictu);
+    CeedElemRestrictionDestroy(&Erestrictx);
+    CeedElemRestrictionDestroy(&Erestrictui);
+    CeedBasisDestroy(&bu);
+    CeedBasisDestroy(&bx);
+    CeedVectorDestroy(&X);
+    CeedVectorDestroy(&U);
+    CeedVectorDestroy(&V);
+    CeedVectorDestroy(&qdata);
+    CeedDestroy(&ceed);
+  }
+  return 0;
+}
@@ -0,0 +1,119 @@
+/// @file
+/// Test operator with fields requesting both interpolation and gradient
+/// \test Test operator with fields requesting both interpolation and gradient
+#include <ceed.h>
+#include <stdlib.h>
+#include <math.h>
+#include "t514-operator.h"
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  CeedElemRestriction Erestrictu, Erestrictusplit;
+  CeedBasis bu;
+  CeedQFunction qf;
+  CeedOperator op, op_split;
+  CeedVector U, W, V, Vsplit;
+  CeedInt nelem = 10, dim = 2;
+  CeedInt nx = 5, ny = 2;
+  const CeedInt Ps[3] = {3, 3, 4}, Qs[3] = {4, 3, 3};
+  const CeedQuadMode qmodes[3] = {CEED_GAUSS, CEED_GAUSS_LOBATTO, CEED_GAUSS};
+  const CeedScalar *v, *vs;
+
+  CeedInit(argv[1], &ceed);
+
+  // QFunction
+  CeedQFunctionCreateInterior(ceed, 1, apply, apply_loc, &qf);
+  CeedQFunctionAddInput(qf, "u", 1, CEED_EVAL_INTERP);
+  CeedQFunctionAddInput(qf, "du", dim, CEED_EVAL_GRAD);
+  CeedQFunctionAddInput(qf, "w", 1, CEED_EVAL_INTERP);
+  CeedQFunctionAddInput(qf, "dw", dim, CEED_EVAL_GRAD);
+  CeedQFunctionAddOutput(qf, "v", 1, CEED_EVAL_INTERP);
+
+  // Collocated gradient, collocated interpolation, and underintegration
+  for (CeedInt c=0; c<3; c++) {
+    const CeedInt P = Ps[c], Q = Qs[c];
+    const CeedInt ndofs = (nx*(P-1)+1)*(ny*(P-1)+1);
+    CeedInt indx[nelem*P*P];
+    CeedScalar u[ndofs], w[ndofs];
+
+    for (CeedInt i=0; i<nx*(P-1)+1; i++)
+      for (CeedInt j=0; j<ny*(P-1)+1; j++) {
+        CeedScalar xi = (CeedScalar) i / (nx*(P-1));
+        CeedScalar eta = (CeedScalar) j / (ny*(P-1));
+        u[i+j*(nx*(P-1)+1)] = 1 + xi*xi + 2*eta;
+        w[i+j*(nx*(P-1)+1)] = xi*eta - 3*eta*eta;
+      }
+    CeedVectorCreate(ceed, ndofs, &U);
+    CeedVectorSetArray(U, CEED_MEM_HOST, CEED_USE_POINTER, u);
+    CeedVectorCreate(ceed, ndofs, &W);
+    CeedVectorSetArray(W, CEED_MEM_HOST, CEED_USE_POINTER, w);
+    CeedVectorCreate(ceed, ndofs, &V);
+    CeedVectorCreate(ceed, ndofs, &Vsplit);
+
+    // Element Setup
+    for (CeedInt i=0; i<nelem; i++) {
+      CeedInt col, row, offset;
+      col = i % nx;
+      row = i / nx;
+      offset = col*(P-1) + row*(nx*(P-1)+1)*(P-1);
+      for (CeedInt j=0; j<P; j++)
+        for (CeedInt k=0; k<P; k++)
+          indx[P*(P*i+k)+j] = offset + k*(nx*(P-1)+1) + j;
+    }
+
+    // Restrictions, with a second copy so no fields are shared
+    CeedElemRestrictionCreate(ceed, nelem, P*P, 1, 1, ndofs, CEED_MEM_HOST,
+                              CEED_USE_POINTER, indx, &Erestrictu);
+    CeedElemRestrictionCreate(ceed, nelem, P*P, 1, 1, ndofs, CEED_MEM_HOST,
+                              CEED_USE_POINTER, indx, &Erestrictusplit);
+
+    // Basis
+    CeedBasisCreateTensorH1Lagrange(ceed, dim, 1, P, Q, qmodes[c], &bu);
+
+    // Operators, with shared and with separate restrictions for gradients
+    CeedOperatorCreate(ceed, qf, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE, &op);
+    CeedOperatorSetField(op, "u", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+    CeedOperatorSetField(op, "du", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+    CeedOperatorSetField(op, "w", Erestrictu, bu, W);
+    CeedOperatorSetField(op, "dw", Erestrictu, bu, W);
+    CeedOperatorSetField(op, "v", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+    CeedOperatorCreate(ceed, qf, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                       &op_split);
+    CeedOperatorSetField(op_split, "u", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+    CeedOperatorSetField(op_split, "du", Erestrictusplit, bu,
+                         CEED_VECTOR_ACTIVE);
+    CeedOperatorSetField(op_split, "w", Erestrictu, bu, W);
+    CeedOperatorSetField(op_split, "dw", Erestrictusplit, bu, W);
+    CeedOperatorSetField(op_split, "v", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+
+    // Apply
+    CeedOperatorApply(op, U, V, CEED_REQUEST_IMMEDIATE);
+    CeedOperatorApply(op_split, U, Vsplit, CEED_REQUEST_IMMEDIATE);
+
+    // Check output
+    CeedVectorGetArrayRead(V, CEED_MEM_HOST, &v);
+    CeedVectorGetArrayRead(Vsplit, CEED_MEM_HOST, &vs);
+    for (CeedInt i=0; i<ndofs; i++)
+      if (fabs(v[i] - vs[i]) > 1E4*CEED_EPSILON*(1 + fabs(vs[i])))
+        // LCOV_EXCL_START
+        printf("[%d] P=%d Q=%d: %f != %f\n", i, P, Q, v[i], vs[i]);
+    // LCOV_EXCL_STOP
+    CeedVectorRestoreArrayRead(V, &v);
+    CeedVectorRestoreArrayRead(Vsplit, &vs);
+
+    CeedOperatorDestroy(&op);
+    CeedOperatorDestroy(&op_split);
+    CeedElemRestrictionDestroy(&Erestrictu);
+    CeedElemRestrictionDestroy(&Erestrictusplit);
+    CeedBasisDestroy(&bu);
+    CeedVectorDestroy(&U);
+    CeedVectorDestroy(&W);
+    CeedVectorDestroy(&V);
+    CeedVectorDestroy(&Vsplit);
+  }
+
+  // Cleanup
+  CeedQFunctionDestroy(&qf);
+  CeedDestroy(&ceed);
+  return 0;
+}
@@ -0,0 +1,31 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+CEED_QFUNCTION(apply)(void *ctx, const CeedInt Q, const CeedScalar *const *in,
+                      CeedScalar *const *out) {
+  // in[0], in[1] are u and its gradient, shapes [nc=1, Q] and [2, nc=1, Q]
+  // in[2], in[3] are w and its gradient, shapes [nc=1, Q] and [2, nc=1, Q]
+  const CeedScalar *u = in[0], *du = in[1], *w = in[2], *dw = in[3];
+
+  // out[0] is output to multiply against v, shape [nc=1, Q]
+  CeedScalar *v = out[0];
+
+  // Quadrature point loop
+  for (CeedInt i=0; i<Q; i++)
+    v[i] = u[i] + du[i+Q*0] + 2*du[i+Q*1] + w[i]*(dw[i+Q*0] - dw[i+Q*1]);
+
+  return 0;
+}
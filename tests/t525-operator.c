@@ -0,0 +1,172 @@
+/// @file
+/// Test concurrent application of composite mass matrix operator
+/// \test Test concurrent application of composite mass matrix operator
+#define _POSIX_C_SOURCE 200112L
+#include <ceed.h>
+#include <stdlib.h>
+#include <math.h>
+#include "t510-operator.h"
+
+/* The mesh comprises of four rows of 3 quadralaterals, each row with its own
+     suboperator and its own basis.  The last two rows share their mass
+     QFunction, so they are applied by the same task.
+*/
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  CeedElemRestriction Erestrictx[4], Erestrictu[4], Erestrictui[4];
+  CeedBasis bx, bu[4];
+  CeedQFunction qf_setup, qf_mass[3];
+  CeedOperator op_setupRow[4], op_massRow[4], op_setup, op_mass;
+  CeedVector qdata[4], X, U, V, Vserial;
+  const CeedScalar *hv, *hvserial;
+  CeedInt nrow = 4, nx = 3, P = 3, Q = 4, dim = 2;
+  CeedInt nelemRow = nx, nqptsRow = nx*Q*Q;
+  CeedInt ndofs = (nx*2+1)*(nrow*2+1);
+  CeedInt indx[nrow][nelemRow*P*P];
+  CeedScalar x[dim*ndofs], u[ndofs];
+
+  // Apply suboperators concurrently on three threads
+  setenv("CEED_COMPOSITE_THREADS", "3", 1);
+  CeedInit(argv[1], &ceed);
+
+  // DoF Coordinates
+  for (CeedInt i=0; i<nx*2+1; i++)
+    for (CeedInt j=0; j<nrow*2+1; j++) {
+      x[i+j*(nx*2+1)+0*ndofs] = (CeedScalar) i / (2*nx);
+      x[i+j*(nx*2+1)+1*ndofs] = (CeedScalar) j / (2*nrow);
+    }
+  CeedVectorCreate(ceed, dim*ndofs, &X);
+  CeedVectorSetArray(X, CEED_MEM_HOST, CEED_USE_POINTER, x);
+
+  // Coordinate basis
+  CeedBasisCreateTensorH1Lagrange(ceed, dim, dim, P, Q, CEED_GAUSS, &bx);
+
+  // QFunctions
+  CeedQFunctionCreateInterior(ceed, 1, setup, setup_loc, &qf_setup);
+  CeedQFunctionAddInput(qf_setup, "_weight", 1, CEED_EVAL_WEIGHT);
+  CeedQFunctionAddInput(qf_setup, "dx", dim*dim, CEED_EVAL_GRAD);
+  CeedQFunctionAddOutput(qf_setup, "rho", 1, CEED_EVAL_NONE);
+
+  for (CeedInt i=0; i<3; i++) {
+    CeedQFunctionCreateInterior(ceed, 1, mass, mass_loc, &qf_mass[i]);
+    CeedQFunctionAddInput(qf_mass[i], "rho", 1, CEED_EVAL_NONE);
+    CeedQFunctionAddInput(qf_mass[i], "u", 1, CEED_EVAL_INTERP);
+    CeedQFunctionAddOutput(qf_mass[i], "v", 1, CEED_EVAL_INTERP);
+  }
+
+  // Composite Operators
+  CeedCompositeOperatorCreate(ceed, &op_setup);
+  CeedCompositeOperatorCreate(ceed, &op_mass);
+
+  // Rows
+  for (CeedInt r=0; r<nrow; r++) {
+    // -- Restrictions
+    for (CeedInt e=0; e<nelemRow; e++) {
+      CeedInt offset = r*2*(nx*2+1) + e*2;
+      for (CeedInt j=0; j<P; j++)
+        for (CeedInt k=0; k<P; k++)
+          indx[r][P*(P*e+k)+j] = offset + k*(nx*2+1) + j;
+    }
+    CeedElemRestrictionCreate(ceed, nelemRow, P*P, dim, ndofs, dim*ndofs,
+                              CEED_MEM_HOST, CEED_USE_POINTER, indx[r],
+                              &Erestrictx[r]);
+    CeedElemRestrictionCreate(ceed, nelemRow, P*P, 1, 1, ndofs,
+                              CEED_MEM_HOST, CEED_USE_POINTER, indx[r],
+                              &Erestrictu[r]);
+    CeedInt stridesu[3] = {1, Q*Q, Q*Q};
+    CeedElemRestrictionCreateStrided(ceed, nelemRow, Q*Q, 1, nqptsRow,
+                                     stridesu, &Erestrictui[r]);
+    CeedVectorCreate(ceed, nqptsRow, &qdata[r]);
+
+    // -- Basis
+    CeedBasisCreateTensorH1Lagrange(ceed, dim, 1, P, Q, CEED_GAUSS, &bu[r]);
+
+    // -- Operators
+    CeedOperatorCreate(ceed, qf_setup, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                       &op_setupRow[r]);
+    CeedOperatorSetField(op_setupRow[r], "_weight", CEED_ELEMRESTRICTION_NONE,
+                         bx, CEED_VECTOR_NONE);
+    CeedOperatorSetField(op_setupRow[r], "dx", Erestrictx[r], bx,
+                         CEED_VECTOR_ACTIVE);
+    CeedOperatorSetField(op_setupRow[r], "rho", Erestrictui[r],
+                         CEED_BASIS_COLLOCATED, qdata[r]);
+    CeedCompositeOperatorAddSub(op_setup, op_setupRow[r]);
+
+    CeedOperatorCreate(ceed, qf_mass[CeedIntMin(r, 2)], CEED_QFUNCTION_NONE,
+                       CEED_QFUNCTION_NONE, &op_massRow[r]);
+    CeedOperatorSetField(op_massRow[r], "rho", Erestrictui[r],
+                         CEED_BASIS_COLLOCATED, qdata[r]);
+    CeedOperatorSetField(op_massRow[r], "u", Erestrictu[r], bu[r],
+                         CEED_VECTOR_ACTIVE);
+    CeedOperatorSetField(op_massRow[r], "v", Erestrictu[r], bu[r],
+                         CEED_VECTOR_ACTIVE);
+    CeedCompositeOperatorAddSub(op_mass, op_massRow[r]);
+  }
+
+  // Apply Setup Operator
+  CeedOperatorApply(op_setup, X, CEED_VECTOR_NONE, CEED_REQUEST_IMMEDIATE);
+
+  // Apply Mass Operator, first in order and then concurrently
+  for (CeedInt i=0; i<ndofs; i++)
+    u[i] = 1.0 + sin(i);
+  CeedVectorCreate(ceed, ndofs, &U);
+  CeedVectorSetArray(U, CEED_MEM_HOST, CEED_USE_POINTER, u);
+  CeedVectorCreate(ceed, ndofs, &Vserial);
+  CeedVectorCreate(ceed, ndofs, &V);
+
+  CeedOperatorApply(op_mass, U, Vserial, CEED_REQUEST_IMMEDIATE);
+  for (CeedInt k=0; k<3; k++) {
+    CeedOperatorApply(op_mass, U, V, CEED_REQUEST_IMMEDIATE);
+
+    // Check output
+    CeedVectorGetArrayRead(V, CEED_MEM_HOST, &hv);
+    CeedVectorGetArrayRead(Vserial, CEED_MEM_HOST, &hvserial);
+    for (CeedInt i=0; i<ndofs; i++)
+      if (fabs(hv[i] - hvserial[i]) > 100.*CEED_EPSILON)
+        // LCOV_EXCL_START
+        printf("[%d] v %g != %g\n", i, hv[i], hvserial[i]);
+    // LCOV_EXCL_STOP
+    CeedVectorRestoreArrayRead(V, &hv);
+    CeedVectorRestoreArrayRead(Vserial, &hvserial);
+  }
+
+  // Apply with Unit Input and Add to Output
+  CeedVectorSetValue(U, 1.0);
+  CeedOperatorApply(op_mass, U, V, CEED_REQUEST_IMMEDIATE);
+  CeedOperatorApplyAdd(op_mass, U, V, CEED_REQUEST_IMMEDIATE);
+
+  // Check output
+  CeedScalar area = 0.;
+  CeedVectorGetArrayRead(V, CEED_MEM_HOST, &hv);
+  for (CeedInt i=0; i<ndofs; i++)
+    area += hv[i];
+  CeedVectorRestoreArrayRead(V, &hv);
+  if (fabs(area - 2.0) > 1000.*CEED_EPSILON)
+    // LCOV_EXCL_START
+    printf("Area computed twice %g != 2.0\n", area);
+  // LCOV_EXCL_STOP
+
+  // Cleanup
+  for (CeedInt r=0; r<nrow; r++) {
+    CeedOperatorDestroy(&op_setupRow[r]);
+    CeedOperatorDestroy(&op_massRow[r]);
+    CeedElemRestrictionDestroy(&Erestrictx[r]);
+    CeedElemRestrictionDestroy(&Erestrictu[r]);
+    CeedElemRestrictionDestroy(&Erestrictui[r]);
+    CeedVectorDestroy(&qdata[r]);
+    CeedBasisDestroy(&bu[r]);
+  }
+  for (CeedInt i=0; i<3; i++)
+    CeedQFunctionDestroy(&qf_mass[i]);
+  CeedQFunctionDestroy(&qf_setup);
+  CeedOperatorDestroy(&op_setup);
+  CeedOperatorDestroy(&op_mass);
+  CeedBasisDestroy(&bx);
+  CeedVectorDestroy(&X);
+  CeedVectorDestroy(&U);
+  CeedVectorDestroy(&V);
+  CeedVectorDestroy(&Vserial);
+  CeedDestroy(&ceed);
+  return 0;
+}
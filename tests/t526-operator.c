@@ -0,0 +1,173 @@
+/// @file
+/// Test reuse of cached operator kernels with CEED_GEN_CACHE_DIR
+/// \test Test reuse of cached operator kernels with CEED_GEN_CACHE_DIR
+#define _POSIX_C_SOURCE 200809L
+#include <ceed.h>
+#include <dirent.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "t500-operator.h"
+
+#define MAX_KERNELS 8
+
+// Apply the mass operator of t500 to a non-zero vector
+static void MassApply(const char *resource, CeedInt Nu, CeedScalar *v) {
+  Ceed ceed;
+  CeedElemRestriction Erestrictx, Erestrictu, Erestrictui;
+  CeedBasis bx, bu;
+  CeedQFunction qf_setup, qf_mass;
+  CeedOperator op_setup, op_mass;
+  CeedVector qdata, X, U, V;
+  const CeedScalar *hv;
+  CeedInt nelem = 15, P = 5, Q = 8;
+  CeedInt Nx = nelem+1;
+  CeedInt indx[nelem*2], indu[nelem*P];
+  CeedScalar x[Nx];
+
+  CeedInit(resource, &ceed);
+  for (CeedInt i=0; i<Nx; i++)
+    x[i] = (CeedScalar) i / (Nx - 1);
+  for (CeedInt i=0; i<nelem; i++) {
+    indx[2*i+0] = i;
+    indx[2*i+1] = i+1;
+  }
+  CeedElemRestrictionCreate(ceed, nelem, 2, 1, 1, Nx, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indx, &Erestrictx);
+  for (CeedInt i=0; i<nelem; i++)
+    for (CeedInt j=0; j<P; j++)
+      indu[P*i+j] = i*(P-1) + j;
+  CeedElemRestrictionCreate(ceed, nelem, P, 1, 1, Nu, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indu, &Erestrictu);
+  CeedInt stridesu[3] = {1, Q, Q};
+  CeedElemRestrictionCreateStrided(ceed, nelem, Q, 1, Q*nelem, stridesu,
+                                   &Erestrictui);
+
+  CeedBasisCreateTensorH1Lagrange(ceed, 1, 1, 2, Q, CEED_GAUSS, &bx);
+  CeedBasisCreateTensorH1Lagrange(ceed, 1, 1, P, Q, CEED_GAUSS, &bu);
+
+  CeedQFunctionCreateInterior(ceed, 1, setup, setup_loc, &qf_setup);
+  CeedQFunctionAddInput(qf_setup, "_weight", 1, CEED_EVAL_WEIGHT);
+  CeedQFunctionAddInput(qf_setup, "dx", 1, CEED_EVAL_GRAD);
+  CeedQFunctionAddOutput(qf_setup, "rho", 1, CEED_EVAL_NONE);
+
+  CeedQFunctionCreateInterior(ceed, 1, mass, mass_loc, &qf_mass);
+  CeedQFunctionAddInput(qf_mass, "rho", 1, CEED_EVAL_NONE);
+  CeedQFunctionAddInput(qf_mass, "u", 1, CEED_EVAL_INTERP);
+  CeedQFunctionAddOutput(qf_mass, "v", 1, CEED_EVAL_INTERP);
+
+  CeedOperatorCreate(ceed, qf_setup, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_setup);
+  CeedOperatorCreate(ceed, qf_mass, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_mass);
+
+  CeedVectorCreate(ceed, Nx, &X);
+  CeedVectorSetArray(X, CEED_MEM_HOST, CEED_USE_POINTER, x);
+  CeedVectorCreate(ceed, nelem*Q, &qdata);
+
+  CeedOperatorSetField(op_setup, "_weight", CEED_ELEMRESTRICTION_NONE, bx,
+                       CEED_VECTOR_NONE);
+  CeedOperatorSetField(op_setup, "dx", Erestrictx, bx, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_setup, "rho", Erestrictui, CEED_BASIS_COLLOCATED,
+                       CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_mass, "rho", Erestrictui, CEED_BASIS_COLLOCATED,
+                       qdata);
+  CeedOperatorSetField(op_mass, "u", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_mass, "v", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+
+  CeedOperatorApply(op_setup, X, qdata, CEED_REQUEST_IMMEDIATE);
+
+  CeedVectorCreate(ceed, Nu, &U);
+  CeedVectorCreate(ceed, Nu, &V);
+  CeedScalar *hu;
+  CeedVectorGetArray(U, CEED_MEM_HOST, &hu);
+  for (CeedInt i=0; i<Nu; i++)
+    hu[i] = 1.0 + sin(i);
+  CeedVectorRestoreArray(U, &hu);
+  CeedOperatorApply(op_mass, U, V, CEED_REQUEST_IMMEDIATE);
+
+  CeedVectorGetArrayRead(V, CEED_MEM_HOST, &hv);
+  for (CeedInt i=0; i<Nu; i++)
+    v[i] = hv[i];
+  CeedVectorRestoreArrayRead(V, &hv);
+
+  CeedQFunctionDestroy(&qf_setup);
+  CeedQFunctionDestroy(&qf_mass);
+  CeedOperatorDestroy(&op_setup);
+  CeedOperatorDestroy(&op_mass);
+  CeedElemRestrictionDestroy(&Erestrictu);
+  CeedElemRestrictionDestroy(&Erestrictx);
+  CeedElemRestrictionDestroy(&Erestrictui);
+  CeedBasisDestroy(&bu);
+  CeedBasisDestroy(&bx);
+  CeedVectorDestroy(&X);
+  CeedVectorDestroy(&U);
+  CeedVectorDestroy(&V);
+  CeedVectorDestroy(&qdata);
+  CeedDestroy(&ceed);
+}
+
+// Record the inodes of the kernels in the cache, optionally removing them
+static CeedInt CacheList(const char *dir, ino_t *inodes, int remove) {
+  CeedInt n = 0;
+  DIR *d = opendir(dir);
+  struct dirent *entry;
+  char path[4096];
+  struct stat st;
+  while (d && (entry = readdir(d))) {
+    const char *ext = strrchr(entry->d_name, '.');
+    snprintf(path, sizeof path, "%s/%s", dir, entry->d_name);
+    if (ext && !strcmp(ext, ".so") && n < MAX_KERNELS && !stat(path, &st))
+      inodes[n++] = st.st_ino;
+    if (remove && strcmp(entry->d_name, ".") && strcmp(entry->d_name, ".."))
+      unlink(path);
+  }
+  if (d) closedir(d);
+  return n;
+}
+
+int main(int argc, char **argv) {
+  const CeedInt Nu = 15*4+1;
+  CeedScalar v1[Nu], v2[Nu];
+  ino_t inodes1[MAX_KERNELS], inodes2[MAX_KERNELS];
+  const int gen = !!strstr(argv[1], "/cpu/self/gen");
+  char dir[] = "/tmp/ceed-t526-XXXXXX";
+
+  if (!mkdtemp(dir))
+    // LCOV_EXCL_START
+    printf("Unable to create %s\n", dir);
+  // LCOV_EXCL_STOP
+  setenv("CEED_GEN_CACHE_DIR", dir, 1);
+
+  // The first run compiles the kernels into the cache, the second loads them
+  MassApply(argv[1], Nu, v1);
+  CeedInt n1 = CacheList(dir, inodes1, 0);
+  MassApply(argv[1], Nu, v2);
+  CeedInt n2 = CacheList(dir, inodes2, 1);
+  rmdir(dir);
+  unsetenv("CEED_GEN_CACHE_DIR");
+
+  // A kernel compiled again would replace the cached file with a new inode
+  CeedInt reused = n1 > 0 && n2 == n1;
+  for (CeedInt i=0; i<n1; i++) {
+    CeedInt found = 0;
+    for (CeedInt j=0; j<n2; j++)
+      found = found || inodes1[i] == inodes2[j];
+    reused = reused && found;
+  }
+  if (gen && !reused)
+    // LCOV_EXCL_START
+    printf("Kernels were not reused from the cache: %d then %d\n", n1, n2);
+  // LCOV_EXCL_STOP
+
+  for (CeedInt i=0; i<Nu; i++)
+    if (fabs(v1[i] - v2[i]) > 100.*CEED_EPSILON*fabs(v1[i]))
+      // LCOV_EXCL_START
+      printf("[%d] v %g != %g\n", i, v2[i], v1[i]);
+  // LCOV_EXCL_STOP
+  return 0;
+}
@@ -0,0 +1,173 @@
+/// @file
+/// Test concurrent application of composite operator with shared restrictions and bases
+/// \test Test concurrent application of composite operator with shared restrictions and bases
+#define _POSIX_C_SOURCE 200112L
+#include <ceed.h>
+#include <stdlib.h>
+#include <math.h>
+#include "t510-operator.h"
+
+/* The mesh comprises of four rows of 3 quadralaterals.  The five mass
+     suboperators each have their own QFunction and qdata; the first two share
+     a basis and the last two share the element restrictions of the last row,
+     so they must be applied by the same task.
+*/
+
+#define NROW 4
+#define NSUB 5
+#define NAPPLY 3
+
+// Apply the composite mass operator NAPPLY times, the first time right after
+//   creation, and store each result
+static void MassApply(const char *resource, CeedInt ndofs,
+                      CeedScalar v[NAPPLY][ndofs]) {
+  Ceed ceed;
+  CeedElemRestriction Erestrictx[NROW], Erestrictu[NROW], Erestrictui[NROW];
+  CeedBasis bx, bu[NSUB-1];
+  CeedQFunction qf_setup, qf_mass[NSUB];
+  CeedOperator op_setupSub[NSUB], op_massSub[NSUB], op_setup, op_mass;
+  CeedVector qdata[NSUB], X, U, V;
+  const CeedScalar *hv;
+  const CeedInt row[NSUB] = {0, 1, 2, 3, 3}, basis[NSUB] = {0, 0, 1, 2, 3};
+  CeedInt nx = 3, P = 3, Q = 4, dim = 2;
+  CeedInt nelemRow = nx, nqptsRow = nx*Q*Q;
+  CeedInt indx[NROW][nelemRow*P*P];
+  CeedScalar x[dim*ndofs], u[ndofs];
+
+  CeedInit(resource, &ceed);
+
+  // DoF Coordinates
+  for (CeedInt i=0; i<nx*2+1; i++)
+    for (CeedInt j=0; j<NROW*2+1; j++) {
+      x[i+j*(nx*2+1)+0*ndofs] = (CeedScalar) i / (2*nx);
+      x[i+j*(nx*2+1)+1*ndofs] = (CeedScalar) j / (2*NROW);
+    }
+  CeedVectorCreate(ceed, dim*ndofs, &X);
+  CeedVectorSetArray(X, CEED_MEM_HOST, CEED_USE_POINTER, x);
+
+  // Bases
+  CeedBasisCreateTensorH1Lagrange(ceed, dim, dim, P, Q, CEED_GAUSS, &bx);
+  for (CeedInt b=0; b<NSUB-1; b++)
+    CeedBasisCreateTensorH1Lagrange(ceed, dim, 1, P, Q, CEED_GAUSS, &bu[b]);
+
+  // Restrictions
+  for (CeedInt r=0; r<NROW; r++) {
+    for (CeedInt e=0; e<nelemRow; e++) {
+      CeedInt offset = r*2*(nx*2+1) + e*2;
+      for (CeedInt j=0; j<P; j++)
+        for (CeedInt k=0; k<P; k++)
+          indx[r][P*(P*e+k)+j] = offset + k*(nx*2+1) + j;
+    }
+    CeedElemRestrictionCreate(ceed, nelemRow, P*P, dim, ndofs, dim*ndofs,
+                              CEED_MEM_HOST, CEED_USE_POINTER, indx[r],
+                              &Erestrictx[r]);
+    CeedElemRestrictionCreate(ceed, nelemRow, P*P, 1, 1, ndofs,
+                              CEED_MEM_HOST, CEED_USE_POINTER, indx[r],
+                              &Erestrictu[r]);
+    CeedInt stridesu[3] = {1, Q*Q, Q*Q};
+    CeedElemRestrictionCreateStrided(ceed, nelemRow, Q*Q, 1, nqptsRow,
+                                     stridesu, &Erestrictui[r]);
+  }
+
+  // QFunctions
+  CeedQFunctionCreateInterior(ceed, 1, setup, setup_loc, &qf_setup);
+  CeedQFunctionAddInput(qf_setup, "_weight", 1, CEED_EVAL_WEIGHT);
+  CeedQFunctionAddInput(qf_setup, "dx", dim*dim, CEED_EVAL_GRAD);
+  CeedQFunctionAddOutput(qf_setup, "rho", 1, CEED_EVAL_NONE);
+
+  for (CeedInt s=0; s<NSUB; s++) {
+    CeedQFunctionCreateInterior(ceed, 1, mass, mass_loc, &qf_mass[s]);
+    CeedQFunctionAddInput(qf_mass[s], "rho", 1, CEED_EVAL_NONE);
+    CeedQFunctionAddInput(qf_mass[s], "u", 1, CEED_EVAL_INTERP);
+    CeedQFunctionAddOutput(qf_mass[s], "v", 1, CEED_EVAL_INTERP);
+  }
+
+  // Composite Operators
+  CeedCompositeOperatorCreate(ceed, &op_setup);
+  CeedCompositeOperatorCreate(ceed, &op_mass);
+  for (CeedInt s=0; s<NSUB; s++) {
+    CeedInt r = row[s];
+    CeedVectorCreate(ceed, nqptsRow, &qdata[s]);
+
+    CeedOperatorCreate(ceed, qf_setup, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                       &op_setupSub[s]);
+    CeedOperatorSetField(op_setupSub[s], "_weight", CEED_ELEMRESTRICTION_NONE,
+                         bx, CEED_VECTOR_NONE);
+    CeedOperatorSetField(op_setupSub[s], "dx", Erestrictx[r], bx,
+                         CEED_VECTOR_ACTIVE);
+    CeedOperatorSetField(op_setupSub[s], "rho", Erestrictui[r],
+                         CEED_BASIS_COLLOCATED, qdata[s]);
+    CeedCompositeOperatorAddSub(op_setup, op_setupSub[s]);
+
+    CeedOperatorCreate(ceed, qf_mass[s], CEED_QFUNCTION_NONE,
+                       CEED_QFUNCTION_NONE, &op_massSub[s]);
+    CeedOperatorSetField(op_massSub[s], "rho", Erestrictui[r],
+                         CEED_BASIS_COLLOCATED, qdata[s]);
+    CeedOperatorSetField(op_massSub[s], "u", Erestrictu[r], bu[basis[s]],
+                         CEED_VECTOR_ACTIVE);
+    CeedOperatorSetField(op_massSub[s], "v", Erestrictu[r], bu[basis[s]],
+                         CEED_VECTOR_ACTIVE);
+    CeedCompositeOperatorAddSub(op_mass, op_massSub[s]);
+  }
+
+  // Apply Setup Operator
+  CeedOperatorApply(op_setup, X, CEED_VECTOR_NONE, CEED_REQUEST_IMMEDIATE);
+
+  // Apply Mass Operator
+  for (CeedInt i=0; i<ndofs; i++)
+    u[i] = 1.0 + sin(i);
+  CeedVectorCreate(ceed, ndofs, &U);
+  CeedVectorSetArray(U, CEED_MEM_HOST, CEED_USE_POINTER, u);
+  CeedVectorCreate(ceed, ndofs, &V);
+  for (CeedInt k=0; k<NAPPLY; k++) {
+    CeedOperatorApply(op_mass, U, V, CEED_REQUEST_IMMEDIATE);
+    CeedVectorGetArrayRead(V, CEED_MEM_HOST, &hv);
+    for (CeedInt i=0; i<ndofs; i++)
+      v[k][i] = hv[i];
+    CeedVectorRestoreArrayRead(V, &hv);
+  }
+
+  // Cleanup
+  for (CeedInt s=0; s<NSUB; s++) {
+    CeedOperatorDestroy(&op_setupSub[s]);
+    CeedOperatorDestroy(&op_massSub[s]);
+    CeedQFunctionDestroy(&qf_mass[s]);
+    CeedVectorDestroy(&qdata[s]);
+  }
+  for (CeedInt r=0; r<NROW; r++) {
+    CeedElemRestrictionDestroy(&Erestrictx[r]);
+    CeedElemRestrictionDestroy(&Erestrictu[r]);
+    CeedElemRestrictionDestroy(&Erestrictui[r]);
+  }
+  for (CeedInt b=0; b<NSUB-1; b++)
+    CeedBasisDestroy(&bu[b]);
+  CeedQFunctionDestroy(&qf_setup);
+  CeedOperatorDestroy(&op_setup);
+  CeedOperatorDestroy(&op_mass);
+  CeedBasisDestroy(&bx);
+  CeedVectorDestroy(&X);
+  CeedVectorDestroy(&U);
+  CeedVectorDestroy(&V);
+  CeedDestroy(&ceed);
+}
+
+int main(int argc, char **argv) {
+  const CeedInt ndofs = (3*2+1)*(NROW*2+1);
+  CeedScalar vserial[NAPPLY][ndofs], vthreads[NAPPLY][ndofs];
+
+  // Apply in order, then on three threads from the first application
+  MassApply(argv[1], ndofs, vserial);
+  setenv("CEED_COMPOSITE_THREADS", "3", 1);
+  MassApply(argv[1], ndofs, vthreads);
+  unsetenv("CEED_COMPOSITE_THREADS");
+
+  // Check output
+  for (CeedInt k=0; k<NAPPLY; k++)
+    for (CeedInt i=0; i<ndofs; i++)
+      if (fabs(vthreads[k][i] - vserial[0][i]) > 100.*CEED_EPSILON)
+        // LCOV_EXCL_START
+        printf("Apply %d [%d] v %g != %g\n", k, i, vthreads[k][i],
+               vserial[0][i]);
+  // LCOV_EXCL_STOP
+  return 0;
+}
@@ -107,7 +107,7 @@ int main(int argc, char **argv) {
   const CeedScalar *vv;
   CeedVectorGetArrayRead(v, CEED_MEM_HOST, &vv);
   for (CeedInt i=0; i<ndofs; i++)
-    if (fabs(vv[i]) > 1e-14)
+    if (fabs(vv[i]) > 100.*CEED_EPSILON)
       // LCOV_EXCL_START
       printf("Error: Operator computed v[i] = %f != 0.0\n", vv[i]);
   // LCOV_EXCL_STOP
@@ -138,7 +138,7 @@ int main(int argc, char **argv) {
   // Check output
   CeedVectorGetArrayRead(v, CEED_MEM_HOST, &vv);
   for (CeedInt i=0; i<ndofs; i++)
-    if (fabs(vv[i]) > 1e-14)
+    if (fabs(vv[i]) > 100.*CEED_EPSILON)
       // LCOV_EXCL_START
       printf("Error: Linerized operator computed v[i] = %f != 0.0\n", vv[i]);
   // LCOV_EXCL_STOP
@@ -0,0 +1,159 @@
+/// @file
+/// Test assembly of operator diagonals against full COO assembly
+/// \test Test assembly of operator diagonals against full COO assembly
+#include <ceed.h>
+#include <math.h>
+#include "t537-operator.h"
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  CeedElemRestriction Erestrictx, Erestrictu,
+                      Erestrictui;
+  CeedBasis bx, bu;
+  CeedQFunction qf_setup, qf_mass;
+  CeedOperator op_setup, op_mass;
+  CeedVector qdata, X, A, D, PBD;
+  CeedInt nentries, *rows, *cols;
+  // More elements than one block of the blocked backends, with a partial block
+  CeedInt nelem = 9, P = 3, Q = 4, dim = 2, ncomp = 2;
+  CeedInt nx = 3, ny = 3;
+  CeedInt ndofs = (nx*2+1)*(ny*2+1), nqpts = nelem*Q*Q;
+  CeedInt indx[nelem*P*P];
+  CeedScalar x[dim*ndofs], diagTrue[ncomp*ndofs],
+             pbdiagTrue[ncomp*ncomp*ndofs];
+  const CeedScalar *a, *d;
+
+  CeedInit(argv[1], &ceed);
+
+  // DoF Coordinates
+  for (CeedInt i=0; i<nx*2+1; i++)
+    for (CeedInt j=0; j<ny*2+1; j++) {
+      x[i+j*(nx*2+1)+0*ndofs] = (CeedScalar) i / (2*nx);
+      x[i+j*(nx*2+1)+1*ndofs] = (CeedScalar) j / (2*ny);
+    }
+  CeedVectorCreate(ceed, dim*ndofs, &X);
+  CeedVectorSetArray(X, CEED_MEM_HOST, CEED_USE_POINTER, x);
+
+  // Qdata Vector
+  CeedVectorCreate(ceed, nqpts, &qdata);
+
+  // Element Setup
+  for (CeedInt i=0; i<nelem; i++) {
+    CeedInt col, row, offset;
+    col = i % nx;
+    row = i / nx;
+    offset = col*(P-1) + row*(nx*2+1)*(P-1);
+    for (CeedInt j=0; j<P; j++)
+      for (CeedInt k=0; k<P; k++)
+        indx[P*(P*i+k)+j] = offset + k*(nx*2+1) + j;
+  }
+
+  // Restrictions
+  CeedElemRestrictionCreate(ceed, nelem, P*P, dim, ndofs, dim*ndofs,
+                            CEED_MEM_HOST, CEED_USE_POINTER, indx, &Erestrictx);
+  CeedElemRestrictionCreate(ceed, nelem, P*P, ncomp, ndofs, ncomp*ndofs,
+                            CEED_MEM_HOST, CEED_USE_POINTER, indx, &Erestrictu);
+  CeedInt stridesu[3] = {1, Q*Q, Q*Q};
+  CeedElemRestrictionCreateStrided(ceed, nelem, Q*Q, 1, nqpts, stridesu,
+                                   &Erestrictui);
+
+  // Bases
+  CeedBasisCreateTensorH1Lagrange(ceed, dim, dim, P, Q, CEED_GAUSS, &bx);
+  CeedBasisCreateTensorH1Lagrange(ceed, dim, ncomp, P, Q, CEED_GAUSS, &bu);
+
+  // QFunctions
+  CeedQFunctionCreateInterior(ceed, 1, setup, setup_loc, &qf_setup);
+  CeedQFunctionAddInput(qf_setup, "_weight", 1, CEED_EVAL_WEIGHT);
+  CeedQFunctionAddInput(qf_setup, "dx", dim*dim, CEED_EVAL_GRAD);
+  CeedQFunctionAddOutput(qf_setup, "rho", 1, CEED_EVAL_NONE);
+
+  CeedQFunctionCreateInterior(ceed, 1, mass, mass_loc, &qf_mass);
+  CeedQFunctionAddInput(qf_mass, "rho", 1, CEED_EVAL_NONE);
+  CeedQFunctionAddInput(qf_mass, "u", ncomp, CEED_EVAL_INTERP);
+  CeedQFunctionAddOutput(qf_mass, "v", ncomp, CEED_EVAL_INTERP);
+
+  // Operators
+  CeedOperatorCreate(ceed, qf_setup, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_setup);
+  CeedOperatorSetField(op_setup, "_weight", CEED_ELEMRESTRICTION_NONE, bx,
+                       CEED_VECTOR_NONE);
+  CeedOperatorSetField(op_setup, "dx", Erestrictx, bx, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_setup, "rho", Erestrictui, CEED_BASIS_COLLOCATED,
+                       CEED_VECTOR_ACTIVE);
+
+  CeedOperatorCreate(ceed, qf_mass, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_mass);
+  CeedOperatorSetField(op_mass, "rho", Erestrictui, CEED_BASIS_COLLOCATED,
+                       qdata);
+  CeedOperatorSetField(op_mass, "u", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_mass, "v", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+
+  // Apply Setup Operator
+  CeedOperatorApply(op_setup, X, qdata, CEED_REQUEST_IMMEDIATE);
+
+  // Assemble diagonals
+  CeedVectorCreate(ceed, ncomp*ndofs, &D);
+  CeedOperatorLinearAssembleDiagonal(op_mass, D, CEED_REQUEST_IMMEDIATE);
+  CeedVectorCreate(ceed, ncomp*ncomp*ndofs, &PBD);
+  CeedOperatorLinearAssemblePointBlockDiagonal(op_mass, PBD,
+      CEED_REQUEST_IMMEDIATE);
+
+  // Full COO assembly
+  CeedOperatorLinearAssembleSymbolic(op_mass, &nentries, &rows, &cols);
+  CeedVectorCreate(ceed, nentries, &A);
+  CeedOperatorLinearAssemble(op_mass, A);
+
+  // Sum COO entries of the diagonal and of the point blocks
+  //   The L-vector index of DoF i, component j is i + j*ndofs
+  for (int i=0; i<ncomp*ndofs; i++)
+    diagTrue[i] = 0.0;
+  for (int i=0; i<ncomp*ncomp*ndofs; i++)
+    pbdiagTrue[i] = 0.0;
+  CeedVectorGetArrayRead(A, CEED_MEM_HOST, &a);
+  for (int k=0; k<nentries; k++) {
+    CeedInt noderow = rows[k] % ndofs, compout = rows[k] / ndofs;
+    CeedInt nodecol = cols[k] % ndofs, compin = cols[k] / ndofs;
+    if (rows[k] == cols[k])
+      diagTrue[rows[k]] += a[k];
+    if (noderow == nodecol)
+      pbdiagTrue[(noderow*ncomp + compout)*ncomp + compin] += a[k];
+  }
+  CeedVectorRestoreArrayRead(A, &a);
+
+  // Check output
+  CeedVectorGetArrayRead(D, CEED_MEM_HOST, &d);
+  for (int i=0; i<ncomp*ndofs; i++)
+    if (fabs(d[i] - diagTrue[i]) > 100.*CEED_EPSILON)
+      // LCOV_EXCL_START
+      printf("[%d] Error in diagonal: %f != %f\n", i, d[i], diagTrue[i]);
+  // LCOV_EXCL_STOP
+  CeedVectorRestoreArrayRead(D, &d);
+  CeedVectorGetArrayRead(PBD, CEED_MEM_HOST, &d);
+  for (int i=0; i<ncomp*ncomp*ndofs; i++)
+    if (fabs(d[i] - pbdiagTrue[i]) > 100.*CEED_EPSILON)
+      // LCOV_EXCL_START
+      printf("[%d] Error in point block diagonal: %f != %f\n", i, d[i],
+             pbdiagTrue[i]);
+  // LCOV_EXCL_STOP
+  CeedVectorRestoreArrayRead(PBD, &d);
+
+  // Cleanup
+  CeedQFunctionDestroy(&qf_setup);
+  CeedQFunctionDestroy(&qf_mass);
+  CeedOperatorDestroy(&op_setup);
+  CeedOperatorDestroy(&op_mass);
+  CeedElemRestrictionDestroy(&Erestrictu);
+  CeedElemRestrictionDestroy(&Erestrictx);
+  CeedElemRestrictionDestroy(&Erestrictui);
+  CeedBasisDestroy(&bu);
+  CeedBasisDestroy(&bx);
+  CeedVectorDestroy(&X);
+  CeedVectorDestroy(&A);
+  CeedVectorDestroy(&D);
+  CeedVectorDestroy(&PBD);
+  CeedVectorDestroy(&qdata);
+  CeedFree(&rows);
+  CeedFree(&cols);
+  CeedDestroy(&ceed);
+  return 0;
+}
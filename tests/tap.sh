@@ -166,9 +166,14 @@ for ((i=0;i<${#backends[@]};++i)); do
         printf "not ok $i0 $1 $backend\n"
     fi
 
-    # stdout
-    if [ -f tests/output/$1.out ]; then
-        if diff -u tests/output/$1.out ${output}.out > ${output}.diff; then
+    # stdout; single precision builds compare against their own reference
+    # output where printed values differ in the trailing digits
+    refout=tests/output/$1.out
+    if [ "$SCALAR" = float -a -f tests/output/fp32/$1.out ]; then
+        refout=tests/output/fp32/$1.out
+    fi
+    if [ -f $refout ]; then
+        if diff -u $refout ${output}.out > ${output}.diff; then
             printf "ok $i1 $1 $backend stdout\n"
         else
             printf "not ok $i1 $1 $backend stdout\n"